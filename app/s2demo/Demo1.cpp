@@ -11,8 +11,10 @@
 
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <format>
 #include <optional>
+#include <vector>
 
 using namespace S2LL;
 using namespace S2LL::Literals;
@@ -143,46 +145,54 @@ namespace S2Demo
 		}
 	}
 
-	/// Builds a translucent mesh of the planar "segments": for each edge, the
-	/// crescent between the chord and its great-elliptic arc, fanned from the
-	/// first vertex. Vertex colors carry the translucent tint.
+	/// Builds translucent indexed meshes of the planar "segments": for each
+	/// edge, the crescent between the chord and its great-elliptic arc. A
+	/// crescent is convex, so it is fanned from the first arc sample over the
+	/// samples it shares with its triangles. Vertex colors carry the tint.
+	/// Indices are 16-bit, so the edges are split over as many meshes as keep
+	/// each below 65536 vertices.
 	template <typename Polygon>
-	inline Mesh build_segment_mesh(const Polygon& poly, const Ellipsoid& e,
+	inline std::vector<Mesh> build_segment_meshes(const Polygon& poly, const Ellipsoid& e,
 		const LinearTransformation& T, Color tint)
 	{
 		constexpr int arc_segments = 32;
-		const size_t nv = poly.size();
+		constexpr size_t points_per_edge = static_cast<size_t>(arc_segments) + 1;
+		constexpr size_t edges_per_mesh = 65536 / points_per_edge;
 		// Fan from A over the arc samples; the degenerate first triangle is skipped
 		const size_t tris_per_edge = static_cast<size_t>(arc_segments) - 1;
-		const size_t tri_count = nv * tris_per_edge;
-		const int vertex_count = static_cast<int>(3 * tri_count);
-
-		Mesh mesh{};
-		mesh.vertexCount = vertex_count;
-		mesh.triangleCount = static_cast<int>(tri_count);
-		mesh.vertices = static_cast<float*>(MemAlloc(static_cast<size_t>(vertex_count) * 3 * sizeof(float)));
-		mesh.normals = static_cast<float*>(MemAlloc(static_cast<size_t>(vertex_count) * 3 * sizeof(float)));
-		mesh.colors = static_cast<unsigned char*>(MemAlloc(static_cast<size_t>(vertex_count) * 4 * sizeof(unsigned char)));
-
-		size_t v = 0;
-		for (size_t i = 0; i < nv; ++i)
+		const size_t nv = poly.size();
+
+		std::vector<Mesh> meshes;
+		std::array<E3, points_per_edge> pts;
+		for (size_t first = 0; first < nv; first += edges_per_mesh)
 		{
-			const auto arc = poly.edge(static_cast<ptrdiff_t>(i), e, T);
-			const auto pts = arc.sample(arc_segments);
-			const E3 A = pts[0];
-			for (int k = 1; k < arc_segments; ++k)
+			const size_t edges = std::min(edges_per_mesh, nv - first);
+			const size_t tri_count = edges * tris_per_edge;
+			const size_t vertex_count = edges * points_per_edge;
+
+			Mesh mesh{};
+			mesh.vertexCount = static_cast<int>(vertex_count);
+			mesh.triangleCount = static_cast<int>(tri_count);
+			mesh.vertices = static_cast<float*>(MemAlloc(vertex_count * 3 * sizeof(float)));
+			mesh.normals = static_cast<float*>(MemAlloc(vertex_count * 3 * sizeof(float)));
+			mesh.colors = static_cast<unsigned char*>(MemAlloc(vertex_count * 4 * sizeof(unsigned char)));
+			mesh.indices = static_cast<unsigned short*>(MemAlloc(tri_count * 3 * sizeof(unsigned short)));
+
+			size_t t = 0;
+			for (size_t j = 0; j < edges; ++j)
 			{
-				const E3 P = pts[static_cast<size_t>(k)];
-				const E3 Q = pts[static_cast<size_t>(k + 1)];
-				// Geometric normal of the (A, P, Q) fan triangle; the fill is
-				// unlit and two-sided, so orientation is only cosmetic
-				const E3 normal = (P - A).cross(Q - A).normalized();
-				const E3 tri[3] = { A, P, Q };
-				for (int j = 0; j < 3; ++j)
-				{
-					mesh.vertices[3 * v + 0] = static_cast<float>(tri[j].x);
-					mesh.vertices[3 * v + 1] = static_cast<float>(tri[j].y);
-					mesh.vertices[3 * v + 2] = static_cast<float>(tri[j].z);
+				const auto arc = poly.edge(static_cast<ptrdiff_t>(first + j), e, T);
+				arc.sample(pts);
+				// The crescent is planar: one normal serves all its samples. The
+				// fill is unlit and two-sided, so orientation is only cosmetic.
+				const E3 normal = (pts[arc_segments / 2] - pts[0]).cross(pts[arc_segments] - pts[0]).normalized();
+				const size_t base = j * points_per_edge;
+				for (size_t k = 0; k < points_per_edge; ++k)
+				{
+					const size_t v = base + k;
+					mesh.vertices[3 * v + 0] = static_cast<float>(pts[k].x);
+					mesh.vertices[3 * v + 1] = static_cast<float>(pts[k].y);
+					mesh.vertices[3 * v + 2] = static_cast<float>(pts[k].z);
 					mesh.normals[3 * v + 0] = static_cast<float>(normal.x);
 					mesh.normals[3 * v + 1] = static_cast<float>(normal.y);
 					mesh.normals[3 * v + 2] = static_cast<float>(normal.z);
@@ -190,12 +200,18 @@ namespace S2Demo
 					mesh.colors[4 * v + 1] = tint.g;
 					mesh.colors[4 * v + 2] = tint.b;
 					mesh.colors[4 * v + 3] = tint.a;
-					++v;
+				}
+				for (size_t k = 1; k < static_cast<size_t>(arc_segments); ++k)
+				{
+					mesh.indices[t++] = static_cast<unsigned short>(base);
+					mesh.indices[t++] = static_cast<unsigned short>(base + k);
+					mesh.indices[t++] = static_cast<unsigned short>(base + k + 1);
 				}
 			}
+			UploadMesh(&mesh, false);
+			meshes.push_back(mesh);
 		}
-		UploadMesh(&mesh, false);
-		return mesh;
+		return meshes;
 	}
 
 	/// Draws a line as alternating dashes (used for occluded interior chords)
@@ -306,12 +322,12 @@ namespace S2Demo
 		sheared_material.maps[MATERIAL_MAP_DIFFUSE].color = LIGHTGRAY;
 
 		// Translucent "segments": per-edge planar crescents between each chord
-		// and its great-elliptic arc, one mesh per demo case
-		std::array<Mesh, 3> segment_meshes{};
+		// and its great-elliptic arc, one set of meshes per demo case
+		std::array<std::vector<Mesh>, 3> segment_meshes{};
 		const Color segment_tint{ 255, 200, 90, 110 };
 		for (size_t i = 0; i < cases.size(); ++i)
 		{
-			segment_meshes[i] = build_segment_mesh(poly, s, cases[i].transform, segment_tint);
+			segment_meshes[i] = build_segment_meshes(poly, s, cases[i].transform, segment_tint);
 		}
 		Material segment_material = LoadMaterialDefault();
 
@@ -436,7 +452,10 @@ namespace S2Demo
 			{
 				// Two-sided translucent fill: backface culling would hide one side
 				rlDisableBackfaceCulling();
-				DrawMesh(segment_meshes[static_cast<size_t>(show_case)], segment_material, MatrixIdentity());
+				for (const Mesh& m : segment_meshes[static_cast<size_t>(show_case)])
+				{
+					DrawMesh(m, segment_material, MatrixIdentity());
+				}
 				rlEnableBackfaceCulling();
 			}
 
@@ -511,10 +530,11 @@ namespace S2Demo
 				// surface depth (no z-fighting with the solid/transparent view)
 				const E3 cam_pos{ cam.position.x, cam.position.y, cam.position.z };
 				constexpr double surface_clearance = 0.02;
+				std::array<E3, 33> arc_pts;
 				for (size_t i = 0; i < nv; ++i)
 				{
 					const auto arc = poly.edge(i, s, view.transform);
-					auto arc_pts = arc.sample(32);
+					arc.sample(arc_pts);
 					for (size_t k = 0; k + 1 < arc_pts.size(); ++k)
 					{
 						// Move toward the camera (subtract the view direction)
@@ -820,9 +840,12 @@ namespace S2Demo
 		UnloadMaterial(segment_material);
 		UnloadMesh(sphere_mesh);
 		UnloadMesh(sheared_mesh);
-		for (Mesh& m : segment_meshes)
+		for (std::vector<Mesh>& meshes : segment_meshes)
 		{
-			UnloadMesh(m);
+			for (Mesh& m : meshes)
+			{
+				UnloadMesh(m);
+			}
 		}
 		S2App::ShutdownGuiApp();
 
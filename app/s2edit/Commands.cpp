@@ -5,6 +5,7 @@
 #include <format>
 #include <fstream>
 #include <iomanip>
+#include <iterator>
 #include <locale>
 
 namespace S2Edit
@@ -205,6 +206,60 @@ namespace S2Edit
 			"Convert spherical coordinates to 3D Cartesian coordinates"
 		);
 
+		rootMenu.Insert(
+			"validate",
+			[&ctx](std::ostream& ost, const std::vector<std::string>& argv)
+			{
+				if (ctx.cgs.empty())
+				{
+					ost << "Nothing to validate: load and convert first\n";
+					return;
+				}
+
+				// Shapefile rings are closed and run clockwise around their outsides
+				ValidateOptions options;
+				options.winding = ctx.isShapefile ? Winding::Clockwise : Winding::CounterClockwise;
+				options.closed = ctx.isShapefile;
+				const auto found = validate(std::span<const Compound<GP<>>>(ctx.cgs), options, 0);
+
+				static constexpr const char* names[] = {
+					"duplicate vertex", "antipodal edge", "degenerate ring", "self-intersection",
+					"repeated vertex", "ring crossing", "orientation"
+				};
+				size_t counts[std::size(names)] = {};
+				for (const auto& d : found)
+				{
+					++counts[static_cast<size_t>(d.defect)];
+				}
+				ost << "\t" << found.size() << " defect(s) in " << ctx.cgs.size() << " region(s)\n";
+				for (size_t k = 0; k < std::size(names); ++k)
+				{
+					if (counts[k] > 0)
+					{
+						ost << std::format("\t{}: {}\n", names[k], counts[k]);
+					}
+				}
+
+				if (argv.size() == 1 && argv[0] == "detail")
+				{
+					const auto field = [](size_t v) {
+						return v == Diagnostic::npos ? std::string("-") : std::to_string(v);
+					};
+					for (const auto& d : found)
+					{
+						ost << std::format("cGLPoly[{}][{}]: {} at {}", d.region, d.ring,
+							names[static_cast<size_t>(d.defect)], field(d.index));
+						if (d.other_index != Diagnostic::npos)
+						{
+							ost << std::format(" and [{}] {}", field(d.other_ring == Diagnostic::npos ? d.ring : d.other_ring), d.other_index);
+						}
+						ost << "\n";
+					}
+				}
+			},
+			"Check converted regions for self-intersections, duplicate vertices and orientation: \"detail\""
+		);
+
 		rootMenu.Insert(
 			"export",
 			[&ctx](std::ostream& ost, const std::string& fileName)
@@ -3,6 +3,7 @@
 #include <S2LL/Parser/Shapefile.hpp>
 #include <S2LL/Core/Regions.hpp>
 #include <S2LL/Core/Surfaces.hpp>
+#include <S2LL/Core/Validate.hpp>
 
 #include <cli/cli.h>
 
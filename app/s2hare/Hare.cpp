@@ -1,5 +1,7 @@
 #include "Hare.hpp"
 
+#include <S2LL/Core/Rotations.hpp>
+
 #include <algorithm>
 #include <cmath>
 #include <cctype>
@@ -11,6 +13,7 @@
 namespace S2Hare
 {
 	using namespace S2LL::Numerics;
+	using S2LL::Rotation;
 
 	namespace
 	{
@@ -28,18 +31,6 @@ namespace S2Hare
 			h.normalize();
 			return h;
 		}
-
-		/// Linear combination a*w + b*v. Every product and sum completes in
-		/// extended precision; each component is converted to double last.
-		inline E3 weighted_sum(const E3& a, const E3& b, const Double& w, const Double& v)
-		{
-			// TODO: Should E3 support an extended precision type?
-			return E3{
-				static_cast<double>(a.x * w + b.x * v),
-				static_cast<double>(a.y * w + b.y * v),
-				static_cast<double>(a.z * w + b.z * v)
-			};
-		}
 	}
 
 	void CreatureState::forward(Double rad)
@@ -51,14 +42,15 @@ namespace S2Hare
 		const int n = std::clamp(
 			static_cast<int>(static_cast<double>(Ceil(rad.abs() / kArcStep))), 1, 512);
 
-		// Sample the great-circle arc; recompute each sample from the origin
-		// so accumulated round-off cannot bend the path.
+		// Sample the great-circle arc by rotating the starting frame about the
+		// circle's pole; recompute each sample from the origin so accumulated
+		// round-off cannot bend the path.
+		const E3 pole = p0.cross(h0);
 		for (int i = 1; i <= n; ++i)
 		{
-			const Double t = rad * (Double::make(i) / n);
-			const auto [sin_t, cos_t] = SinCos(t);
-			pos = weighted_sum(p0, h0, cos_t, sin_t);
-			heading = weighted_sum(h0, p0, cos_t, sin_t);
+			const Rotation R = Rotation::axis_angle(pole, rad * (Double::make(i) / n));
+			pos = R(p0);
+			heading = R(h0);
 			if (pen_down)
 			{
 				trail.push_back(pos);
@@ -70,10 +62,8 @@ namespace S2Hare
 
 	void CreatureState::turn(Double rad)
 	{
-		const E3 outwards = pos.normalized();
-		const E3 left_side = outwards.cross(heading);
-		const auto [sin_phi, cos_phi] = SinCos(rad);
-		heading = weighted_sum(heading, left_side, cos_phi, sin_phi);
+		// Left-positive turns are right-handed about the outward normal
+		heading = Rotation::axis_angle(pos, rad)(heading);
 		heading = orthogonalize(pos, heading);
 	}
 
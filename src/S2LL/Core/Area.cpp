@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <S2LL/Core/Area.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		constexpr double four_pi = 4.0 * std::numbers::pi;
+
+		/// Geodesic edges longer than this central angle are densified before
+		/// the authalic mapping
+		constexpr double max_step = 1e-3;
+
+		/// Relative and absolute tolerances and depth limit of the adaptive
+		/// quadrature; the absolute floor stops the refinement of triangles
+		/// whose area is all rounding
+		constexpr double quadrature_tolerance = 1e-12;
+		constexpr double quadrature_floor = 1e-20;
+		constexpr int max_depth = 8;
+
+		/// Signed solid angle of the spherical triangle of the unit vectors
+		/// o, a, b (Van Oosterom & Strackee 1983)
+		inline double excess(const E3& o, const E3& a, const E3& b) noexcept
+		{
+			const double det = o.dot(a.cross(b));
+			const double den = 1.0 + o.dot(a) + a.dot(b) + b.dot(o);
+			return 2.0 * std::atan2(det, den);
+		}
+
+		/// Reduces a sum of signed triangle areas, which equals the area to the
+		/// left of the ring up to a multiple of 4 pi, into (-2 pi, 2 pi]
+		inline double reduce(double sum) noexcept
+		{
+			double r = std::fmod(sum, four_pi);
+			if (r > 0.5 * four_pi)
+			{
+				r -= four_pi;
+			}
+			else if (r <= -0.5 * four_pi)
+			{
+				r += four_pi;
+			}
+			return r;
+		}
+
+		std::vector<E3> units(LoopView<E3> ring)
+		{
+			std::vector<E3> u(ring.size());
+			std::transform(ring.begin(), ring.end(), u.begin(), [](const E3& v) { return v.normalized(); });
+			return u;
+		}
+
+		/// Apex of the fan of triangles: the vertex centroid, so that the
+		/// triangles stay local and do not cancel, unless some vertex is
+		/// nearly antipodal to it; then the best of a few generic directions
+		E3 fan_apex(std::span<const E3> u)
+		{
+			const auto margin = [&](const E3& o) {
+				double lowest = 1.0;
+				for (const E3& v : u)
+				{
+					lowest = std::min(lowest, o.dot(v));
+				}
+				return lowest;
+			};
+
+			E3 sum{ 0.0, 0.0, 0.0 };
+			for (const E3& v : u)
+			{
+				sum = sum + v;
+			}
+			if (sum.mag() > 1e-3 * static_cast<double>(u.size()))
+			{
+				const E3 centroid = sum.normalized();
+				if (margin(centroid) > -0.5)
+				{
+					return centroid;
+				}
+			}
+
+			const E3 generic[] = {
+				E3{ 0.28108, -0.53367, 0.79762 }.normalized(),
+				E3{ -0.70121, 0.61519, 0.36036 }.normalized(),
+				E3{ 0.58283, 0.71712, -0.38271 }.normalized(),
+				E3{ -0.45301, -0.40982, -0.79170 }.normalized(),
+			};
+			E3 best = generic[0];
+			double best_margin = -2.0;
+			for (const E3& o : generic)
+			{
+				const double m = margin(o);
+				if (m > best_margin)
+				{
+					best = o;
+					best_margin = m;
+				}
+			}
+			return best;
+		}
+
+		/// Geodetic coordinates of the surface point on the ray of p, mapped
+		/// to the unit vector of the authalic sphere
+		inline E3 authalic(const Ellipsoid& e, const E3& p) noexcept
+		{
+			const double a = e.major(), c = e.minor();
+			const double beta = e.authalic_latitude(std::atan2(a * a * p.z, c * c * std::hypot(p.x, p.y)));
+			const double lon = std::atan2(p.y, p.x);
+			return E3{ std::cos(beta) * std::cos(lon), std::cos(beta) * std::sin(lon), std::sin(beta) };
+		}
+
+		/// Adaptive quadrature of a density over a spherical triangle, signed
+		/// by its orientation. The planar triangle abc is projected centrally
+		/// onto the sphere, with area element det(a, b, c) / |p|^3 at the point
+		/// p of the plane, and integrated by the 7-point degree-5 rule; a
+		/// triangle is split at its edge midpoints until the four parts agree
+		/// with the whole.
+		template <typename F>
+		class SphericalQuadrature
+		{
+			const F& density;
+
+			double rule(const E3& a, const E3& b, const E3& c) const
+			{
+				const double det = a.dot(b.cross(c));
+				if (det == 0.0)
+				{
+					return 0.0;
+				}
+				constexpr double a1 = 0.059715871789770, b1 = 0.470142064105115, w1 = 0.132394152788506;
+				constexpr double a2 = 0.797426985353087, b2 = 0.101286507323456, w2 = 0.125939180544827;
+				constexpr double nodes[7][4] = {
+					{ 1.0 / 3.0, 1.0 / 3.0, 1.0 / 3.0, 0.225 },
+					{ a1, b1, b1, w1 }, { b1, a1, b1, w1 }, { b1, b1, a1, w1 },
+					{ a2, b2, b2, w2 }, { b2, a2, b2, w2 }, { b2, b2, a2, w2 },
+				};
+				double sum = 0.0;
+				for (const auto& q : nodes)
+				{
+					const E3 p = a * q[0] + b * q[1] + c * q[2];
+					const double m = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+					sum += q[3] * density(p * (1.0 / m)) / (m * m * m);
+				}
+				return 0.5 * det * sum;
+			}
+
+		public:
+			explicit SphericalQuadrature(const F& density) : density(density) {}
+
+			double operator()(const E3& a, const E3& b, const E3& c, int depth = 0) const
+			{
+				const E3 ab = (a + b).normalized(), bc = (b + c).normalized(), ca = (c + a).normalized();
+				const double whole = rule(a, b, c);
+				const double parts = rule(a, ab, ca) + rule(ab, b, bc) + rule(ca, bc, c) + rule(ab, bc, ca);
+				// Sides beyond 60 degrees are always split: the central
+				// projection degrades as the plane nears the center
+				const bool wide = std::min({ a.dot(b), b.dot(c), c.dot(a) }) < 0.5;
+				if (depth >= max_depth || (!wide && std::abs(parts - whole) <= quadrature_tolerance * std::abs(parts) + quadrature_floor))
+				{
+					return parts;
+				}
+				return (*this)(a, ab, ca, depth + 1) + (*this)(ab, b, bc, depth + 1)
+					+ (*this)(ca, bc, c, depth + 1) + (*this)(ab, bc, ca, depth + 1);
+			}
+		};
+	}
+
+	double spherical_area(LoopView<E3> ring)
+	{
+		const size_t n = ring.size();
+		if (n < 3)
+		{
+			return 0.0;
+		}
+		const std::vector<E3> u = units(ring);
+		const E3 o = fan_apex(u);
+		Double sum{};
+		for (size_t i = 0; i < n; ++i)
+		{
+			sum = sum + excess(o, u[i], u[(i + 1) % n]);
+		}
+		return reduce(static_cast<double>(sum));
+	}
+
+	double geodesic_area(LoopView<E3> ring, const Ellipsoid& e, const GeodesicSolver* g)
+	{
+		if (e.is_sphere())
+		{
+			return e.major() * e.major() * spherical_area(ring);
+		}
+		if (!e.is_spheroid())
+		{
+			std::feraiseexcept(FE_INVALID);
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		const size_t n = ring.size();
+		std::optional<GeodesicSolver> own;
+		std::vector<E3> mapped;
+		mapped.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			const E3& a = ring[i];
+			const E3& b = ring[(i + 1) % n];
+			mapped.push_back(authalic(e, a));
+			const double theta = std::atan2(a.cross(b).mag(), a.dot(b));
+			const int k = static_cast<int>(std::ceil(theta / max_step));
+			if (k <= 1)
+			{
+				continue;
+			}
+			if (!g)
+			{
+				g = &own.emplace(e);
+			}
+			const GeodesicArcFrame frame = GeodesicArc{ a, b, e }.frame(*g);
+			for (int j = 1; j < k; ++j)
+			{
+				mapped.push_back(authalic(e, frame.at_distance(frame.length() * j / k)));
+			}
+		}
+		const double r = e.authalic_radius();
+		return r * r * spherical_area(mapped);
+	}
+
+	double elliptic_area(LoopView<E3> ring, const Ellipsoid& e, const LinearTransformation& T)
+	{
+		const double r = e.major();
+		if (T.is_identity())
+		{
+			return r * r * spherical_area(ring);
+		}
+		const size_t n = ring.size();
+		if (n < 3)
+		{
+			return 0.0;
+		}
+
+		// A linear map M scales the area element of a surface with unit
+		// normal x by |det M| |M^-T x|; the shear has det 1, and its inverse
+		// maps y to (x + kx y, y, z + kz y)
+		const E3 k = T.inverse(E3{ 0.0, 1.0, 0.0 });
+		const auto density = [kx = k.x, kz = k.z](const E3& x) {
+			const double y = kx * x.x + x.y + kz * x.z;
+			return std::sqrt(x.x * x.x + y * y + x.z * x.z);
+		};
+		const SphericalQuadrature<decltype(density)> integrate(density);
+
+		const std::vector<E3> u = units(ring);
+		const E3 o = fan_apex(u);
+		Double fan{}, sum{};
+		for (size_t i = 0; i < n; ++i)
+		{
+			fan = fan + excess(o, u[i], u[(i + 1) % n]);
+			sum = sum + integrate(o, u[i], u[(i + 1) % n]);
+		}
+
+		// The fan covers the signed region up to a constant number of whole
+		// spheres, which the spherical sums reveal
+		const double spherical = static_cast<double>(fan);
+		const double wraps = std::round((spherical - reduce(spherical)) / four_pi);
+		if (wraps != 0.0)
+		{
+			Double total{};
+			for (int sx : { 1, -1 })
+			{
+				for (int sy : { 1, -1 })
+				{
+					for (int sz : { 1, -1 })
+					{
+						const E3 x{ double(sx), 0.0, 0.0 }, y{ 0.0, double(sy), 0.0 }, z{ 0.0, 0.0, double(sz) };
+						total = total + (sx * sy * sz > 0 ? integrate(x, y, z) : integrate(y, x, z));
+					}
+				}
+			}
+			sum = sum - static_cast<double>(total) * wraps;
+		}
+		return r * r * static_cast<double>(sum);
+	}
+
+	void area(const FlatCompoundSet<E3>& regions, std::span<double> out, const Ellipsoid& e, unsigned threads)
+	{
+		assert(regions.size() == out.size());
+		const std::optional<GeodesicSolver> g = e.is_sphere()
+			? std::nullopt : std::optional<GeodesicSolver>(std::in_place, e);
+		parallel_for(regions.size(), [&](size_t begin, size_t end) {
+			for (size_t c = begin; c < end; ++c)
+			{
+				const auto part = regions[c];
+				Double sum{};
+				for (size_t i = 0; i < part.size(); ++i)
+				{
+					sum = sum + geodesic_area(part[i], e, g ? &*g : nullptr);
+				}
+				out[c] = static_cast<double>(sum);
+			}
+		}, threads, 64);
+	}
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+// References:
+// Van Oosterom, A., & Strackee, J. (1983). The solid angle of a plane triangle. IEEE Transactions on Biomedical Engineering, BME-30(2), 125-126. https://doi.org/10.1109/TBME.1983.325207
+// Snyder, J. P. (1987). Map projections: A working manual. U.S. Geological Survey Professional Paper 1395, 16-17. https://doi.org/10.3133/pp1395
+
+#include <S2LL/Core/Geodesics.hpp>
+#include <S2LL/Core/Numerics.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	// Signed areas. A ring encloses the region to the left of its edges; its
+	// signed area is the area of that region when it is at most a hemisphere,
+	// and minus the area of the other side otherwise. Small rings are thus
+	// positive counterclockwise and negative clockwise (seen from outside),
+	// and a Compound region with counterclockwise outer rings and clockwise
+	// holes has the sum of its ring areas as area. Shapefiles use the
+	// opposite orientation, which negates the result.
+	//
+	// Every ring is summed as a fan of signed triangles in double-double, in
+	// a fixed order, so results are reproducible and independent of the
+	// number of threads of the batch functions.
+
+	/// Signed area, in steradians, of the spherical polygon with great-circle
+	/// edges through the given directions; within (-2 pi, 2 pi]
+	double spherical_area(LoopView<E3> ring);
+
+	/// Signed surface area of the geodesic polygon through the given
+	/// directions on the surface e. A spheroid is mapped onto its authalic
+	/// sphere, which preserves areas. Edges longer than 0.001 rad (6 km on
+	/// the Earth) are densified along the geodesic first, which keeps the
+	/// error of the mapped edges near 1e-9 of the area even for continental
+	/// polygons. A solver for e may be passed in to be reused. Triaxial
+	/// surfaces yield NaN.
+	double geodesic_area(LoopView<E3> ring, const Ellipsoid& e, const GeodesicSolver* g = nullptr);
+
+	/// Signed world-space area of the great elliptic polygon through the
+	/// given directions on the sphere of radius e.major() sheared by T. Under
+	/// a shear, the area density of the pre-image is integrated over a fan
+	/// of spherical triangles by adaptive quadrature.
+	double elliptic_area(LoopView<E3> ring, const Ellipsoid& e, const LinearTransformation& T);
+
+	/// Signed area of a geodesic polygon on the surface e
+	template <size_t N>
+	inline double area(const GP<N>& poly, const Ellipsoid& e = UnitSphere)
+	{
+		return geodesic_area(LoopView<E3>(poly.boundary), e);
+	}
+
+	/// Signed area of a great elliptic polygon on the (sheared) surface
+	template <size_t N>
+	inline double area(
+		const GEP<N>& poly, const Ellipsoid& e = UnitSphere,
+		const LinearTransformation& T = LinearTransformation{})
+	{
+		return elliptic_area(LoopView<E3>(poly.boundary), e, T);
+	}
+
+	/// Area of a Compound region: the sum of the signed areas of its rings
+	template <typename P, typename... Args>
+	inline double area(const Compound<P>& region, const Args&... args)
+	{
+		Double sum{};
+		for (const P& poly : region.polygons)
+		{
+			sum = sum + area(poly, args...);
+		}
+		return static_cast<double>(sum);
+	}
+
+	/// Batch areas of Compound geodesic regions: out[i] is the area of
+	/// regions[i], so out holds one entry per region; the regions are
+	/// split among up to `threads` threads (0: one per hardware thread), and
+	/// one geodesic solver serves them all.
+	template <size_t N>
+	void area(const std::vector<Compound<GP<N>>>& regions, std::span<double> out,
+		const Ellipsoid& e = UnitSphere, unsigned threads = 1)
+	{
+		assert(regions.size() == out.size());
+		const std::optional<GeodesicSolver> g = e.is_sphere()
+			? std::nullopt : std::optional<GeodesicSolver>(std::in_place, e);
+		parallel_for(regions.size(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				Double sum{};
+				for (const GP<N>& poly : regions[i].polygons)
+				{
+					sum = sum + geodesic_area(LoopView<E3>(poly.boundary), e, g ? &*g : nullptr);
+				}
+				out[i] = static_cast<double>(sum);
+			}
+		}, threads, 64);
+	}
+
+	/// Batch areas of the parts of a flat compound set of geodesic polygons
+	void area(const FlatCompoundSet<E3>& regions, std::span<double> out,
+		const Ellipsoid& e = UnitSphere, unsigned threads = 1);
+
+	/// Batch areas of Compound great elliptic regions on the (sheared)
+	/// surface, as for geodesic regions
+	template <size_t N>
+	void area(const std::vector<Compound<GEP<N>>>& regions, std::span<double> out,
+		const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{},
+		unsigned threads = 1)
+	{
+		assert(regions.size() == out.size());
+		parallel_for(regions.size(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				out[i] = area(regions[i], e, T);
+			}
+		}, threads, 16);
+	}
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <S2LL/Core/BoundaryIndex.hpp>
+#include <S2LL/Core/Geodesics.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Angle by which a geodesic of the spheroid is taken to stray from
+		/// the great-circle arc between its endpoints, an angle t apart. The
+		/// stray grows with the square of the arc and without bound towards
+		/// antipodal endpoints, whose geodesics may leave the great circle
+		/// altogether. Measured strays on WGS 84 stay under this bound by a
+		/// factor of 2.5, from 4e-5 f at a degree to 0.4 f at a quarter turn
+		/// and 45 f at 178 degrees; it reaches a half turn as the endpoints
+		/// come within pi f of antipodal.
+		inline double stray(const Ellipsoid& e, double t) noexcept
+		{
+			const double f = e.major() / e.minor() - 1.0;
+			return t < std::numbers::pi ? std::min(std::numbers::pi, f * t * t / (std::numbers::pi - t)) : std::numbers::pi;
+		}
+
+		std::vector<LoopView<E3>> rings_of(const FlatCompoundSet<E3>& set)
+		{
+			std::vector<LoopView<E3>> rings;
+			rings.reserve(set.ring_count());
+			for (size_t r = 0; r < set.ring_count(); ++r)
+			{
+				rings.push_back(set.ring(r));
+			}
+			return rings;
+		}
+
+		inline bool before(const BoundaryHit& a, const BoundaryHit& b) noexcept
+		{
+			if (a.distance != b.distance)
+			{
+				return a.distance < b.distance;
+			}
+			return a.ring != b.ring ? a.ring < b.ring : a.edge < b.edge;
+		}
+	}
+
+	BoundaryIndex::BoundaryIndex(const FlatCompoundSet<E3>& set, unsigned threads)
+		: edges(rings_of(set), threads), regions(set), ring_offsets(set.ring_offsets), part_offsets(set.part_offsets)
+	{
+		for (size_t i = 0; i < edges.size(); ++i)
+		{
+			const auto [a, b] = edges.edge(i);
+			longest = std::max(longest, angle(unit(a), unit(b)));
+		}
+	}
+
+	BoundaryHit BoundaryIndex::measure(const E3& q, const EdgeHit& h, const Ellipsoid& e, const GeodesicSolver* g) const
+	{
+		const size_t ring = edges.ring_of(h.edge);
+		const size_t region = static_cast<size_t>(std::upper_bound(part_offsets.begin(), part_offsets.end(), ring) - part_offsets.begin()) - 1;
+		BoundaryHit hit{ region, ring, h.edge - ring_offsets[ring], h.point, h.angle };
+		if (g == nullptr)
+		{
+			const double R = e.major();
+			hit.point = E3{ R * h.point.x, R * h.point.y, R * h.point.z };
+			hit.distance = R * h.angle;
+			return hit;
+		}
+		const auto [a, b] = edges.edge(h.edge);
+		const ArcProjection projection = GeodesicArc{ a, b, e }.frame(*g).closest(q);
+		hit.point = projection.point;
+		hit.distance = projection.distance;
+		return hit;
+	}
+
+	BoundaryHit BoundaryIndex::nearest(const E3& p, const Ellipsoid& e, const GeodesicSolver* g) const
+	{
+		assert(edges.size() > 0);
+		const E3 q = unit(p);
+		const EdgeHit first = edges.nearest(q);
+		BoundaryHit best = measure(q, first, e, g);
+		if (g == nullptr || std::isnan(best.distance))
+		{
+			return best;
+		}
+
+		// Any edge nearer on the surface is within best.distance / minor of
+		// q, give or take the stray of its geodesic
+		const double minor = e.minor(), pad = stray(e, longest);
+		for (const EdgeHit& h : edges.within(q, best.distance / minor + pad))
+		{
+			if (minor * (h.angle - pad) > best.distance)
+			{
+				break;
+			}
+			if (h.edge != first.edge)
+			{
+				const BoundaryHit hit = measure(q, h, e, g);
+				if (before(hit, best))
+				{
+					best = hit;
+				}
+			}
+		}
+		return best;
+	}
+
+	BoundaryHit BoundaryIndex::nearest(const E3& p) const
+	{
+		return nearest(p, UnitSphere, nullptr);
+	}
+
+	BoundaryHit BoundaryIndex::nearest(const E3& p, const Ellipsoid& e) const
+	{
+		if (e.is_sphere())
+		{
+			return nearest(p, e, nullptr);
+		}
+		const GeodesicSolver g(e);
+		return nearest(p, e, &g);
+	}
+
+	std::vector<BoundaryHit> BoundaryIndex::nearest_regions(const E3& p, size_t k, const Ellipsoid& e, const GeodesicSolver* g) const
+	{
+		std::vector<BoundaryHit> out;
+		if (k == 0)
+		{
+			return out;
+		}
+		const E3 q = unit(p);
+		const std::vector<size_t> inside = regions.locate_all(q);
+		for (const size_t region : inside)
+		{
+			out.push_back(BoundaryHit{ region, BoundaryHit::npos, BoundaryHit::npos, p, 0.0 });
+		}
+		if (out.size() >= k || edges.size() == 0)
+		{
+			out.resize(std::min(out.size(), k));
+			return out;
+		}
+
+		// Surface distance below which every edge has been measured, for a
+		// search radius (angle) around q, and the radius reaching a distance
+		const double scale = g == nullptr ? e.major() : e.minor();
+		const double pad = g == nullptr ? 0.0 : stray(e, longest);
+		const BoundaryHit first = nearest(q, e, g);
+		if (std::isnan(first.distance))
+		{
+			return out;
+		}
+		double radius = std::max(first.distance / scale + pad, 1e-6);
+
+		std::vector<BoundaryHit> found;
+		while (true)
+		{
+			// Nearest edge of every region met within the radius
+			found.clear();
+			for (const EdgeHit& h : edges.within(q, radius))
+			{
+				found.push_back(measure(q, h, e, g));
+			}
+			std::sort(found.begin(), found.end(), [](const BoundaryHit& a, const BoundaryHit& b) {
+				return a.region != b.region ? a.region < b.region : before(a, b);
+			});
+			found.erase(std::unique(found.begin(), found.end(), [](const BoundaryHit& a, const BoundaryHit& b) {
+				return a.region == b.region;
+			}), found.end());
+			found.erase(std::remove_if(found.begin(), found.end(), [&](const BoundaryHit& h) {
+				return std::binary_search(inside.begin(), inside.end(), h.region);
+			}), found.end());
+			std::sort(found.begin(), found.end(), [](const BoundaryHit& a, const BoundaryHit& b) {
+				return a.distance != b.distance ? a.distance < b.distance : a.region < b.region;
+			});
+
+			// Regions nearer than the bound are final; past a half turn the
+			// radius covers every edge
+			const bool all = radius >= std::numbers::pi;
+			const double bound = all ? std::numeric_limits<double>::infinity() : scale * (radius - pad);
+			const size_t certain = static_cast<size_t>(std::find_if(found.begin(), found.end(), [&](const BoundaryHit& h) {
+				return h.distance > bound;
+			}) - found.begin());
+			if (all || out.size() + certain >= k)
+			{
+				out.insert(out.end(), found.begin(), found.begin() + static_cast<ptrdiff_t>(std::min(certain, k - out.size())));
+				return out;
+			}
+			radius = std::min(2.0 * radius, std::numbers::pi);
+		}
+	}
+
+	std::vector<BoundaryHit> BoundaryIndex::nearest_regions(const E3& p, size_t k) const
+	{
+		return nearest_regions(p, k, UnitSphere, nullptr);
+	}
+
+	std::vector<BoundaryHit> BoundaryIndex::nearest_regions(const E3& p, size_t k, const Ellipsoid& e) const
+	{
+		if (e.is_sphere())
+		{
+			return nearest_regions(p, k, e, nullptr);
+		}
+		const GeodesicSolver g(e);
+		return nearest_regions(p, k, e, &g);
+	}
+
+	void BoundaryIndex::nearest(std::span<const E3> points, std::span<BoundaryHit> out,
+		const Ellipsoid& e, const GeodesicSolver* g, unsigned threads) const
+	{
+		assert(points.size() == out.size());
+		const size_t n = points.size();
+
+		// Morton code of the direction above the point index
+		std::vector<uint64_t> keys(n);
+		parallel_for(n, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const E3 u = unit(points[i]);
+				const uint64_t code = (spread10(u.x) << 2) | (spread10(u.y) << 1) | spread10(u.z);
+				keys[i] = (code << 32) | i;
+			}
+		}, threads, 4096);
+		std::sort(keys.begin(), keys.end());
+
+		parallel_for(n, [&](size_t begin, size_t end) {
+			for (size_t j = begin; j < end; ++j)
+			{
+				const size_t i = static_cast<uint32_t>(keys[j]);
+				out[i] = nearest(points[i], e, g);
+			}
+		}, threads, 256);
+	}
+
+	void BoundaryIndex::nearest(std::span<const E3> points, std::span<BoundaryHit> out, unsigned threads) const
+	{
+		nearest(points, out, UnitSphere, nullptr, threads);
+	}
+
+	void BoundaryIndex::nearest(std::span<const E3> points, std::span<BoundaryHit> out, const Ellipsoid& e, unsigned threads) const
+	{
+		if (e.is_sphere())
+		{
+			nearest(points, out, e, nullptr, threads);
+			return;
+		}
+		const GeodesicSolver g(e);
+		nearest(points, out, e, &g, threads);
+	}
+
+	size_t BoundaryIndex::memory_usage() const noexcept
+	{
+		return edges.memory_usage() + regions.memory_usage()
+			+ (ring_offsets.capacity() + part_offsets.capacity()) * sizeof(size_t);
+	}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+// References:
+// Roussopoulos, N., Kelley, S., & Vincent, F. (1995). Nearest neighbor queries. Proceedings of the 1995 ACM SIGMOD International Conference on Management of Data, 71-79. https://doi.org/10.1145/223784.223794
+// Hjaltason, G. R., & Samet, H. (1999). Distance browsing in spatial databases. ACM Transactions on Database Systems, 24(2), 265-318. https://doi.org/10.1145/320248.320255
+
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	class GeodesicSolver;
+
+	/// Boundary point of a region reached by a query: the region, the ring
+	/// (numbered over the whole set, as FlatCompoundSet::ring) and the edge
+	/// within it, the closest point on the surface and its distance
+	struct BoundaryHit
+	{
+		/// Ring and edge of a region reported as containing the query
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		size_t region;
+		size_t ring;
+		size_t edge;
+		E3 point;
+		double distance;
+	};
+
+	/// Distance queries against the boundaries of a set of Compound regions:
+	/// the nearest boundary point and the k nearest regions. All ring edges
+	/// share one EdgeBVH, searched branch and bound (nearest box first, boxes
+	/// farther than the best edge so far pruned), and a RegionIndex answers
+	/// which regions contain the query.
+	///
+	/// Without a surface, distances are angles in radians between unit
+	/// directions and edges are great-circle arcs. On a sphere of radius R
+	/// they scale by R; on an oblate spheroid, edges are geodesics and
+	/// distances are exact surface lengths (GeodesicArc::closest). The
+	/// spheroid search keeps the great-circle index: a surface path between
+	/// two directions an angle t apart is at least minor() * t long, so once
+	/// an edge's exact distance is known, only edges within that bound (plus
+	/// the angle by which a geodesic may stray from its great circle) are
+	/// measured. The stray grows with the length of the edge and without
+	/// bound as its endpoints near antipodal, and the longest edge of the
+	/// set sets it for all: a set with edges across most of a half turn
+	/// has every spheroid query measure far more edges, up to all of them.
+	/// Split long edges with densify() first where that matters.
+	class BoundaryIndex
+	{
+		EdgeBVH edges;
+		RegionIndex regions;
+
+		// Vertex offsets of the rings and ring offsets of the regions, as
+		// in the indexed FlatCompoundSet
+		std::vector<size_t> ring_offsets;
+		std::vector<size_t> part_offsets;
+
+		// Angle of the longest edge, which bounds how far the geodesic
+		// edges stray from their great circles
+		double longest = 0.0;
+
+		BoundaryHit measure(const E3& q, const EdgeHit& h, const Ellipsoid& e, const GeodesicSolver* g) const;
+
+		BoundaryHit nearest(const E3& p, const Ellipsoid& e, const GeodesicSolver* g) const;
+
+		std::vector<BoundaryHit> nearest_regions(const E3& p, size_t k, const Ellipsoid& e, const GeodesicSolver* g) const;
+
+		void nearest(std::span<const E3> points, std::span<BoundaryHit> out,
+			const Ellipsoid& e, const GeodesicSolver* g, unsigned threads) const;
+
+	public:
+		/// Indexes the parts of a flat compound set; the edge index is built
+		/// on up to `threads` threads (0: one per hardware thread)
+		explicit BoundaryIndex(const FlatCompoundSet<E3>& set, unsigned threads = 1);
+
+		/// Indexes nested Compound polygons
+		template <size_t N>
+		explicit BoundaryIndex(const std::vector<Compound<GP<N>>>& set, unsigned threads = 1)
+			: BoundaryIndex(FlatCompoundSet<E3>::from(set), threads)
+		{
+		}
+
+		/// Number of regions
+		inline size_t size() const noexcept { return part_offsets.size() - 1; }
+
+		/// Nearest boundary point to the direction p, as a unit direction
+		/// with its angular distance. Equal distances go to the lowest
+		/// ring and edge. The set must hold an edge.
+		BoundaryHit nearest(const E3& p) const;
+
+		/// Nearest boundary point to the surface point on the ray of p, on a
+		/// sphere or an oblate spheroid, with its surface distance
+		BoundaryHit nearest(const E3& p, const Ellipsoid& e) const;
+
+		/// The k regions nearest to the direction p (all of them if there are
+		/// fewer), by angular distance to the region: regions containing p
+		/// come first, at distance 0 with ring and edge npos and p itself as
+		/// the point, then the others by the distance to their nearest
+		/// boundary point; equal distances by region index. The search widens
+		/// a radius around p until k regions are certain.
+		std::vector<BoundaryHit> nearest_regions(const E3& p, size_t k) const;
+
+		/// The k nearest regions by surface distance, on a sphere or an
+		/// oblate spheroid
+		std::vector<BoundaryHit> nearest_regions(const E3& p, size_t k, const Ellipsoid& e) const;
+
+		/// Batch queries: out[i] = nearest(points[i]). The spans must have the
+		/// same length. The points are visited in Morton order of their
+		/// directions, so consecutive queries descend through the same nodes
+		/// and edges while they are still cached; the sorted sequence is
+		/// split among up to `threads` threads (0: one per hardware thread).
+		void nearest(std::span<const E3> points, std::span<BoundaryHit> out, unsigned threads = 1) const;
+
+		/// Batch queries on a sphere or an oblate spheroid, as above
+		void nearest(std::span<const E3> points, std::span<BoundaryHit> out, const Ellipsoid& e, unsigned threads = 1) const;
+
+		/// Heap bytes held by the index
+		size_t memory_usage() const noexcept;
+	};
+}
@@ -0,0 +1,435 @@
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <iterator>
+#include <S2LL/Core/Cells.hpp>
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/PointIndex.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Face frame: the face normal and the u and v axes, with u x v = n
+		struct Frame
+		{
+			E3 n, u, v;
+		};
+
+		const Frame frames[6] = {
+			{ { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } },
+			{ { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 }, { 1.0, 0.0, 0.0 } },
+			{ { 0.0, 0.0, 1.0 }, { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 } },
+			{ { -1.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 }, { 0.0, 1.0, 0.0 } },
+			{ { 0.0, -1.0, 0.0 }, { 1.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 } },
+			{ { 0.0, 0.0, -1.0 }, { 0.0, 1.0, 0.0 }, { 1.0, 0.0, 0.0 } },
+		};
+
+		constexpr uint64_t leaves = uint64_t{ 1 } << CellId::max_level;
+
+		/// Spreads the low 32 bits of x to the even bits
+		inline uint64_t part1by1(uint64_t x) noexcept
+		{
+			x &= 0xFFFFFFFFull;
+			x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+			x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+			x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+			x = (x | (x << 2)) & 0x3333333333333333ull;
+			x = (x | (x << 1)) & 0x5555555555555555ull;
+			return x;
+		}
+
+		/// Gathers the even bits of x
+		inline uint64_t compact1by1(uint64_t x) noexcept
+		{
+			x &= 0x5555555555555555ull;
+			x = (x | (x >> 1)) & 0x3333333333333333ull;
+			x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+			x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+			x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+			x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+			return x;
+		}
+
+		inline uint64_t lsb_for_level(int level) noexcept
+		{
+			return uint64_t{ 1 } << (2 * (CellId::max_level - level));
+		}
+
+		/// Face coordinate of leaf position i (or of the edge between leaves
+		/// i - 1 and i)
+		inline double coordinate(uint64_t i) noexcept
+		{
+			return -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(leaves);
+		}
+
+		/// Leaf position of a face coordinate
+		inline uint32_t position(double s) noexcept
+		{
+			const double t = std::floor((s + 1.0) * 0.5 * static_cast<double>(leaves));
+			return static_cast<uint32_t>(std::clamp(t, 0.0, static_cast<double>(leaves - 1)));
+		}
+
+		inline E3 on_face(int face, double u, double v) noexcept
+		{
+			const Frame& f = frames[face];
+			return unit(E3{ f.n.x + u * f.u.x + v * f.v.x, f.n.y + u * f.u.y + v * f.v.y, f.n.z + u * f.u.z + v * f.v.z });
+		}
+
+		/// Face square of a cell: [u0, u1] x [v0, v1]
+		struct Square
+		{
+			double u0, u1, v0, v1;
+		};
+
+		Square square(CellId c) noexcept
+		{
+			const uint64_t pos = (c.range_min().id >> 1) & ((uint64_t{ 1 } << 60) - 1);
+			const uint64_t i = compact1by1(pos >> 1), j = compact1by1(pos);
+			const uint64_t size = c.lsb() == 0 ? 0 : uint64_t{ 1 } << (CellId::max_level - c.level());
+			return Square{ coordinate(i), coordinate(i + size), coordinate(j), coordinate(j + size) };
+		}
+
+		enum class Relation
+		{
+			Disjoint,
+			Partial,
+			Inside
+		};
+
+		/// One region, indexed for cell classification
+		class Shape
+		{
+			FlatCompoundSet<E3> set;
+			EdgeBVH edges;
+			PointIndex points;
+			RegionIndex regions;
+
+			static std::vector<LoopView<E3>> rings_of(const FlatCompoundSet<E3>& set)
+			{
+				std::vector<LoopView<E3>> rings;
+				rings.reserve(set.ring_count());
+				for (size_t r = 0; r < set.ring_count(); ++r)
+				{
+					rings.push_back(set.ring(r));
+				}
+				return rings;
+			}
+
+		public:
+			explicit Shape(const Compound<GP<>>& region)
+				: set(FlatCompoundSet<E3>::from(std::vector<Compound<GP<>>>{ region })),
+				  edges(rings_of(set)), points(set.vertices), regions(set)
+			{
+			}
+
+			Relation relate(CellId c) const
+			{
+				E3 v[4];
+				for (int k = 0; k < 4; ++k)
+				{
+					v[k] = c.vertex(k);
+				}
+
+				// A boundary edge across a cell side
+				for (int k = 0; k < 4; ++k)
+				{
+					if (edges.crosses(v[k], v[(k + 1) % 4]))
+					{
+						return Relation::Partial;
+					}
+				}
+
+				// Corners (and the center) on both sides of the boundary
+				int inside = regions.contains(0, c.center()) ? 1 : 0;
+				for (int k = 0; k < 4; ++k)
+				{
+					inside += regions.contains(0, v[k]) ? 1 : 0;
+				}
+				if (inside != 0 && inside != 5)
+				{
+					return Relation::Partial;
+				}
+
+				// With no proper crossing, the boundary can still enter the cell
+				// as a whole ring (a hole or a small part), or run along its
+				// sides: then a vertex lies in the closed cell
+				const Cap cap = c.cap();
+				for (const Neighbor& n : points.within(cap.axis, cap.radius()))
+				{
+					const E3& p = set.vertices[n.index];
+					if (orient(v[0], v[1], p) >= 0 && orient(v[1], v[2], p) >= 0 && orient(v[2], v[3], p) >= 0 && orient(v[3], v[0], p) >= 0)
+					{
+						return Relation::Partial;
+					}
+				}
+				return inside == 5 ? Relation::Inside : Relation::Disjoint;
+			}
+		};
+
+		CellUnion cover(const Compound<GP<>>& region, const CoveringOptions& options, bool interior)
+		{
+			const Shape shape(region);
+			const int min_level = std::clamp(options.min_level, 0, CellId::max_level);
+			const int max_level = std::clamp(options.max_level, min_level, CellId::max_level);
+
+			// An interior search drops boundary cells rather than keeping them,
+			// so only the number of candidates bounds its work
+			const size_t candidates = std::max<size_t>(64, 16 * options.max_cells);
+
+			struct Candidate
+			{
+				CellId cell;
+				bool inside;
+			};
+
+			// First in, first out: candidates come coarsest first, then by id
+			std::deque<Candidate> queue;
+			std::vector<CellId> result;
+			const auto relate = [&](CellId c, std::vector<Candidate>& out) {
+				const Relation r = shape.relate(c);
+				if (r != Relation::Disjoint)
+				{
+					out.push_back(Candidate{ c, r == Relation::Inside });
+				}
+			};
+
+			std::vector<Candidate> children;
+			for (int face = 0; face < 6; ++face)
+			{
+				relate(CellId::from_face(face), children);
+			}
+			queue.assign(children.begin(), children.end());
+
+			while (!queue.empty())
+			{
+				if (interior && result.size() >= options.max_cells && queue.front().cell.level() >= min_level)
+				{
+					break;
+				}
+				const Candidate c = queue.front();
+				queue.pop_front();
+				const int level = c.cell.level();
+
+				children.clear();
+				if (c.inside)
+				{
+					if (level >= min_level)
+					{
+						result.push_back(c.cell);
+						continue;
+					}
+					for (int k = 0; k < 4; ++k)
+					{
+						children.push_back(Candidate{ c.cell.child(k), true });
+					}
+					queue.insert(queue.end(), children.begin(), children.end());
+					continue;
+				}
+
+				if (level >= max_level)
+				{
+					if (!interior)
+					{
+						result.push_back(c.cell);
+					}
+					continue;
+				}
+				if (level >= min_level && interior && result.size() + queue.size() + 4 > candidates)
+				{
+					continue;
+				}
+				for (int k = 0; k < 4; ++k)
+				{
+					relate(c.cell.child(k), children);
+				}
+				if (level < min_level || interior || result.size() + queue.size() + children.size() <= options.max_cells)
+				{
+					queue.insert(queue.end(), children.begin(), children.end());
+				}
+				else
+				{
+					result.push_back(c.cell);
+				}
+			}
+			return CellUnion(std::move(result));
+		}
+	}
+
+	CellId CellId::from_face(int face) noexcept
+	{
+		assert(face >= 0 && face < 6);
+		return CellId{ (static_cast<uint64_t>(face) << 61) | lsb_for_level(0) };
+	}
+
+	CellId CellId::from_face_ij(int face, uint32_t i, uint32_t j, int level) noexcept
+	{
+		assert(face >= 0 && face < 6 && level >= 0 && level <= max_level);
+		const int shift = max_level - level;
+		const uint64_t pos = (part1by1(static_cast<uint64_t>(i) << shift) << 1) | part1by1(static_cast<uint64_t>(j) << shift);
+		const CellId leaf{ (static_cast<uint64_t>(face) << 61) | (pos << 1) | 1 };
+		return leaf.parent(level);
+	}
+
+	CellId CellId::from_point(const E3& p, int level) noexcept
+	{
+		const double ax = std::abs(p.x), ay = std::abs(p.y), az = std::abs(p.z);
+		int face = ax >= ay && ax >= az ? 0 : ay >= az ? 1 : 2;
+		if ((face == 0 ? p.x : face == 1 ? p.y : p.z) < 0.0)
+		{
+			face += 3;
+		}
+		const Frame& f = frames[face];
+		const double d = plain_dot(p, f.n);
+		const uint32_t i = position(plain_dot(p, f.u) / d), j = position(plain_dot(p, f.v) / d);
+		return from_face_ij(face, i >> (max_level - level), j >> (max_level - level), level);
+	}
+
+	bool CellId::is_valid() const noexcept
+	{
+		return face() < 6 && (lsb() & 0x1555555555555555ull) != 0;
+	}
+
+	int CellId::level() const noexcept
+	{
+		return max_level - std::countr_zero(id) / 2;
+	}
+
+	CellId CellId::parent(int level) const noexcept
+	{
+		assert(level >= 0 && level <= this->level());
+		const uint64_t lsb = lsb_for_level(level);
+		return CellId{ (id & (~lsb + 1)) | lsb };
+	}
+
+	CellId CellId::child(int k) const noexcept
+	{
+		assert(k >= 0 && k < 4 && level() < max_level);
+		const uint64_t step = lsb() >> 2;
+		return CellId{ id - 3 * step + 2 * static_cast<uint64_t>(k) * step };
+	}
+
+	E3 CellId::vertex(int k) const noexcept
+	{
+		const Square s = square(*this);
+		switch (k & 3)
+		{
+		case 0:
+			return on_face(face(), s.u0, s.v0);
+		case 1:
+			return on_face(face(), s.u1, s.v0);
+		case 2:
+			return on_face(face(), s.u1, s.v1);
+		default:
+			return on_face(face(), s.u0, s.v1);
+		}
+	}
+
+	E3 CellId::center() const noexcept
+	{
+		const Square s = square(*this);
+		return on_face(face(), 0.5 * (s.u0 + s.u1), 0.5 * (s.v0 + s.v1));
+	}
+
+	Cap CellId::cap() const noexcept
+	{
+		// The cell is the convex hull of its corners, so the cap through the
+		// farthest corner holds it. The slack covers rounding, and keeps deep
+		// cells (whose radius the cosine cannot resolve) inside a wider cap.
+		const E3 c = center();
+		double cos_radius = 1.0;
+		for (int k = 0; k < 4; ++k)
+		{
+			cos_radius = std::min(cos_radius, plain_dot(c, vertex(k)));
+		}
+		return padded_cap(c, cos_radius);
+	}
+
+	CellUnion::CellUnion(std::vector<CellId> cells)
+	{
+		std::sort(cells.begin(), cells.end());
+		ids.reserve(cells.size());
+		for (CellId c : cells)
+		{
+			if (!ids.empty() && ids.back().contains(c))
+			{
+				continue;
+			}
+			// Descendants sort before their ancestor's id as well as after
+			while (!ids.empty() && c.contains(ids.back()))
+			{
+				ids.pop_back();
+			}
+			// Four siblings in a row are their parent
+			while (ids.size() >= 3 && c.level() > 0)
+			{
+				const size_t n = ids.size();
+				const CellId p = c.parent();
+				if (ids[n - 3] != p.child(0) || ids[n - 2] != p.child(1) || ids[n - 1] != p.child(2) || c != p.child(3))
+				{
+					break;
+				}
+				ids.resize(n - 3);
+				c = p;
+			}
+			ids.push_back(c);
+		}
+	}
+
+	bool CellUnion::contains(CellId cell) const noexcept
+	{
+		const auto it = std::lower_bound(ids.begin(), ids.end(), cell);
+		if (it != ids.end() && it->range_min() <= cell)
+		{
+			return true;
+		}
+		return it != ids.begin() && std::prev(it)->range_max() >= cell;
+	}
+
+	bool CellUnion::intersects(CellId cell) const noexcept
+	{
+		const auto it = std::lower_bound(ids.begin(), ids.end(), cell.range_min());
+		if (it != ids.end() && it->range_min() <= cell.range_max())
+		{
+			return true;
+		}
+		return it != ids.begin() && std::prev(it)->range_max() >= cell.range_min();
+	}
+
+	bool CellUnion::intersects(const CellUnion& other) const noexcept
+	{
+		const CellUnion& small = size() <= other.size() ? *this : other;
+		const CellUnion& large = size() <= other.size() ? other : *this;
+		return std::any_of(small.begin(), small.end(), [&](CellId c) {
+			return large.intersects(c);
+		});
+	}
+
+	uint64_t CellUnion::leaf_count(int level) const noexcept
+	{
+		uint64_t count = 0;
+		for (CellId c : ids)
+		{
+			assert(c.level() <= level);
+			count += uint64_t{ 1 } << (2 * (level - c.level()));
+		}
+		return count;
+	}
+
+	CellUnion covering(const Compound<GP<>>& region, const CoveringOptions& options)
+	{
+		return cover(region, options, false);
+	}
+
+	CellUnion interior_covering(const Compound<GP<>>& region, const CoveringOptions& options)
+	{
+		return cover(region, options, true);
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+// References:
+// Samet, H. (1984). The quadtree and related hierarchical data structures. ACM Computing Surveys, 16(2), 187-260. https://doi.org/10.1145/356924.356930
+// S2 Geometry library: cell hierarchy and region coverer. https://s2geometry.io/devguide/s2cell_hierarchy
+
+#include <S2LL/Core/Regions.hpp>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Cell of a quadtree on each face of the cube around the sphere. A face
+	/// is projected through the center (gnomonic projection), so cell sides
+	/// are great-circle arcs and cells are convex quadrilaterals; cell areas
+	/// vary by up to a factor of about five across a face.
+	///
+	/// The id packs the face in the top three bits, then two bits per level
+	/// (the child number: 2 * u bit + v bit, Morton order), then a marker
+	/// bit. The leaves of a cell are the ids from range_min() to range_max(),
+	/// so containment and intersection are integer comparisons and sorted ids
+	/// keep every cell next to its descendants.
+	struct CellId
+	{
+		/// Deepest level: cells about 1 cm across on the Earth
+		static constexpr int max_level = 30;
+
+		uint64_t id = 0;
+
+		auto operator<=>(const CellId&) const = default;
+
+		/// Face cell, 0 to 5 for +x, +y, +z, -x, -y, -z
+		static CellId from_face(int face) noexcept;
+
+		/// Cell at the given level whose face square holds (i, j), each below
+		/// 2^level, along the u and v axes of the face
+		static CellId from_face_ij(int face, uint32_t i, uint32_t j, int level) noexcept;
+
+		/// Cell at the given level holding the direction p
+		static CellId from_point(const E3& p, int level = max_level) noexcept;
+
+		/// True for ids of actual cells
+		bool is_valid() const noexcept;
+
+		inline int face() const noexcept { return static_cast<int>(id >> 61); }
+
+		int level() const noexcept;
+
+		/// Lowest set bit: the marker of the level
+		inline uint64_t lsb() const noexcept { return id & (~id + 1); }
+
+		inline CellId range_min() const noexcept { return CellId{ id - (lsb() - 1) }; }
+
+		inline CellId range_max() const noexcept { return CellId{ id + (lsb() - 1) }; }
+
+		/// True if the cell holds the other one (or is it)
+		inline bool contains(CellId other) const noexcept { return range_min() <= other && other <= range_max(); }
+
+		/// True if one of the cells holds the other
+		inline bool intersects(CellId other) const noexcept
+		{
+			return other.range_min() <= range_max() && other.range_max() >= range_min();
+		}
+
+		/// Ancestor at a level no deeper than this cell's
+		CellId parent(int level) const noexcept;
+
+		/// Parent, one level up; the cell must not be a face
+		inline CellId parent() const noexcept { return parent(level() - 1); }
+
+		/// Child k (0 to 3); the cell must be above max_level
+		CellId child(int k) const noexcept;
+
+		/// Corner k (0 to 3, counterclockwise seen from outside) as a unit
+		/// vector
+		E3 vertex(int k) const noexcept;
+
+		/// Center of the face square of the cell, as a unit vector
+		E3 center() const noexcept;
+
+		/// Cap around center() holding the cell
+		Cap cap() const noexcept;
+	};
+
+	/// Set of cells, sorted, with no cell holding another and no four
+	/// siblings in place of their parent. Lookups are binary searches.
+	class CellUnion
+	{
+		std::vector<CellId> ids;
+
+	public:
+		CellUnion() = default;
+
+		/// Normalizes the cells: sorts them, drops the ones inside others and
+		/// replaces complete sibling sets by their parent
+		explicit CellUnion(std::vector<CellId> cells);
+
+		inline size_t size() const noexcept { return ids.size(); }
+
+		inline bool empty() const noexcept { return ids.empty(); }
+
+		inline CellId operator[](size_t i) const noexcept { return ids[i]; }
+
+		inline std::span<const CellId> cells() const noexcept { return ids; }
+
+		inline auto begin() const noexcept { return ids.begin(); }
+
+		inline auto end() const noexcept { return ids.end(); }
+
+		/// True if some cell holds the given one
+		bool contains(CellId cell) const noexcept;
+
+		/// True if some cell holds the direction p
+		inline bool contains(const E3& p) const noexcept { return contains(CellId::from_point(p)); }
+
+		/// True if some cell holds or lies in the given one
+		bool intersects(CellId cell) const noexcept;
+
+		/// True if the unions share a leaf
+		bool intersects(const CellUnion& other) const noexcept;
+
+		/// Leaves of all the cells, counted at the given level (at least the
+		/// level of every cell)
+		uint64_t leaf_count(int level = CellId::max_level) const noexcept;
+	};
+
+	/// Bounds of a covering: no cell above min_level or below max_level,
+	/// and at most max_cells cells unless min_level asks for more
+	struct CoveringOptions
+	{
+		int min_level = 0;
+		int max_level = CellId::max_level;
+		size_t max_cells = 8;
+	};
+
+	/// Cells covering the region (read as RegionIndex reads it), as few and
+	/// as fine as the options allow. Candidates start from the faces and are
+	/// taken coarsest first: a cell inside the region is kept, one meeting
+	/// its boundary is split into the children that meet the region while
+	/// the cell budget allows, and kept whole otherwise. Cells are classified
+	/// exactly: edge crossings through an EdgeBVH over the rings, region
+	/// vertices inside the cell through a PointIndex, and corner containment
+	/// through a RegionIndex.
+	CellUnion covering(const Compound<GP<>>& region, const CoveringOptions& options = CoveringOptions{});
+
+	/// Cells inside the region, as large and as many as the options allow:
+	/// cells meeting the boundary are split down to max_level and dropped
+	/// there
+	CellUnion interior_covering(const Compound<GP<>>& region, const CoveringOptions& options = CoveringOptions{});
+
+	/// Covering of one geodesic polygon, read as a spherical polygon
+	template <size_t N>
+	inline CellUnion covering(const GP<N>& poly, const CoveringOptions& options = CoveringOptions{})
+	{
+		Compound<GP<>> region;
+		region.polygons.emplace_back().boundary.vertices.assign(poly.boundary.vertices.begin(), poly.boundary.vertices.end());
+		return covering(region, options);
+	}
+
+	/// Interior covering of one geodesic polygon
+	template <size_t N>
+	inline CellUnion interior_covering(const GP<N>& poly, const CoveringOptions& options = CoveringOptions{})
+	{
+		Compound<GP<>> region;
+		region.polygons.emplace_back().boundary.vertices.assign(poly.boundary.vertices.begin(), poly.boundary.vertices.end());
+		return interior_covering(region, options);
+	}
+}
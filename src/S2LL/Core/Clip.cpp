@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <S2LL/Core/Clip.hpp>
+#include <S2LL/Core/Containment.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Angular padding of the inscribed cap
+		constexpr double cap_padding = 1e-10;
+
+		constexpr double half_pi = 0.5 * std::numbers::pi;
+
+		inline E3 direction(double lat, double lon) noexcept
+		{
+			return E3{ std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat) };
+		}
+
+		/// Counterclockwise ring on the circle at angle r (at most pi / 2)
+		/// from the unit axis, with as few vertices as keep the chords within
+		/// the tolerance of the circle: a chord spanning 2h around the axis
+		/// comes closest at its midpoint, at the angle atan(tan r cos h)
+		GP<> circle(const E3& axis, double r, double tolerance)
+		{
+			size_t n = 4;
+			if (r < half_pi && r > tolerance)
+			{
+				const double h = std::acos(std::tan(r - tolerance) / std::tan(r));
+				n = std::max<size_t>(3, static_cast<size_t>(std::ceil(std::numbers::pi / h)));
+			}
+			else if (r < half_pi)
+			{
+				n = 3;
+			}
+			const E3 ref = std::abs(axis.z) < 0.9 ? E3{ 0.0, 0.0, 1.0 } : E3{ 1.0, 0.0, 0.0 };
+			const E3 u = unit(plain_cross(axis, ref));
+			const E3 w = plain_cross(axis, u);
+			const double c = std::cos(r), s = std::sin(r);
+			GP<> ring;
+			ring.boundary.vertices.reserve(n);
+			for (size_t k = 0; k < n; ++k)
+			{
+				const double t = 2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n);
+				const double ct = std::cos(t), st = std::sin(t);
+				ring.boundary.vertices.push_back(E3{
+					axis.x * c + (u.x * ct + w.x * st) * s,
+					axis.y * c + (u.y * ct + w.y * st) * s,
+					axis.z * c + (u.z * ct + w.z * st) * s });
+			}
+			return ring;
+		}
+
+		/// Steps along the parallel at latitude lat across a longitude width:
+		/// a chord spanning 2h of longitude bulges poleward to the latitude
+		/// atan(tan lat / cos h); no step spans more than a quarter turn, so
+		/// chords are minor arcs
+		size_t parallel_steps(double lat, double width, double tolerance)
+		{
+			double h = 0.25 * std::numbers::pi;
+			const double a = std::abs(lat);
+			if (a > 0.0 && a + tolerance < half_pi)
+			{
+				h = std::min(h, std::acos(std::tan(a) / std::tan(a + tolerance)));
+			}
+			return std::max<size_t>(1, static_cast<size_t>(std::ceil(0.5 * width / h)));
+		}
+
+		/// Bounding cap of a region from the vertices of all its rings, full
+		/// unless they fit in a cap smaller than a hemisphere. The smaller
+		/// side of every ring then lies in the convex hull of its vertices,
+		/// inside the cap.
+		Cap bounding_cap(const Compound<GP<>>& region)
+		{
+			E3 sum{ 0.0, 0.0, 0.0 };
+			for (const GP<>& poly : region.polygons)
+			{
+				for (const E3& v : poly.boundary.vertices)
+				{
+					const E3 u = unit(v);
+					sum = E3{ sum.x + u.x, sum.y + u.y, sum.z + u.z };
+				}
+			}
+			if (!(plain_dot(sum, sum) > 0.0))
+			{
+				return Cap::full();
+			}
+			const E3 axis = unit(sum);
+			double cos_radius = 1.0;
+			for (const GP<>& poly : region.polygons)
+			{
+				for (const E3& v : poly.boundary.vertices)
+				{
+					cos_radius = std::min(cos_radius, plain_dot(axis, unit(v)));
+				}
+			}
+			const Cap cap = padded_cap(axis, cos_radius);
+			return cap.cos_radius > 0.0 ? cap : Cap::full();
+		}
+	}
+
+	ClipWindow::ClipWindow(const Cap& cap, double tolerance)
+	{
+		assert(tolerance > 0.0);
+		if (cap.is_full())
+		{
+			complement = true;
+			return;
+		}
+		if (cap.cos_radius >= 1.0)
+		{
+			return;
+		}
+		// A cap beyond a hemisphere is the sphere minus the cap around the
+		// antipode, which a ring bounds on its smaller side
+		const E3 axis = unit(cap.axis);
+		const double r = cap.radius();
+		if (r > half_pi)
+		{
+			complement = true;
+			shape.polygons.push_back(circle(E3{ -axis.x, -axis.y, -axis.z }, std::numbers::pi - r, tolerance));
+		}
+		else
+		{
+			shape.polygons.push_back(circle(axis, r, tolerance));
+		}
+		bound();
+	}
+
+	ClipWindow::ClipWindow(const LLRect& rect, double tolerance)
+	{
+		assert(tolerance > 0.0);
+		const double lat_lo = std::max(rect.lo.lat, -half_pi), lat_hi = std::min(rect.hi.lat, half_pi);
+		if (lat_lo >= lat_hi)
+		{
+			return;
+		}
+		double width = std::remainder(rect.hi.lon - rect.lo.lon, 2.0 * std::numbers::pi);
+		if (width <= 0.0)
+		{
+			width += 2.0 * std::numbers::pi;
+		}
+
+		if (width >= 2.0 * std::numbers::pi)
+		{
+			// A band between two parallels: the caps beyond them around the
+			// poles, or the difference of two caps around one pole
+			const E3 north{ 0.0, 0.0, 1.0 }, south{ 0.0, 0.0, -1.0 };
+			if (lat_lo >= 0.0)
+			{
+				shape.polygons.push_back(circle(north, half_pi - lat_lo, tolerance));
+				if (lat_hi < half_pi)
+				{
+					shape.polygons.push_back(circle(north, half_pi - lat_hi, tolerance));
+				}
+			}
+			else if (lat_hi <= 0.0)
+			{
+				shape.polygons.push_back(circle(south, half_pi + lat_hi, tolerance));
+				if (lat_lo > -half_pi)
+				{
+					shape.polygons.push_back(circle(south, half_pi + lat_lo, tolerance));
+				}
+			}
+			else
+			{
+				complement = true;
+				if (lat_hi < half_pi)
+				{
+					shape.polygons.push_back(circle(north, half_pi - lat_hi, tolerance));
+				}
+				if (lat_lo > -half_pi)
+				{
+					shape.polygons.push_back(circle(south, half_pi + lat_lo, tolerance));
+				}
+			}
+			bound();
+			return;
+		}
+
+		// One counterclockwise ring: east along the southern parallel, north
+		// along the eastern meridian, west along the northern parallel and
+		// south along the western meridian; a side on a pole is one vertex
+		const double lon_lo = rect.lo.lon, lon_hi = lon_lo + width;
+		const size_t meridian_steps = std::max<size_t>(1, static_cast<size_t>(std::ceil((lat_hi - lat_lo) / (0.5 * half_pi))));
+		std::vector<E3>& v = shape.polygons.emplace_back().boundary.vertices;
+		const auto parallel = [&](double lat, double from, double to) {
+			if (std::abs(lat) >= half_pi)
+			{
+				v.push_back(E3{ 0.0, 0.0, lat > 0.0 ? 1.0 : -1.0 });
+				return;
+			}
+			const size_t k = parallel_steps(lat, width, tolerance);
+			for (size_t j = 0; j <= k; ++j)
+			{
+				v.push_back(direction(lat, from + (to - from) * static_cast<double>(j) / static_cast<double>(k)));
+			}
+		};
+		const auto meridian = [&](double lon, double from, double to) {
+			for (size_t j = 1; j < meridian_steps; ++j)
+			{
+				v.push_back(direction(from + (to - from) * static_cast<double>(j) / static_cast<double>(meridian_steps), lon));
+			}
+		};
+		parallel(lat_lo, lon_lo, lon_hi);
+		meridian(lon_hi, lat_lo, lat_hi);
+		parallel(lat_hi, lon_hi, lon_lo);
+		meridian(lon_lo, lat_hi, lat_lo);
+		bound();
+	}
+
+	void ClipWindow::bound()
+	{
+		outer = bounding_cap(shape);
+		if (outer.is_full() || shape.polygons.size() != 1)
+		{
+			return;
+		}
+		// The largest cap around the center of the vertices that the ring
+		// encloses, if it encloses the center
+		const GP<>& ring = shape.polygons[0];
+		center = outer.axis;
+		if (!contains(ring, center))
+		{
+			return;
+		}
+		double r = std::numbers::pi;
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			r = std::min(r, arc_distance(center, unit(ring[i]), unit(ring[i + 1])));
+		}
+		inner_radius = r - cap_padding;
+	}
+
+	Compound<GP<>> ClipWindow::clip(const Compound<GP<>>& region) const
+	{
+		if (region.polygons.empty())
+		{
+			return {};
+		}
+		if (shape.polygons.empty())
+		{
+			return complement ? region : Compound<GP<>>{};
+		}
+		const Cap cap = bounding_cap(region);
+		if (!cap.is_full())
+		{
+			const double r = cap.radius();
+			if (!outer.is_full() && angle(cap.axis, outer.axis) > r + outer.radius())
+			{
+				return complement ? region : Compound<GP<>>{};
+			}
+			if (angle(cap.axis, center) + r <= inner_radius)
+			{
+				return complement ? Compound<GP<>>{} : region;
+			}
+		}
+		return overlay(region, shape, complement ? BooleanOp::Difference : BooleanOp::Intersection);
+	}
+}
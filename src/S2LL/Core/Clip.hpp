@@ -0,0 +1,118 @@
+#pragma once
+
+#include <S2LL/Core/Overlay.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace S2LL
+{
+	/// Latitude/longitude rectangle from its south-west corner lo to its
+	/// north-east corner hi (radians). Longitudes run east from lo.lon to
+	/// hi.lon, across the antimeridian when hi.lon < lo.lon; equal longitudes
+	/// take every longitude.
+	struct LLRect
+	{
+		LL lo, hi;
+	};
+
+	/// Clip window: a cap or a latitude/longitude rectangle, turned into
+	/// rings of great-circle arcs that follow its small-circle sides within
+	/// a tolerance. Clipping a Compound region intersects it with the window
+	/// through overlay() (subtracts the rest of the sphere, for windows larger
+	/// than a hemisphere), after a test of the bounding cap of the region
+	/// against caps bounding and inscribed in the window: regions outside the
+	/// window come back empty and regions inside it unchanged, with no edge
+	/// work. Window vertices lie on the window boundary; chords between them
+	/// stray from it by at most the tolerance.
+	class ClipWindow
+	{
+		// Rings of the window, or of the rest of the sphere when complement
+		// is set; no rings: the empty window, or the full one with complement
+		Compound<GP<>> shape;
+		bool complement = false;
+
+		// Caps bounding the shape and inscribed in it (a negative radius
+		// when there is none), padded outwards and inwards
+		Cap outer = Cap::full();
+		E3 center{ 0.0, 0.0, 1.0 };
+		double inner_radius = -1.0;
+
+		void bound();
+
+	public:
+		/// Window of the directions in the cap; tolerance is an angle in
+		/// radians and must be positive
+		ClipWindow(const Cap& cap, double tolerance);
+
+		/// Window of the directions in the rectangle; its parallels are
+		/// followed within the tolerance, its meridians exactly
+		ClipWindow(const LLRect& rect, double tolerance);
+
+		/// Rings of the window (of its complement for windows larger than a
+		/// hemisphere), read as a Compound region
+		inline const Compound<GP<>>& rings() const noexcept { return shape; }
+
+		/// True if rings() bounds the rest of the sphere
+		inline bool is_complement() const noexcept { return complement; }
+
+		/// Part of the region inside the window, as overlay() writes it;
+		/// regions inside the window are returned unchanged
+		Compound<GP<>> clip(const Compound<GP<>>& region) const;
+	};
+
+	/// Part of the region inside the window
+	inline Compound<GP<>> clip(const Compound<GP<>>& region, const ClipWindow& window)
+	{
+		return window.clip(region);
+	}
+
+	/// Nonempty clipped region of a stream, with the position of its source
+	/// region in the stream
+	struct ClippedRegion
+	{
+		size_t index;
+		Compound<GP<>> region;
+	};
+
+	/// Clips a stream of regions, read once from first to last, and writes
+	/// every nonempty result to out as soon as it is known, in input order.
+	/// With threads = 1 regions are clipped one at a time; otherwise batches
+	/// of 16 per thread (0: one thread per hardware thread) are read and
+	/// clipped in parallel. Memory holds one batch besides the output.
+	template <std::input_iterator In, std::sentinel_for<In> End, std::output_iterator<ClippedRegion> Out>
+	Out clip(In first, End last, const ClipWindow& window, Out out, unsigned threads = 1)
+	{
+		const size_t batch = threads == 1 ? 1 : 16 * static_cast<size_t>(threads == 0 ? default_threads() : threads);
+		std::vector<Compound<GP<>>> input, output;
+		size_t index = 0;
+		while (first != last)
+		{
+			input.clear();
+			for (; first != last && input.size() < batch; ++first)
+			{
+				input.push_back(*first);
+			}
+			output.resize(input.size());
+			parallel_for(input.size(), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					output[i] = window.clip(input[i]);
+				}
+			}, threads, 1);
+			for (size_t i = 0; i < input.size(); ++i)
+			{
+				if (!output[i].polygons.empty())
+				{
+					*out++ = ClippedRegion{ index + i, std::move(output[i]) };
+				}
+			}
+			index += input.size();
+		}
+		return out;
+	}
+}
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <S2LL/Core/Containment.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Relative error bound of a dot product against a vector whose
+		/// components carry one rounding each (computed cross products)
+		constexpr double dot_error = 6.0 * DBL_EPSILON;
+
+		inline signed char filtered_sign(double d, double bound) noexcept
+		{
+			return static_cast<signed char>((d > bound) - (d < -bound));
+		}
+	}
+
+	// Generic point, away from the axes and the coordinate planes
+	const E3 PreparedPolygon::origin = E3{ -0.0099994664350250197, 0.0025924542609324121, 0.99994664350250195 }.normalized();
+
+	PreparedPolygon::PreparedPolygon(LoopView<E3> loop)
+		: vertices(loop.begin(), loop.end())
+	{
+		prepare();
+	}
+
+	void PreparedPolygon::prepare()
+	{
+		const size_t n = vertices.size();
+		vx.resize(n);
+		vy.resize(n);
+		vz.resize(n);
+		nx.resize(n);
+		ny.resize(n);
+		nz.resize(n);
+		side.resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			const E3& a = vertices[i];
+			const E3& b = vertices[(i + 1) % n];
+			const E3 normal = a.cross(b);
+			vx[i] = a.x;
+			vy[i] = a.y;
+			vz[i] = a.z;
+			nx[i] = normal.x;
+			ny[i] = normal.y;
+			nz[i] = normal.z;
+			side[i] = static_cast<signed char>(orient(a, b, origin));
+		}
+		if (n < 3)
+		{
+			return;
+		}
+
+		// Vertex 1 is inside iff the reference direction around it falls
+		// between the outgoing and incoming edges; the crossing parity from
+		// the reference point to vertex 1 then settles the reference point
+		const bool v1_inside = ordered_ccw(ref_dir(vertices[1]), vertices[0], vertices[2], vertices[1]);
+		origin_inside = v1_inside != crossings_exact(vertices[1]);
+
+		// A cap around the vertices bounds the region when it is smaller than
+		// a hemisphere and leaves out the antipode of its center
+		E3 sum{ 0.0, 0.0, 0.0 };
+		for (const E3& v : vertices)
+		{
+			sum = sum + v.normalized();
+		}
+		if (!(sum.mag() > 0.0))
+		{
+			return;
+		}
+		const E3 center = sum.normalized();
+		double cos_radius = 1.0;
+		for (const E3& v : vertices)
+		{
+			cos_radius = std::min(cos_radius, plain_dot(center, unit(v)));
+		}
+		const Cap cap = padded_cap(center, cos_radius);
+		const E3 antipode{ -center.x, -center.y, -center.z };
+		if (cap.cos_radius > 0.0 && !contains(antipode))
+		{
+			bound = cap;
+		}
+	}
+
+	bool PreparedPolygon::crossings_exact(const E3& q) const noexcept
+	{
+		const size_t n = vertices.size();
+		bool parity = false;
+		for (size_t i = 0; i < n; ++i)
+		{
+			parity ^= edge_or_vertex_crossing(origin, q, vertices[i], vertices[(i + 1) % n]);
+		}
+		return parity;
+	}
+
+	bool PreparedPolygon::crossings(const E3& q, signed char* vs, signed char* es) const noexcept
+	{
+		const size_t n = vertices.size();
+		const E3 m = origin.cross(q);
+
+		// Sides of the vertices relative to the plane of the query arc, and
+		// of the query relative to the edge planes. Plain loops over the
+		// component arrays, so the compiler vectorizes them.
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double px = m.x * vx[i], py = m.y * vy[i], pz = m.z * vz[i];
+			vs[i] = filtered_sign(px + py + pz, dot_error * (std::abs(px) + std::abs(py) + std::abs(pz)));
+		}
+		vs[n] = vs[0];
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double px = nx[i] * q.x, py = ny[i] * q.y, pz = nz[i] * q.z;
+			es[i] = filtered_sign(px + py + pz, dot_error * (std::abs(px) + std::abs(py) + std::abs(pz)));
+		}
+
+		// The arc from the reference point to q crosses edge i iff
+		// -orient(o, q, a) == orient(o, q, b) == -orient(a, b, q) == orient(a, b, o)
+		bool parity = false;
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (vs[i] == 0 || vs[i + 1] == 0 || es[i] == 0)
+			{
+				parity ^= edge_or_vertex_crossing(origin, q, vertices[i], vertices[(i + 1) % n]);
+				continue;
+			}
+			const signed char u = side[i];
+			parity ^= (vs[i] == -u) & (vs[i + 1] == u) & (es[i] == -u);
+		}
+		return parity;
+	}
+
+	bool PreparedPolygon::contains_preimage(const E3& q, signed char* vs, signed char* es) const noexcept
+	{
+		if (vertices.size() < 3)
+		{
+			return false;
+		}
+		if (!bound.contains(q))
+		{
+			return false;
+		}
+		return origin_inside != crossings(q, vs, es);
+	}
+
+	bool PreparedPolygon::contains(const E3& p) const
+	{
+		std::vector<signed char> vs(vertices.size() + 1), es(vertices.size());
+		return contains_preimage(sheared ? transform.inverse(p) : p, vs.data(), es.data());
+	}
+
+	bool PreparedPolygon::contains(const E3& p, Scratch& scratch) const
+	{
+		if (scratch.vs.size() <= vertices.size())
+		{
+			scratch.vs.resize(vertices.size() + 1);
+			scratch.es.resize(vertices.size());
+		}
+		return contains_preimage(sheared ? transform.inverse(p) : p, scratch.vs.data(), scratch.es.data());
+	}
+
+	size_t PreparedPolygon::memory_usage() const noexcept
+	{
+		const size_t doubles = vx.capacity() + vy.capacity() + vz.capacity()
+			+ nx.capacity() + ny.capacity() + nz.capacity();
+		return doubles * sizeof(double) + vertices.capacity() * sizeof(E3) + side.capacity();
+	}
+
+	void PreparedPolygon::contains(std::span<const E3> points, std::span<bool> out) const
+	{
+		assert(points.size() == out.size());
+		std::vector<signed char> vs(vertices.size() + 1), es(vertices.size());
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			const E3& p = points[i];
+			out[i] = contains_preimage(sheared ? transform.inverse(p) : p, vs.data(), es.data());
+		}
+	}
+}
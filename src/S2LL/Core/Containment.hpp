@@ -0,0 +1,121 @@
+#pragma once
+
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Point-in-spherical-polygon (PiSP) engine. The boundary is a loop of
+	/// great-circle arcs through the vertex directions; the interior lies to
+	/// the left of every edge, i.e. the loop runs counterclockwise around it
+	/// seen from outside the surface. A great elliptic polygon is its
+	/// pre-image on the base sphere: queries are pulled back through the
+	/// inverse transformation, which preserves containment.
+	///
+	/// Preparation caches the edge normals, a bounding cap and whether a fixed
+	/// reference point is inside. A query then counts the crossings of the arc
+	/// from that point to the query with the boundary; the per-edge signs are
+	/// evaluated in floating point over contiguous arrays, with error bounds
+	/// routing the rare uncertain edges to the exact predicates. The result is
+	/// exact: every point is classified as if by exact arithmetic, and points
+	/// on the boundary are assigned to exactly one of two polygons sharing it
+	/// (semi-open boundary model).
+	class PreparedPolygon
+	{
+		// Vertex and edge-normal coordinates, one array per component
+		std::vector<double> vx, vy, vz;
+		std::vector<double> nx, ny, nz;
+		std::vector<E3> vertices;
+		// Side of each edge plane on which the reference point lies (+1 / -1)
+		std::vector<signed char> side;
+		bool origin_inside = false;
+
+		// Bounding cap with a padded radius; the full cap disables the test
+		Cap bound = Cap::full();
+
+		// Pre-image mapping of great elliptic polygons
+		LinearTransformation transform;
+		bool sheared = false;
+
+		void prepare();
+
+		/// Parity of the boundary crossings from the reference point to q,
+		/// with scratch space for the per-vertex and per-edge signs
+		bool crossings(const E3& q, signed char* vs, signed char* es) const noexcept;
+
+		/// Exact crossing count without the floating-point filter
+		bool crossings_exact(const E3& q) const noexcept;
+
+		bool contains_preimage(const E3& q, signed char* vs, signed char* es) const noexcept;
+
+	public:
+		/// Fixed reference point of the crossing counts
+		static const E3 origin;
+
+		/// Per-query sign buffers. Reusing one across queries (one per thread)
+		/// avoids an allocation per point.
+		struct Scratch
+		{
+			std::vector<signed char> vs, es;
+		};
+
+		/// Prepares the loop of great-circle arcs through the given vertices
+		explicit PreparedPolygon(LoopView<E3> loop);
+
+		/// Prepares a geodesic polygon as a spherical polygon
+		template <size_t N>
+		explicit PreparedPolygon(const GP<N>& poly)
+			: PreparedPolygon(LoopView<E3>(poly.boundary))
+		{
+		}
+
+		/// Prepares a great elliptic polygon whose base sphere is sheared by T;
+		/// queries are world-space points
+		template <size_t N>
+		explicit PreparedPolygon(const GEP<N>& poly, const LinearTransformation& T = LinearTransformation{})
+			: PreparedPolygon(LoopView<E3>(poly.boundary))
+		{
+			transform = T;
+			sheared = !T.is_identity();
+		}
+
+		/// Number of vertices
+		inline size_t size() const noexcept { return vertices.size(); }
+
+		/// Bounding cap of the pre-image region, full unless the region fits in
+		/// a cap smaller than a hemisphere
+		inline const Cap& cap() const noexcept { return bound; }
+
+		/// Heap bytes held by the prepared arrays
+		size_t memory_usage() const noexcept;
+
+		/// True if the point (a direction; world space for GEP) is inside
+		bool contains(const E3& p) const;
+
+		/// As contains(p), with caller-provided sign buffers
+		bool contains(const E3& p, Scratch& scratch) const;
+
+		/// Batch containment: out[i] tells whether points[i] is inside. The
+		/// spans must have the same length.
+		void contains(std::span<const E3> points, std::span<bool> out) const;
+	};
+
+	/// True if the direction p is inside the spherical polygon
+	template <size_t N>
+	inline bool contains(const GP<N>& poly, const E3& p)
+	{
+		return PreparedPolygon(poly).contains(p);
+	}
+
+	/// True if the world point p is inside the great elliptic polygon whose
+	/// base sphere is sheared by T
+	template <size_t N>
+	inline bool contains(const GEP<N>& poly, const E3& p, const LinearTransformation& T = LinearTransformation{})
+	{
+		return PreparedPolygon(poly, T).contains(p);
+	}
+}
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cassert>
 #include <cfenv>
+#include <cmath>
 #include <limits>
 #include <numbers>
 #include <ostream>
+#include <span>
+#include <type_traits>
 #include <S2LL/Core/Curves.hpp>
 #include <S2LL/Core/Numerics.hpp>
 #include <S2LL/Core/Utilities.hpp>
@@ -16,6 +20,7 @@ namespace S2LL
 	struct E3;
 	struct S2;
 	struct LL;
+	struct LLH;
 
 	// Plain-old-data type for 2D Cartesian coordinates
 	struct E2
@@ -109,10 +114,17 @@ namespace S2LL
 			};
 		}
 
-		/// Converts (x, y, z) into spherical/geocentric coordinates
+		/// Converts (x, y, z) into spherical/geocentric coordinates. Accurate
+		/// evaluates both angles with Double Atan2. Fast uses one sqrt and
+		/// two std::atan2 calls and stays within 1e-15 rad of the true angles
+		/// while the squared components neither overflow nor underflow. The
+		/// zero vector maps to the north pole under both policies.
+		template <typename P = Precision::Accurate>
 		S2 s2() const noexcept;
 
-		/// Converts (x, y, z) into latitude-longitude coordinates
+		/// Converts (x, y, z) into latitude-longitude coordinates, with the
+		/// same precision policies and error bound as s2()
+		template <typename P = Precision::Accurate>
 		LL ll() const noexcept;
 
 		friend std::ostream& operator<<(std::ostream& ost, const E3& e3)
@@ -219,19 +231,67 @@ namespace S2LL
 		}
 	};
 
+	// Plain-old-data type for geodetic coordinates: latitude-longitude pair
+	// plus height above the reference surface, measured along its normal
+	struct LLH
+	{
+	public:
+		// Geodetic latitude, in radians
+		double lat;
+
+		// Longitude, in radians
+		double lon;
+
+		// Ellipsoidal height, in the unit of the reference surface
+		double h;
+
+		// Drops the height
+		constexpr LL ll() const noexcept
+		{
+			return LL{ lat, lon };
+		}
+
+		friend std::ostream& operator<<(std::ostream& ost, const LLH& llh)
+		{
+			ost << llh.lat << ' ' << llh.lon << ' ' << llh.h;
+			return ost;
+		}
+	};
+
+	template <typename P>
 	inline S2 E3::s2() const noexcept
 	{
-		Double p = Acos(Div(Lift(z), Mag()));
-		Double a = Atan2(Lift(y), Lift(x));
-		return S2 {
-			static_cast<double>(p),
-			static_cast<double>(a)
-		};
+		if constexpr (std::is_same_v<P, Precision::Fast>)
+		{
+			const double r = std::sqrt(x * x + y * y);
+			return S2{ std::atan2(r, z), std::atan2(y, x) };
+		}
+		else
+		{
+			static_assert(std::is_same_v<P, Precision::Accurate>, "unknown precision policy");
+			// atan2(horizontal radius, z) stays well conditioned at the poles,
+			// where acos(z / |p|) loses up to half of the significand
+			Double p = Atan2(Sqrt(Sq(x) + Sq(y)), Lift(z));
+			Double a = Atan2(Lift(y), Lift(x));
+			return S2 {
+				static_cast<double>(p),
+				static_cast<double>(a)
+			};
+		}
 	}
 
+	template <typename P>
 	inline LL E3::ll() const noexcept
 	{
-		return s2().ll();
+		if constexpr (std::is_same_v<P, Precision::Fast>)
+		{
+			const double r = std::sqrt(x * x + y * y);
+			return LL{ std::atan2(z, r), std::atan2(y, x) };
+		}
+		else
+		{
+			return s2<P>().ll();
+		}
 	}
 
 	inline LL S2::ll() const noexcept
@@ -255,10 +315,35 @@ namespace S2LL
 		};
 	}
 
+	/// Converts a span of E3 into S2 coordinates under the given precision
+	/// policy (see E3::s2); `out` must be as long as `in`
+	template <typename P = Precision::Accurate>
+	inline void to_S2(std::span<const E3> in, std::span<S2> out) noexcept
+	{
+		assert(in.size() == out.size());
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = in[i].s2<P>();
+		}
+	}
+
+	/// Converts a span of E3 into LL coordinates under the given precision
+	/// policy (see E3::ll); `out` must be as long as `in`
+	template <typename P = Precision::Accurate>
+	inline void to_LL(std::span<const E3> in, std::span<LL> out) noexcept
+	{
+		assert(in.size() == out.size());
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = in[i].ll<P>();
+		}
+	}
+
 	// Compile-time layout & copyability verification
 	S2LL_ASSERT_POD(E2);
 	S2LL_ASSERT_POD(E3);
 	S2LL_ASSERT_POD(S2);
 	S2LL_ASSERT_POD(LL);
+	S2LL_ASSERT_POD(LLH);
 	S2LL_ASSERT_POD(E3::Loop<4>);
 }
@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <S2LL/Core/Delaunay.hpp>
+#include <S2LL/Core/Horizon.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		constexpr uint32_t none = Delaunay::none;
+
+		/// Size of the first, unsorted round of the insertion order
+		constexpr size_t min_round = 64;
+
+		/// Fixed seed of the insertion order, so results are reproducible
+		constexpr unsigned brio_seed = 0x5EED;
+
+		/// Triangle of the hull under construction, with the triangles
+		/// across its edges: edge i runs from v[i] to v[i + 1]
+		struct Tri
+		{
+			std::array<uint32_t, 3> v;
+			std::array<uint32_t, 3> adj;
+		};
+
+		/// Incremental convex hull of unit vectors, replacing the triangles
+		/// seen from every new point by a cone around it
+		class Hull
+		{
+			const std::vector<E3>& u;
+			std::vector<Tri> tris;
+			std::vector<uint32_t> stamps;
+			// Triangles facing the origin, which are not Delaunay triangles
+			std::vector<bool> ghost;
+			std::vector<uint32_t> free;
+			std::vector<uint32_t> cone_from;
+			std::vector<uint32_t> cavity, stack, cone;
+			std::vector<Horizon> horizon;
+			uint32_t round = 0;
+			uint32_t last = 0;
+
+			bool sees(uint32_t t, uint32_t p) const noexcept
+			{
+				const Tri& f = tris[t];
+				return orient3d(u[f.v[0]], u[f.v[1]], u[f.v[2]], u[p]) > 0;
+			}
+
+			/// A triangle seen from p: the walk crosses edges that have p on
+			/// their right, starting from the last cone; a full scan backs it
+			/// up where the hull is not star-shaped from the origin
+			uint32_t locate(uint32_t p)
+			{
+				uint32_t t = last, from = none;
+				const size_t limit = 64 + 4 * static_cast<size_t>(std::sqrt(static_cast<double>(tris.size())));
+				for (size_t step = 0; step < limit; ++step)
+				{
+					const Tri& f = tris[t];
+					if (ghost[t] && sees(t, p))
+					{
+						// Beyond the boundary of sites within a hemisphere
+						return t;
+					}
+					uint32_t exit = none;
+					for (int k = 0; k < 3 && exit == none; ++k)
+					{
+						const int e = static_cast<int>((step + k) % 3);
+						if (f.adj[e] != from && orient(u[f.v[e]], u[f.v[(e + 1) % 3]], u[p]) < 0)
+						{
+							exit = f.adj[e];
+						}
+					}
+					if (exit == none)
+					{
+						break;
+					}
+					from = t;
+					t = exit;
+				}
+				if (sees(t, p))
+				{
+					return t;
+				}
+				for (uint32_t s = 0; s < tris.size(); ++s)
+				{
+					if (stamps[s] != dead && sees(s, p))
+					{
+						return s;
+					}
+				}
+				return none;
+			}
+
+			bool facing_origin(const Tri& f) const noexcept
+			{
+				return orient(u[f.v[0]], u[f.v[1]], u[f.v[2]]) <= 0;
+			}
+
+			uint32_t make(const Tri& f)
+			{
+				if (!free.empty())
+				{
+					const uint32_t t = free.back();
+					free.pop_back();
+					tris[t] = f;
+					stamps[t] = 0;
+					ghost[t] = facing_origin(f);
+					return t;
+				}
+				tris.push_back(f);
+				stamps.push_back(0);
+				ghost.push_back(facing_origin(f));
+				return static_cast<uint32_t>(tris.size() - 1);
+			}
+
+		public:
+			static constexpr uint32_t dead = none;
+
+			Hull(const std::vector<E3>& unit_sites, std::array<uint32_t, 4> s)
+				: u(unit_sites), cone_from(unit_sites.size(), none)
+			{
+				if (orient3d(u[s[0]], u[s[1]], u[s[2]], u[s[3]]) > 0)
+				{
+					std::swap(s[1], s[2]);
+				}
+				tris = {
+					{ { s[0], s[1], s[2] }, { 1, 2, 3 } },
+					{ { s[0], s[3], s[1] }, { 3, 2, 0 } },
+					{ { s[1], s[3], s[2] }, { 1, 3, 0 } },
+					{ { s[2], s[3], s[0] }, { 2, 1, 0 } }
+				};
+				stamps.assign(4, 0);
+				for (const Tri& f : tris)
+				{
+					ghost.push_back(facing_origin(f));
+				}
+			}
+
+			/// Adds the point p; false if it sees no triangle (a duplicate
+			/// or, by rounding, inside the hull)
+			bool insert(uint32_t p)
+			{
+				const uint32_t start = locate(p);
+				if (start == none)
+				{
+					return false;
+				}
+
+				// Triangles seen from p, a connected patch around the start
+				++round;
+				if (round == dead)
+				{
+					round = 1;
+					for (uint32_t& s : stamps)
+					{
+						s = s == dead ? dead : 0;
+					}
+				}
+				visible_patch(tris, start, round, [&](uint32_t t) -> uint32_t& { return stamps[t]; },
+					[&](uint32_t t) { return sees(t, p); }, stack, cavity, horizon);
+				// The cone from p over the horizon
+				build_cone(tris, horizon, [&](const Horizon& h) {
+					return make({ { h.a, h.b, p }, { h.beyond, none, none } });
+				}, cone_from, cone);
+				// Freed only now, so cone triangles never take the slot of a
+				// triangle still named by the horizon
+				for (const uint32_t t : cavity)
+				{
+					stamps[t] = dead;
+					free.push_back(t);
+				}
+				last = cone.front();
+				return true;
+			}
+
+			/// Live triangles facing away from the origin, as half-edge arrays
+			Delaunay finish(size_t n) const
+			{
+				Delaunay d;
+				std::vector<uint32_t> index(tris.size(), none);
+				uint32_t count = 0;
+				for (uint32_t t = 0; t < tris.size(); ++t)
+				{
+					if (stamps[t] != dead && !ghost[t])
+					{
+						index[t] = count++;
+					}
+				}
+				d.triangles.resize(3 * static_cast<size_t>(count));
+				d.halfedges.assign(3 * static_cast<size_t>(count), none);
+				d.site_edges.assign(n, none);
+				for (uint32_t t = 0; t < tris.size(); ++t)
+				{
+					if (index[t] == none)
+					{
+						continue;
+					}
+					const Tri& f = tris[t];
+					for (int e = 0; e < 3; ++e)
+					{
+						const uint32_t h = 3 * index[t] + e;
+						d.triangles[h] = f.v[e];
+						const uint32_t g = f.adj[e];
+						if (index[g] != none)
+						{
+							const Tri& other = tris[g];
+							for (int k = 0; k < 3; ++k)
+							{
+								if (other.v[k] == f.v[(e + 1) % 3])
+								{
+									d.halfedges[h] = 3 * index[g] + k;
+								}
+							}
+						}
+					}
+				}
+				// Sites on the boundary start from their boundary half-edge,
+				// so the counterclockwise fan around them is complete
+				for (uint32_t h = 0; h < d.triangles.size(); ++h)
+				{
+					uint32_t& e = d.site_edges[d.triangles[h]];
+					if (e == none || d.halfedges[h] == none)
+					{
+						e = h;
+					}
+				}
+				return d;
+			}
+		};
+	}
+
+	Delaunay delaunay(std::span<const E3> sites)
+	{
+		const size_t n = sites.size();
+		std::vector<E3> u(n);
+		std::transform(sites.begin(), sites.end(), u.begin(), unit);
+
+		// Equal directions made adjacent by sorting, and kept once
+		std::vector<uint64_t> codes(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			codes[i] = (spread21(u[i].x) << 2) | (spread21(u[i].y) << 1) | spread21(u[i].z);
+		}
+		std::vector<uint32_t> order(n);
+		std::iota(order.begin(), order.end(), 0u);
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			if (codes[a] != codes[b]) return codes[a] < codes[b];
+			if (u[a].x != u[b].x) return u[a].x < u[b].x;
+			if (u[a].y != u[b].y) return u[a].y < u[b].y;
+			if (u[a].z != u[b].z) return u[a].z < u[b].z;
+			return a < b;
+		});
+		order.erase(std::unique(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			return same(u[a], u[b]);
+		}), order.end());
+		if (order.size() < 4)
+		{
+			return Delaunay{};
+		}
+
+		// Biased randomized insertion order: rounds of doubling size drawn at
+		// random, each in Morton order. The early rounds spread over the whole
+		// set, so the hull soon surrounds the origin and walks stay short.
+		std::shuffle(order.begin(), order.end(), std::mt19937(brio_seed));
+		for (size_t end = order.size(); end > min_round; end /= 2)
+		{
+			std::sort(order.begin() + end / 2, order.begin() + end, [&](uint32_t a, uint32_t b) {
+				return codes[a] < codes[b];
+			});
+		}
+
+		// The first three sites and the first one off their plane (three
+		// distinct unit vectors are never collinear)
+		size_t fourth = 3;
+		while (fourth < order.size() && orient3d(u[order[0]], u[order[1]], u[order[2]], u[order[fourth]]) == 0)
+		{
+			++fourth;
+		}
+		if (fourth == order.size())
+		{
+			return Delaunay{};
+		}
+		Hull hull(u, { order[0], order[1], order[2], order[fourth] });
+		for (size_t i = 3; i < order.size(); ++i)
+		{
+			if (i != fourth)
+			{
+				hull.insert(order[i]);
+			}
+		}
+		return hull.finish(n);
+	}
+
+	Voronoi voronoi(const Delaunay& d, std::span<const E3> sites, unsigned threads)
+	{
+		Voronoi v;
+		const size_t n = d.site_edges.size();
+		v.vertices.resize(d.size());
+		parallel_for(d.size(), [&](size_t begin, size_t end) {
+			for (size_t t = begin; t < end; ++t)
+			{
+				const E3 a = unit(sites[d.triangles[3 * t]]);
+				const E3 b = unit(sites[d.triangles[3 * t + 1]]);
+				const E3 c = unit(sites[d.triangles[3 * t + 2]]);
+				const E3 ab{ b.x - a.x, b.y - a.y, b.z - a.z };
+				const E3 ac{ c.x - a.x, c.y - a.y, c.z - a.z };
+				v.vertices[t] = unit(E3{ ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x });
+			}
+		}, threads, 4096);
+
+		// Walks counterclockwise around site s, calling f with every half-edge
+		// leaving it
+		const auto fan = [&](uint32_t s, auto&& f) {
+			const uint32_t first = d.site_edges[s];
+			if (first == none)
+			{
+				return;
+			}
+			uint32_t h = first;
+			do
+			{
+				f(h);
+				h = d.halfedges[Delaunay::prev(h)];
+			} while (h != none && h != first);
+		};
+
+		v.offsets.assign(n + 1, 0);
+		for (uint32_t s = 0; s < n; ++s)
+		{
+			uint32_t count = 0;
+			fan(s, [&](uint32_t) { ++count; });
+			v.offsets[s + 1] = v.offsets[s] + count;
+		}
+		v.cells.resize(v.offsets[n]);
+		parallel_for(n, [&](size_t begin, size_t end) {
+			for (size_t s = begin; s < end; ++s)
+			{
+				uint32_t k = v.offsets[s];
+				fan(static_cast<uint32_t>(s), [&](uint32_t h) { v.cells[k++] = h / 3; });
+			}
+		}, threads, 4096);
+		return v;
+	}
+
+	uint32_t nearest_site(const Delaunay& d, std::span<const E3> sites, const E3& p, uint32_t start)
+	{
+		uint32_t s = start;
+		double best = plain_dot(unit(sites[s]), p);
+		while (true)
+		{
+			uint32_t next = s;
+			const auto visit = [&](uint32_t t) {
+				const double c = plain_dot(unit(sites[t]), p);
+				if (c > best)
+				{
+					best = c;
+					next = t;
+				}
+			};
+			const uint32_t first = d.site_edges[s];
+			uint32_t h = first;
+			do
+			{
+				visit(d.triangles[Delaunay::next(h)]);
+				const uint32_t back = Delaunay::prev(h);
+				h = d.halfedges[back];
+				if (h == none)
+				{
+					// Open fan: the last neighbour closes the boundary
+					visit(d.triangles[back]);
+				}
+			} while (h != none && h != first);
+			if (next == s)
+			{
+				return s;
+			}
+			s = next;
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// References:
+// Bowyer, A. (1981). Computing Dirichlet tessellations. The Computer Journal, 24(2), 162-166. https://doi.org/10.1093/comjnl/24.2.162
+// Renka, R. J. (1997). Algorithm 772: STRIPACK: Delaunay triangulation and Voronoi diagram on the surface of a sphere. ACM Transactions on Mathematical Software, 23(3), 416-434. https://doi.org/10.1145/275323.275329
+// Amenta, N., Choi, S., & Rote, G. (2003). Incremental constructions con BRIO. Proceedings of the 19th Annual Symposium on Computational Geometry, 211-219. https://doi.org/10.1145/777792.777824
+
+#include <S2LL/Core/Coordinates.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Delaunay triangulation of sites on the sphere, as flat half-edge
+	/// arrays. Triangle t owns the half-edges 3t, 3t + 1 and 3t + 2, which
+	/// run counterclockwise seen from outside; half-edge h starts at site
+	/// triangles[h] and ends at the start of next(h).
+	struct Delaunay
+	{
+		static constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+		/// Site at the start of every half-edge
+		std::vector<uint32_t> triangles;
+
+		/// Opposite half-edge, or none along the boundary, which only sites
+		/// within a hemisphere have
+		std::vector<uint32_t> halfedges;
+
+		/// One half-edge leaving every site (the first counterclockwise on
+		/// the boundary), or none for sites left out: exact duplicates of
+		/// another site, and sites pushed inside the hull of the others by
+		/// rounding (closer than about 1e-8 rad to one)
+		std::vector<uint32_t> site_edges;
+
+		/// Number of triangles
+		size_t size() const noexcept { return triangles.size() / 3; }
+
+		/// Next half-edge counterclockwise in the same triangle
+		static constexpr uint32_t next(uint32_t h) noexcept { return h % 3 == 2 ? h - 2 : h + 1; }
+
+		/// Previous half-edge in the same triangle
+		static constexpr uint32_t prev(uint32_t h) noexcept { return h % 3 == 0 ? h + 2 : h - 1; }
+	};
+
+	/// Delaunay triangulation of the directions of the sites (which need
+	/// not be unit vectors): no site lies inside the circumcircle of a
+	/// triangle. Sites spread beyond a hemisphere cover the sphere; sites in
+	/// a hemisphere give a triangulation of their spherical convex hull.
+	/// Empty when all sites lie on one circle or are fewer than four.
+	///
+	/// Sites are inserted one by one in a biased randomized order (rounds of
+	/// doubling size, each in Morton order, with a fixed seed), so each is
+	/// located by a short walk from the triangles of the last one; the
+	/// triangles whose circumcircle holds it are replaced by a fan around it
+	/// (Bowyer-Watson). On unit vectors this builds the convex hull
+	/// in E3, and the circumcircle test is orient3d, exact. Cocircular sites
+	/// yield one of the valid triangulations. Clustered sites cost about as
+	/// much as spread ones, down to spacings of about 1e-7 rad; below that,
+	/// every site that rounding pushes inside the hull costs a scan of all
+	/// triangles.
+	Delaunay delaunay(std::span<const E3> sites);
+
+	/// Voronoi diagram of the sites, dual to their Delaunay triangulation
+	struct Voronoi
+	{
+		/// Circumcenter of every triangle: the unit vector equidistant from
+		/// its three sites
+		std::vector<E3> vertices;
+
+		/// Cell of site s: the vertices cells[offsets[s]] to
+		/// cells[offsets[s + 1] - 1], counterclockwise. Cells of sites on the
+		/// boundary of a triangulation within a hemisphere are open: they
+		/// extend past their first and last vertices.
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> cells;
+	};
+
+	/// Voronoi diagram from a Delaunay triangulation of the same sites;
+	/// vertices and cells are computed by up to `threads` threads (0: one
+	/// per hardware thread)
+	Voronoi voronoi(const Delaunay& d, std::span<const E3> sites, unsigned threads = 1);
+
+	/// Site nearest to the direction p, by a greedy walk along Delaunay
+	/// edges from the site `start`, which must be in the triangulation; a
+	/// start near p makes the walk short
+	uint32_t nearest_site(const Delaunay& d, std::span<const E3> sites, const E3& p, uint32_t start);
+}
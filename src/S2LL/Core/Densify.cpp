@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <S2LL/Core/Densify.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Steps of the edge from a to b: one, or as many as the stricter
+		/// bound asks for
+		size_t steps(const E3& a, const E3& b, const DensifyOptions& options,
+			const Ellipsoid& e, const LinearTransformation& T)
+		{
+			size_t count = 1;
+			if (options.max_angle > 0.0)
+			{
+				const double k = std::ceil(angle(unit(a), unit(b)) / options.max_angle);
+				count = std::max(count, static_cast<size_t>(k));
+			}
+			if (options.max_chord_error > 0.0)
+			{
+				const int k = EllipticArc{ a, b, e.major(), T }.segments(options.max_chord_error);
+				count = std::max(count, static_cast<size_t>(k));
+			}
+			return count;
+		}
+
+		/// Writes the ring, edge i split into steps_of(i) steps, to out;
+		/// inside an edge, successive points advance by a fixed rotation
+		template <typename Steps>
+		size_t write(LoopView<E3> ring, Steps&& steps_of, E3* out)
+		{
+			const size_t n = ring.size();
+			E3* const first = out;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const E3& a = ring[i];
+				*out++ = a;
+				const size_t k = steps_of(i);
+				if (k < 2)
+				{
+					continue;
+				}
+				const double r = std::sqrt(plain_dot(a, a));
+				const E3 u = unit(a);
+				const E3 v = unit(ring[i + 1 < n ? i + 1 : 0]);
+				const double d = plain_dot(u, v);
+				const E3 w = unit(E3{ v.x - d * u.x, v.y - d * u.y, v.z - d * u.z });
+				const double h = angle(u, v) / static_cast<double>(k);
+				const double ch = std::cos(h), sh = std::sin(h);
+				double c = 1.0, s = 0.0;
+				for (size_t j = 1; j < k; ++j)
+				{
+					const double cn = c * ch - s * sh;
+					s = s * ch + c * sh;
+					c = cn;
+					*out++ = E3{ r * (u.x * c + w.x * s), r * (u.y * c + w.y * s), r * (u.z * c + w.z * s) };
+				}
+			}
+			return static_cast<size_t>(out - first);
+		}
+	}
+
+	size_t densified_size(LoopView<E3> ring, const DensifyOptions& options,
+		const Ellipsoid& e, const LinearTransformation& T)
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			count += steps(ring[i], ring[i + 1 < ring.size() ? i + 1 : 0], options, e, T);
+		}
+		return count;
+	}
+
+	size_t densify(LoopView<E3> ring, std::span<E3> out, const DensifyOptions& options,
+		const Ellipsoid& e, const LinearTransformation& T)
+	{
+		assert(out.size() >= densified_size(ring, options, e, T));
+		return write(ring, [&](size_t i) {
+			return steps(ring[i], ring[i + 1 < ring.size() ? i + 1 : 0], options, e, T);
+		}, out.data());
+	}
+
+	FlatCompoundSet<E3> densify(std::span<const LoopView<E3>> rings, std::span<const size_t> part_offsets,
+		const DensifyOptions& options, unsigned threads, const Ellipsoid& e, const LinearTransformation& T)
+	{
+		assert(!part_offsets.empty() && part_offsets.front() == 0 && part_offsets.back() == rings.size());
+		const size_t count = rings.size();
+
+		// Step counts of every edge, kept for the writing pass, and the
+		// output size of every ring
+		std::vector<size_t> edge_offsets(count + 1, 0);
+		for (size_t r = 0; r < count; ++r)
+		{
+			edge_offsets[r + 1] = edge_offsets[r] + rings[r].size();
+		}
+		std::vector<size_t> edge_steps(edge_offsets[count]);
+		FlatCompoundSet<E3> out;
+		out.ring_offsets.assign(count + 1, 0);
+		out.part_offsets.assign(part_offsets.begin(), part_offsets.end());
+		parallel_for(count, [&](size_t begin, size_t end) {
+			for (size_t r = begin; r < end; ++r)
+			{
+				const LoopView<E3> ring = rings[r];
+				size_t total = 0;
+				for (size_t i = 0; i < ring.size(); ++i)
+				{
+					const size_t k = steps(ring[i], ring[i + 1 < ring.size() ? i + 1 : 0], options, e, T);
+					edge_steps[edge_offsets[r] + i] = k;
+					total += k;
+				}
+				out.ring_offsets[r + 1] = total;
+			}
+		}, threads, 16);
+		for (size_t r = 0; r < count; ++r)
+		{
+			out.ring_offsets[r + 1] += out.ring_offsets[r];
+		}
+
+		out.vertices.resize(out.ring_offsets[count]);
+		parallel_for(count, [&](size_t begin, size_t end) {
+			for (size_t r = begin; r < end; ++r)
+			{
+				const size_t* k = edge_steps.data() + edge_offsets[r];
+				write(rings[r], [k](size_t i) { return k[i]; }, out.vertices.data() + out.ring_offsets[r]);
+			}
+		}, threads, 16);
+		return out;
+	}
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Densification bounds; an edge takes the step count of the stricter
+	/// one, and 0 disables a bound
+	struct DensifyOptions
+	{
+		/// Largest central angle of a step (radians)
+		double max_angle = 0.0;
+
+		/// Largest distance between a step's chord and its arc on the surface
+		/// (world units, as EllipticArc::segments; radians on the unit sphere)
+		double max_chord_error = 0.0;
+	};
+
+	/// Number of points densify() writes for the ring: every edge counts its
+	/// steps, so an unchanged ring counts its vertices
+	size_t densified_size(LoopView<E3> ring, const DensifyOptions& options,
+		const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{});
+
+	/// Writes the ring with every edge split into even steps of its great
+	/// circle, as few as meet the bounds, to out, which must hold
+	/// densified_size() points; returns that count. Every edge contributes
+	/// its first vertex, unchanged, then the points inside it, which have
+	/// the length of that vertex. The densified ring bounds the same region,
+	/// read as a spherical or great elliptic polygon; chord errors are
+	/// measured on the sphere of radius e.major() sheared by T.
+	size_t densify(LoopView<E3> ring, std::span<E3> out, const DensifyOptions& options,
+		const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{});
+
+	/// Densified copy of the ring
+	inline std::vector<E3> densify(LoopView<E3> ring, const DensifyOptions& options,
+		const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{})
+	{
+		std::vector<E3> out(densified_size(ring, options, e, T));
+		densify(ring, std::span<E3>(out), options, e, T);
+		return out;
+	}
+
+	/// Densified copy of a geodesic polygon, read as a spherical polygon
+	/// (chord errors on the unit sphere)
+	template <size_t N>
+	inline GP<> densify(const GP<N>& poly, const DensifyOptions& options)
+	{
+		GP<> out;
+		out.boundary.vertices = densify(LoopView<E3>(poly.boundary), options);
+		return out;
+	}
+
+	/// Densified copy of a great elliptic polygon on the (sheared) surface
+	template <size_t N>
+	inline GEP<> densify(const GEP<N>& poly, const DensifyOptions& options,
+		const Ellipsoid& e, const LinearTransformation& T = LinearTransformation{})
+	{
+		GEP<> out;
+		out.boundary.vertices = densify(LoopView<E3>(poly.boundary), options, e, T);
+		return out;
+	}
+
+	/// Densifies rings grouped into parts as in FlatCompoundSet (part c holds
+	/// the rings part_offsets[c] to part_offsets[c + 1] - 1) into one flat
+	/// set. Step counts are found first, ring by ring in parallel, which
+	/// sizes the output exactly; the buffer is allocated once and every ring
+	/// is then written in place, again in parallel. Up to `threads` threads
+	/// (0: one per hardware thread) share the work.
+	FlatCompoundSet<E3> densify(std::span<const LoopView<E3>> rings, std::span<const size_t> part_offsets,
+		const DensifyOptions& options, unsigned threads = 1,
+		const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{});
+
+	/// Densified copy of every part of a flat compound set
+	inline FlatCompoundSet<E3> densify(const FlatCompoundSet<E3>& regions, const DensifyOptions& options,
+		unsigned threads = 1, const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{})
+	{
+		std::vector<LoopView<E3>> rings;
+		rings.reserve(regions.ring_count());
+		for (size_t r = 0; r < regions.ring_count(); ++r)
+		{
+			rings.push_back(regions.ring(r));
+		}
+		return densify(std::span<const LoopView<E3>>(rings), std::span<const size_t>(regions.part_offsets),
+			options, threads, e, T);
+	}
+
+	/// Densified copy of Compound regions, one part per region, without
+	/// copying the input first
+	template <typename P>
+	FlatCompoundSet<E3> densify(const std::vector<Compound<P>>& regions, const DensifyOptions& options,
+		unsigned threads = 1, const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{})
+	{
+		std::vector<LoopView<E3>> rings;
+		std::vector<size_t> part_offsets{ 0 };
+		part_offsets.reserve(regions.size() + 1);
+		for (const Compound<P>& region : regions)
+		{
+			for (const P& poly : region.polygons)
+			{
+				rings.emplace_back(poly.boundary);
+			}
+			part_offsets.push_back(rings.size());
+		}
+		return densify(std::span<const LoopView<E3>>(rings), std::span<const size_t>(part_offsets),
+			options, threads, e, T);
+	}
+}
@@ -0,0 +1,453 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <S2LL/Core/Containment.hpp>
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Padding of every box, far above the rounding of its corners
+		constexpr double box_padding = 1e-12;
+
+		/// Below this cosine of the edge angle the apex runs off to infinity
+		/// and the edge gets the whole cube
+		constexpr double min_apex_cos = -0.9;
+
+		/// Closest point of the minor arc ab to q, all unit, and its angle
+		/// from q: the foot on the great circle when it falls within the arc,
+		/// otherwise the nearer endpoint
+		std::pair<E3, double> arc_closest(const E3& q, const E3& a, const E3& b) noexcept
+		{
+			const E3 n = plain_cross(a, b);
+			const double nn = std::sqrt(plain_dot(n, n));
+			if (nn > 0.0)
+			{
+				const E3 nh{ n.x / nn, n.y / nn, n.z / nn };
+				const double h = plain_dot(q, nh);
+				const E3 foot{ q.x - h * nh.x, q.y - h * nh.y, q.z - h * nh.z };
+				const double f = std::sqrt(plain_dot(foot, foot));
+				if (f > 0.0 && plain_dot(plain_cross(a, foot), n) >= 0.0 && plain_dot(plain_cross(foot, b), n) >= 0.0)
+				{
+					return { E3{ foot.x / f, foot.y / f, foot.z / f }, std::atan2(std::abs(h), f) };
+				}
+			}
+			const double da = angle(q, a), db = angle(q, b);
+			return da <= db ? std::pair<E3, double>{ a, da } : std::pair<E3, double>{ b, db };
+		}
+
+		template <typename Box>
+		Box empty_box() noexcept
+		{
+			constexpr double inf = std::numeric_limits<double>::infinity();
+			return Box{ { inf, inf, inf }, { -inf, -inf, -inf } };
+		}
+
+		template <typename Box>
+		void grow(Box& box, const E3& p) noexcept
+		{
+			const double c[3] = { p.x, p.y, p.z };
+			for (int k = 0; k < 3; ++k)
+			{
+				box.lo[k] = std::min(box.lo[k], c[k]);
+				box.hi[k] = std::max(box.hi[k], c[k]);
+			}
+		}
+
+		template <typename Box>
+		void grow(Box& box, const Box& other) noexcept
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				box.lo[k] = std::min(box.lo[k], other.lo[k]);
+				box.hi[k] = std::max(box.hi[k], other.hi[k]);
+			}
+		}
+
+		/// Box enclosing the minor arc ab: the arc lies in the triangle of its
+		/// endpoints and of the apex (a + b) / (1 + a . b) of its tangents
+		template <typename Box>
+		Box arc_box(const E3& a, const E3& b) noexcept
+		{
+			const E3 u = unit(a), v = unit(b);
+			const double d = plain_dot(u, v);
+			Box box = empty_box<Box>();
+			if (d < min_apex_cos)
+			{
+				return Box{ { -1.0, -1.0, -1.0 }, { 1.0, 1.0, 1.0 } };
+			}
+			grow(box, u);
+			grow(box, v);
+			const double s = 1.0 / (1.0 + d);
+			grow(box, E3{ (u.x + v.x) * s, (u.y + v.y) * s, (u.z + v.z) * s });
+			for (int k = 0; k < 3; ++k)
+			{
+				box.lo[k] -= box_padding;
+				box.hi[k] += box_padding;
+			}
+			return box;
+		}
+
+		template <typename Box>
+		bool overlap(const Box& x, const Box& y) noexcept
+		{
+			return x.lo[0] <= y.hi[0] && y.lo[0] <= x.hi[0]
+				&& x.lo[1] <= y.hi[1] && y.lo[1] <= x.hi[1]
+				&& x.lo[2] <= y.hi[2] && y.lo[2] <= x.hi[2];
+		}
+
+		/// True if the box meets the plane through the origin with normal n
+		template <typename Box>
+		bool meets_plane(const Box& box, const E3& n) noexcept
+		{
+			const double c[3] = { n.x, n.y, n.z };
+			double lo = 0.0, hi = 0.0;
+			for (int k = 0; k < 3; ++k)
+			{
+				const double p = c[k] * box.lo[k], q = c[k] * box.hi[k];
+				lo += std::min(p, q);
+				hi += std::max(p, q);
+			}
+			return lo <= box_padding && hi >= -box_padding;
+		}
+
+		/// Squared Euclidean distance from q to the box
+		template <typename Box>
+		double distance2(const Box& box, const E3& q) noexcept
+		{
+			const double c[3] = { q.x, q.y, q.z };
+			double d2 = 0.0;
+			for (int k = 0; k < 3; ++k)
+			{
+				const double d = std::max({ box.lo[k] - c[k], 0.0, c[k] - box.hi[k] });
+				d2 += d * d;
+			}
+			return d2;
+		}
+
+		/// Lower bound on the angle from the unit vector q to the edge points
+		/// in the box: they are unit vectors, so the chord to any of them is
+		/// at least the distance from q to the box
+		template <typename Box>
+		double angle_bound(const Box& box, const E3& q) noexcept
+		{
+			const double chord = std::max(0.0, std::sqrt(distance2(box, q)) - box_padding);
+			return 2.0 * std::asin(std::min(1.0, 0.5 * chord));
+		}
+	}
+
+	EdgeBVH::EdgeBVH(LoopView<E3> ring, unsigned threads)
+		: vertices(ring.begin(), ring.end()), starts{ 0, ring.size() }
+	{
+		init(threads);
+	}
+
+	EdgeBVH::EdgeBVH(std::span<const LoopView<E3>> rings, unsigned threads)
+	{
+		starts.reserve(rings.size() + 1);
+		for (const LoopView<E3> ring : rings)
+		{
+			starts.push_back(vertices.size());
+			vertices.insert(vertices.end(), ring.begin(), ring.end());
+		}
+		starts.push_back(vertices.size());
+		successor.resize(vertices.size());
+		for (size_t r = 0; r + 1 < starts.size(); ++r)
+		{
+			for (size_t i = starts[r]; i < starts[r + 1]; ++i)
+			{
+				successor[i] = static_cast<uint32_t>(i + 1 < starts[r + 1] ? i + 1 : starts[r]);
+			}
+		}
+		init(threads);
+	}
+
+	void EdgeBVH::init(unsigned threads)
+	{
+		const size_t n = vertices.size();
+		if (n == 0)
+		{
+			return;
+		}
+
+		// Edge boxes and sort keys: the Morton code of the box center above
+		// the edge index, so keys are unique and equal codes still split
+		std::vector<Box> boxes(n);
+		std::vector<uint64_t> keys(n);
+		parallel_for(n, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Box& box = boxes[i] = arc_box<Box>(vertices[i], vertices[next(i)]);
+				const uint64_t code = (spread10(0.5 * (box.lo[0] + box.hi[0])) << 2)
+					| (spread10(0.5 * (box.lo[1] + box.hi[1])) << 1)
+					| spread10(0.5 * (box.lo[2] + box.hi[2]));
+				keys[i] = (code << 32) | i;
+			}
+		}, threads, 4096);
+		std::sort(keys.begin(), keys.end());
+
+		order.resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			order[i] = static_cast<uint32_t>(keys[i]);
+		}
+		nodes.reserve(2 * (n / leaf_size) + 1);
+		build(keys, boxes, 0, static_cast<uint32_t>(n));
+
+		if (successor.empty())
+		{
+			if (n >= 3)
+			{
+				// As in PreparedPolygon: vertex 1 is inside iff the reference
+				// direction around it falls between its edges
+				const bool v1_inside = ordered_ccw(ref_dir(vertices[1]), vertices[0], vertices[2], vertices[1]);
+				origin_inside = v1_inside != crossing_parity(PreparedPolygon::origin, vertices[1]);
+			}
+			return;
+		}
+		// Several rings: the origin is inside an odd number of them, each
+		// found as above with the crossings of that ring alone
+		for (size_t r = 0; r + 1 < starts.size(); ++r)
+		{
+			const size_t first = starts[r], count = starts[r + 1] - first;
+			if (count < 3)
+			{
+				continue;
+			}
+			const E3& v1 = vertices[first + 1];
+			bool inside = ordered_ccw(ref_dir(v1), vertices[first], vertices[first + 2], v1);
+			for (size_t i = first; i < first + count; ++i)
+			{
+				inside ^= edge_or_vertex_crossing(PreparedPolygon::origin, v1, vertices[i], vertices[next(i)]);
+			}
+			origin_inside ^= inside;
+		}
+	}
+
+	size_t EdgeBVH::ring_of(size_t edge) const noexcept
+	{
+		return static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), edge) - starts.begin()) - 1;
+	}
+
+	uint32_t EdgeBVH::build(std::vector<uint64_t>& keys, const std::vector<Box>& boxes, uint32_t begin, uint32_t end)
+	{
+		const uint32_t index = static_cast<uint32_t>(nodes.size());
+		nodes.push_back(Node{ empty_box<Box>(), begin, end - begin });
+		if (end - begin <= leaf_size)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				grow(nodes[index].box, boxes[order[i]]);
+			}
+			return index;
+		}
+
+		// Split where the highest bit differing over the range flips
+		const int bit = 63 - std::countl_zero(keys[begin] ^ keys[end - 1]);
+		const auto mid = std::partition_point(keys.begin() + begin, keys.begin() + end,
+			[bit](uint64_t k) { return ((k >> bit) & 1) == 0; });
+		const uint32_t split = static_cast<uint32_t>(mid - keys.begin());
+
+		build(keys, boxes, begin, split);
+		const uint32_t right = build(keys, boxes, split, end);
+		Node& node = nodes[index];
+		grow(node.box, nodes[index + 1].box);
+		grow(node.box, nodes[right].box);
+		node.first = right;
+		node.count = 0;
+		return index;
+	}
+
+	template <typename Prune, typename Visit>
+	void EdgeBVH::traverse(Prune&& prune, Visit&& visit) const
+	{
+		if (nodes.empty())
+		{
+			return;
+		}
+		uint32_t stack[96];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const Node& node = nodes[stack[--top]];
+			if (prune(node.box))
+			{
+				continue;
+			}
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; ++i)
+				{
+					if (visit(static_cast<size_t>(order[i])))
+					{
+						return;
+					}
+				}
+				continue;
+			}
+			stack[top++] = node.first;
+			stack[top++] = static_cast<uint32_t>(&node - nodes.data()) + 1;
+		}
+	}
+
+	template <typename Visit>
+	void EdgeBVH::visit_arc(const E3& a, const E3& b, Visit&& visit) const
+	{
+		const Box query = arc_box<Box>(a, b);
+		const E3 n = plain_cross(unit(a), unit(b));
+		traverse([&](const Box& box) { return !overlap(box, query) || !meets_plane(box, n); }, visit);
+	}
+
+	std::vector<size_t> EdgeBVH::crossing_edges(const E3& a, const E3& b) const
+	{
+		std::vector<size_t> out;
+		visit_arc(a, b, [&](size_t i) {
+			if (crossing_sign(a, b, vertices[i], vertices[next(i)]) > 0)
+			{
+				out.push_back(i);
+			}
+			return false;
+		});
+		std::sort(out.begin(), out.end());
+		return out;
+	}
+
+	bool EdgeBVH::crosses(const E3& a, const E3& b) const
+	{
+		bool found = false;
+		visit_arc(a, b, [&](size_t i) {
+			found = crossing_sign(a, b, vertices[i], vertices[next(i)]) > 0;
+			return found;
+		});
+		return found;
+	}
+
+	bool EdgeBVH::crossing_parity(const E3& a, const E3& b) const
+	{
+		bool parity = false;
+		visit_arc(a, b, [&](size_t i) {
+			parity ^= edge_or_vertex_crossing(a, b, vertices[i], vertices[next(i)]);
+			return false;
+		});
+		return parity;
+	}
+
+	bool EdgeBVH::contains(const E3& p) const
+	{
+		if (vertices.size() < 3)
+		{
+			return false;
+		}
+		return origin_inside != crossing_parity(PreparedPolygon::origin, p);
+	}
+
+	std::optional<EdgeHit> EdgeBVH::raycast(const E3& a, const E3& b) const
+	{
+		const E3 u = unit(a), v = unit(b);
+		const E3 normal = plain_cross(u, v);
+		const E3 mid{ u.x + v.x, u.y + v.y, u.z + v.z };
+		std::optional<EdgeHit> hit;
+		visit_arc(a, b, [&](size_t i) {
+			const E3& c = vertices[i];
+			const E3& d = vertices[next(i)];
+			if (crossing_sign(a, b, c, d) <= 0)
+			{
+				return false;
+			}
+			// The crossing is the intersection of the two great circles on
+			// the side of the minor arc ab
+			E3 x = unit(plain_cross(normal, plain_cross(unit(c), unit(d))));
+			if (plain_dot(x, mid) < 0.0)
+			{
+				x = E3{ -x.x, -x.y, -x.z };
+			}
+			const double t = angle(u, x);
+			if (!hit || t < hit->angle || (t == hit->angle && i < hit->edge))
+			{
+				hit = EdgeHit{ i, x, t };
+			}
+			return false;
+		});
+		return hit;
+	}
+
+	EdgeHit EdgeBVH::nearest(const E3& p) const
+	{
+		const E3 q = unit(p);
+		EdgeHit best{ 0, unit(vertices[0]), angle(q, unit(vertices[0])) };
+
+		const auto bound = [&](const Box& box) { return angle_bound(box, q); };
+
+		struct Entry
+		{
+			uint32_t node;
+			double bound;
+		};
+		Entry stack[96];
+		int top = 0;
+		stack[top++] = Entry{ 0, bound(nodes[0].box) };
+		while (top > 0)
+		{
+			const Entry e = stack[--top];
+			if (e.bound > best.angle)
+			{
+				continue;
+			}
+			const Node& node = nodes[e.node];
+			if (node.count > 0)
+			{
+				for (uint32_t k = node.first; k < node.first + node.count; ++k)
+				{
+					const size_t i = order[k];
+					const auto [x, t] = arc_closest(q, unit(vertices[i]), unit(vertices[next(i)]));
+					if (t < best.angle || (t == best.angle && i < best.edge))
+					{
+						best = EdgeHit{ i, x, t };
+					}
+				}
+				continue;
+			}
+			// Nearer child on top of the stack
+			Entry left{ e.node + 1, bound(nodes[e.node + 1].box) };
+			Entry right{ node.first, bound(nodes[node.first].box) };
+			if (left.bound < right.bound)
+			{
+				std::swap(left, right);
+			}
+			stack[top++] = left;
+			stack[top++] = right;
+		}
+		return best;
+	}
+
+	std::vector<EdgeHit> EdgeBVH::within(const E3& p, double radius) const
+	{
+		const E3 q = unit(p);
+		std::vector<EdgeHit> out;
+		traverse([&](const Box& box) { return angle_bound(box, q) > radius; }, [&](size_t i) {
+			const auto [x, t] = arc_closest(q, unit(vertices[i]), unit(vertices[next(i)]));
+			if (t <= radius)
+			{
+				out.push_back(EdgeHit{ i, x, t });
+			}
+			return false;
+		});
+		std::sort(out.begin(), out.end(), [](const EdgeHit& a, const EdgeHit& b) {
+			return a.angle != b.angle ? a.angle < b.angle : a.edge < b.edge;
+		});
+		return out;
+	}
+
+	size_t EdgeBVH::memory_usage() const noexcept
+	{
+		return vertices.capacity() * sizeof(E3) + nodes.capacity() * sizeof(Node) + order.capacity() * sizeof(uint32_t)
+			+ successor.capacity() * sizeof(uint32_t) + starts.capacity() * sizeof(size_t);
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+// References:
+// Lauterbach, C., Garland, M., Sengupta, S., Luebke, D., & Manocha, D. (2009). Fast BVH construction on GPUs. Computer Graphics Forum, 28(2), 375-384. https://doi.org/10.1111/j.1467-8659.2009.01377.x
+
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace S2LL
+{
+	/// Edge of a ring reached by a query: its index (edge i runs from vertex
+	/// i to the next vertex of its ring), a point of the edge and an angle in
+	/// radians
+	struct EdgeHit
+	{
+		size_t edge;
+		E3 point;
+		double angle;
+	};
+
+	/// Bounding volume hierarchy over the great-circle edges of a ring, for
+	/// rings far too long to scan (coastlines). Every edge is bounded by the
+	/// box in E3 of its endpoints and of the apex where the tangents at both
+	/// ends meet, which encloses the minor arc. Edges are ordered along a
+	/// Morton curve of their box centers (linear BVH) and the tree is stored
+	/// depth-first in one flat node array: the left child of a node follows
+	/// it, the right child is linked by index.
+	///
+	/// Queries descend only into nodes whose box can meet the query and
+	/// decide on the surviving edges with the exact predicates, so they
+	/// agree with PreparedPolygon and the edge-crossing functions.
+	class EdgeBVH
+	{
+		struct Box
+		{
+			double lo[3], hi[3];
+		};
+
+		struct Node
+		{
+			Box box;
+			// Leaf: edges order[first .. first + count); inner node: count
+			// is zero and first is the index of the right child
+			uint32_t first, count;
+		};
+
+		std::vector<E3> vertices;
+		// Vertex after each vertex of its ring; empty for a single ring
+		std::vector<uint32_t> successor;
+		// First vertex of each ring, and the vertex count last
+		std::vector<size_t> starts;
+		std::vector<Node> nodes;
+		std::vector<uint32_t> order;
+		bool origin_inside = false;
+
+		inline size_t next(size_t i) const noexcept
+		{
+			return successor.empty() ? (i + 1 < vertices.size() ? i + 1 : 0) : successor[i];
+		}
+
+		void init(unsigned threads);
+
+		uint32_t build(std::vector<uint64_t>& codes, const std::vector<Box>& boxes, uint32_t begin, uint32_t end);
+
+		template <typename Prune, typename Visit>
+		void traverse(Prune&& prune, Visit&& visit) const;
+
+		template <typename Visit>
+		void visit_arc(const E3& a, const E3& b, Visit&& visit) const;
+
+	public:
+		/// Edges per leaf, at most
+		static constexpr uint32_t leaf_size = 4;
+
+		/// Builds the hierarchy over the edges of the ring; box and Morton
+		/// code computation is split among up to `threads` threads
+		/// (0: one per hardware thread)
+		explicit EdgeBVH(LoopView<E3> ring, unsigned threads = 1);
+
+		/// Builds the hierarchy over the edges of a geodesic polygon, read as
+		/// a spherical polygon
+		template <size_t N>
+		explicit EdgeBVH(const GP<N>& poly, unsigned threads = 1)
+			: EdgeBVH(LoopView<E3>(poly.boundary), threads)
+		{
+		}
+
+		/// Builds the hierarchy over the edges of several rings, numbered
+		/// ring after ring; contains() then reads a point as inside when it
+		/// lies inside an odd number of rings, as for a Compound region
+		explicit EdgeBVH(std::span<const LoopView<E3>> rings, unsigned threads = 1);
+
+		/// Number of edges
+		inline size_t size() const noexcept { return vertices.size(); }
+
+		/// Number of rings
+		inline size_t ring_count() const noexcept { return starts.size() - 1; }
+
+		/// Ring holding an edge
+		size_t ring_of(size_t edge) const noexcept;
+
+		/// Endpoints of an edge
+		inline std::pair<E3, E3> edge(size_t i) const noexcept { return { vertices[i], vertices[next(i)] }; }
+
+		/// Number of tree nodes
+		inline size_t node_count() const noexcept { return nodes.size(); }
+
+		/// Edges properly crossing the minor arc ab (crossing_sign > 0), in
+		/// ascending order
+		std::vector<size_t> crossing_edges(const E3& a, const E3& b) const;
+
+		/// True if some edge properly crosses the minor arc ab
+		bool crosses(const E3& a, const E3& b) const;
+
+		/// Parity of the crossings of the minor arc ab with the ring, counted
+		/// as edge_or_vertex_crossing does
+		bool crossing_parity(const E3& a, const E3& b) const;
+
+		/// Containment under the conventions of PreparedPolygon: the interior
+		/// lies to the left of the edges, boundaries are semi-open
+		bool contains(const E3& p) const;
+
+		/// First edge properly crossed walking along the minor arc from a to
+		/// b, with the crossing point and its angle from a
+		std::optional<EdgeHit> raycast(const E3& a, const E3& b) const;
+
+		/// Edge nearest to the direction p, with its closest point (unit) and
+		/// the angular distance to it. The ring must not be empty.
+		EdgeHit nearest(const E3& p) const;
+
+		/// Edges within an angular distance of the direction p, nearest first
+		/// (equal distances by edge index), each with its closest point
+		std::vector<EdgeHit> within(const E3& p, double radius) const;
+
+		/// Heap bytes held by the hierarchy
+		size_t memory_usage() const noexcept;
+	};
+}
@@ -7,20 +7,123 @@ namespace S2LL
 	Ellipsoid::Ellipsoid(double r)
 		: a(r), b(r), c{r, 0.0}
 	{
+		derive();
 	}
 
 	Ellipsoid::Ellipsoid(double a, double inv_f)
 		: a(a), b(a), c(S2LL::Sub(a, S2LL::Div(a, inv_f)))
 	{
+		derive();
 	}
 
 	Ellipsoid::Ellipsoid(double a, double b, double c)
 		: a(a), b(b), c{c, 0.0}
 	{
+		derive();
+	}
+
+	void Ellipsoid::derive()
+	{
+		// (a - c)(a + c) keeps the small difference of squares exact-ish
+		const Double diff2 = S2LL::Mul(S2LL::Sub(a, c), S2LL::Add(a, c));
+		ecc2 = S2LL::Div(diff2, S2LL::Sq(a));
+		ecc2_prime = S2LL::Div(diff2, S2LL::Sq(c));
+		ratio = S2LL::Div(c, a);
 	}
 
 	double Ellipsoid::inv_f() const
 	{
 		return static_cast<double>(S2LL::Div(a, S2LL::Sub(a, c)));
 	}
+
+	namespace
+	{
+		/// atanh(e x) / e for e^2 of either sign, x when e == 0
+		inline double atanhee(double x, double e2) noexcept
+		{
+			const double e = std::sqrt(std::abs(e2));
+			return e2 > 0.0 ? std::atanh(e * x) / e : e2 < 0.0 ? std::atan(e * x) / e : x;
+		}
+	}
+
+	double Ellipsoid::authalic_radius() const noexcept
+	{
+		// q_p = 1 + (1 - e^2) atanh(e) / e, and R^2 = a^2 q_p / 2
+		const double e2 = static_cast<double>(ecc2);
+		return a * std::sqrt(0.5 * (1.0 + (1.0 - e2) * atanhee(1.0, e2)));
+	}
+
+	double Ellipsoid::authalic_latitude(double lat) const noexcept
+	{
+		if (!is_spheroid())
+		{
+			std::feraiseexcept(FE_INVALID);
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		// sin(beta) = q / q_p with q = (1 - e^2) (s / (1 - e^2 s^2) + atanh(e s) / e),
+		// s = sin(lat). Near the poles q_p - q cancels, so it is evaluated
+		// from 1 - s = cos^2 / (1 + s) in closed form, which gives cos(beta)
+		const double e2 = static_cast<double>(ecc2);
+		const double s = std::sin(std::abs(lat)), c = std::cos(lat);
+		const double qp = 1.0 + (1.0 - e2) * atanhee(1.0, e2);
+		const double q = (1.0 - e2) * (s / (1.0 - e2 * s * s) + atanhee(s, e2));
+		const double d = c * c / (1.0 + s);
+		const double dq = d * (1.0 + e2 * s) / (1.0 - e2 * s * s) + (1.0 - e2) * atanhee(d / (1.0 - e2 * s), e2);
+		const double beta = std::atan2(q, std::sqrt(std::max(0.0, dq * (2.0 * qp - dq))));
+		return std::copysign(beta, lat);
+	}
+
+	E3 Ellipsoid::geodetic_E3(const LLH& g) const noexcept
+	{
+		if (!is_spheroid())
+		{
+			std::feraiseexcept(FE_INVALID);
+			const double nan = std::numeric_limits<double>::quiet_NaN();
+			return E3{ nan, nan, nan };
+		}
+
+		// N = a / sqrt(1 - e^2 sin^2 lat), the prime vertical radius
+		auto [sin_lat, cos_lat] = SinCos(g.lat);
+		auto [sin_lon, cos_lon] = SinCos(g.lon);
+		const Double n = S2LL::Div(a, Sqrt(S2LL::Sub(1.0, S2LL::Mul(ecc2, Sq(sin_lat)))));
+		const Double r = S2LL::Mul(S2LL::Add(n, g.h), cos_lat);
+		const Double zn = S2LL::Mul(n, S2LL::Sub(1.0, ecc2));
+		return E3{
+			static_cast<double>(S2LL::Mul(r, cos_lon)),
+			static_cast<double>(S2LL::Mul(r, sin_lon)),
+			static_cast<double>(S2LL::Mul(S2LL::Add(zn, g.h), sin_lat))
+		};
+	}
+
+	LLH Ellipsoid::geodetic_LLH(const E3& p) const noexcept
+	{
+		// Seed with the closed form, then iterate lat <- atan2(z + e^2 N sin lat, rho)
+		// in Double. The map contracts by about e^2 per step, so two steps take
+		// the double-precision seed well below one ulp.
+		const LLH seed = to_LLH<Precision::Fast>(p);
+		if (std::isnan(seed.lat))
+		{
+			return seed;
+		}
+
+		const Double rho = Sqrt(Sq(p.x) + Sq(p.y));
+		Double lat = Lift(seed.lat);
+		for (int i = 0; i < 2; ++i)
+		{
+			const auto [sin_lat, cos_lat] = SinCos(lat);
+			const Double n = S2LL::Div(a, Sqrt(S2LL::Sub(1.0, S2LL::Mul(ecc2, Sq(sin_lat)))));
+			lat = Atan2(S2LL::Add(p.z, S2LL::Mul(S2LL::Mul(ecc2, n), sin_lat)), rho);
+		}
+
+		// h = rho cos(lat) + z sin(lat) - a^2 / N, stable at every latitude
+		const auto [sin_lat, cos_lat] = SinCos(lat);
+		const Double w = Sqrt(S2LL::Sub(1.0, S2LL::Mul(ecc2, Sq(sin_lat))));
+		const Double h = S2LL::Mul(rho, cos_lat) + S2LL::Mul(p.z, sin_lat) - S2LL::Mul(a, w);
+		return LLH{
+			static_cast<double>(lat),
+			static_cast<double>(Atan2(Lift(p.y), Lift(p.x))),
+			static_cast<double>(h)
+		};
+	}
 }
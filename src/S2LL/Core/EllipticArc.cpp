@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numbers>
+#include <S2LL/Core/Regions.hpp>
+
+// References:
+// Carlson, B. C. (1995). Numerical computation of real or complex elliptic integrals. Numerical Algorithms, 10(1), 13-26. https://doi.org/10.1007/BF02198293
+
+namespace S2LL
+{
+	namespace
+	{
+		constexpr double pi = std::numbers::pi;
+
+		/// Carlson's symmetric integral R_F(x, y, z), eq. (2.7)
+		double RF(double x, double y, double z) noexcept
+		{
+			const double tol = std::pow(3.0 * DBL_EPSILON * 0.01, 1.0 / 8.0);
+			const double A0 = (x + y + z) / 3.0;
+			double An = A0;
+			const double Q = std::max({ std::abs(A0 - x), std::abs(A0 - y), std::abs(A0 - z) }) / tol;
+			double x0 = x, y0 = y, z0 = z, mul = 1.0;
+			while (Q >= mul * std::abs(An))
+			{
+				const double lam = std::sqrt(x0) * std::sqrt(y0) + std::sqrt(y0) * std::sqrt(z0) + std::sqrt(z0) * std::sqrt(x0);
+				An = (An + lam) / 4.0;
+				x0 = (x0 + lam) / 4.0;
+				y0 = (y0 + lam) / 4.0;
+				z0 = (z0 + lam) / 4.0;
+				mul *= 4.0;
+			}
+			const double X = (A0 - x) / (mul * An);
+			const double Y = (A0 - y) / (mul * An);
+			const double Z = -(X + Y);
+			const double E2 = X * Y - Z * Z;
+			const double E3 = X * Y * Z;
+			return (E3 * (6930 * E3 + E2 * (15015 * E2 - 16380) + 17160)
+				+ E2 * ((10010 - 5775 * E2) * E2 - 24024) + 240240) / (240240 * std::sqrt(An));
+		}
+
+		/// Carlson's symmetric integral R_D(x, y, z), eq. (2.29)
+		double RD(double x, double y, double z) noexcept
+		{
+			const double tol = std::pow(0.2 * DBL_EPSILON * 0.01, 1.0 / 8.0);
+			const double A0 = (x + y + 3.0 * z) / 5.0;
+			double An = A0;
+			const double Q = std::max({ std::abs(A0 - x), std::abs(A0 - y), std::abs(A0 - z) }) / tol;
+			double x0 = x, y0 = y, z0 = z, mul = 1.0, s = 0.0;
+			while (Q >= mul * std::abs(An))
+			{
+				const double lam = std::sqrt(x0) * std::sqrt(y0) + std::sqrt(y0) * std::sqrt(z0) + std::sqrt(z0) * std::sqrt(x0);
+				s += 1.0 / (mul * std::sqrt(z0) * (z0 + lam));
+				An = (An + lam) / 4.0;
+				x0 = (x0 + lam) / 4.0;
+				y0 = (y0 + lam) / 4.0;
+				z0 = (z0 + lam) / 4.0;
+				mul *= 4.0;
+			}
+			const double X = (A0 - x) / (mul * An);
+			const double Y = (A0 - y) / (mul * An);
+			const double Z = -(X + Y) / 3.0;
+			const double E2 = X * Y - 6 * Z * Z;
+			const double E3 = (3 * X * Y - 8 * Z * Z) * Z;
+			const double E4 = 3 * (X * Y - Z * Z) * Z * Z;
+			const double E5 = X * Y * Z * Z * Z;
+			return ((471240 - 540540 * E2) * E5
+				+ (612612 * E2 - 540540 * E3 - 556920) * E4
+				+ E3 * (306306 * E3 + E2 * (675675 * E2 - 706860) + 680680)
+				+ E2 * ((417690 - 255255 * E2) * E2 - 875160) + 4084080)
+				/ (4084080 * mul * An * std::sqrt(An)) + 3 * s;
+		}
+
+		/// Incomplete elliptic integral of the second kind E(phi, k) for
+		/// |phi| <= pi / 2, with k2 = k^2
+		double E(double phi, double k2) noexcept
+		{
+			const double s = std::sin(phi), c = std::cos(phi);
+			const double y = 1.0 - k2 * s * s;
+			const double c2 = c * c;
+			return s * (RF(c2, y, 1.0) - k2 * s * s * RD(c2, y, 1.0) / 3.0);
+		}
+	}
+
+	EllipticArcFrame::EllipticArcFrame(const EllipticArc& arc)
+	{
+		const E3 u = arc.a.normalized();
+		const E3 v = arc.b.normalized();
+		const double d = u.dot(v);
+		const E3 w = (v - u * d).normalized();
+		theta = std::atan2(u.cross(v).mag(), d);
+
+		U = arc.transform(u * arc.radius);
+		W = arc.transform(w * arc.radius);
+		H = arc.transform(u.cross(w));
+
+		// Principal axes of P(t) = U cos t + W sin t: |P|^2 peaks at
+		// tan(2t) = 2 U.W / (U.U - W.W)
+		const double uu = U.dot(U), ww = W.dot(W), uw = U.dot(W);
+		const double root = std::hypot(0.5 * (uu - ww), uw);
+		const double major2 = 0.5 * (uu + ww) + root;
+		const E3 n = U.cross(W);
+		phase = 0.5 * std::atan2(2.0 * uw, uu - ww);
+		major = std::sqrt(major2);
+		minor = std::sqrt(n.dot(n) / major2);
+		k2 = 2.0 * root / major2;
+
+		complete = k2 == 0.0 ? 0.5 * pi : RF(0.0, 1.0 - k2, 1.0) - k2 * RD(0.0, 1.0 - k2, 1.0) / 3.0;
+		e0 = 0.0;
+		e0 = integral(0.0);
+		total = length_to(theta);
+	}
+
+	double EllipticArcFrame::integral(double t) const noexcept
+	{
+		// |P'(t)| = major sqrt(1 - k2 sin^2(t - phase + pi/2)), so the arc
+		// length is major E(t - phase + pi/2, k) up to a constant; E advances
+		// by 2 E(k) per half period
+		const double psi = t - phase + 0.5 * pi;
+		if (k2 == 0.0)
+		{
+			return psi;
+		}
+		const double m = std::round(psi / pi);
+		return 2.0 * m * complete + E(psi - m * pi, k2);
+	}
+
+	double EllipticArcFrame::angle_at(double s) const noexcept
+	{
+		if (k2 == 0.0)
+		{
+			return s / major;
+		}
+
+		// The speed lies in [minor, major], which brackets the root; Newton
+		// steps that leave the bracket fall back to bisection
+		const double target = s / major + e0;
+		double lo = std::min(s / major, s / minor);
+		double hi = std::max(s / major, s / minor);
+		double t = total > 0.0 ? std::clamp(theta * s / total, lo, hi) : s / major;
+		for (int i = 0; i < 64; ++i)
+		{
+			const double f = integral(t) - target;
+			if (f > 0.0)
+			{
+				hi = t;
+			}
+			else
+			{
+				lo = t;
+			}
+			const double c = std::cos(t - phase);
+			double next = t - f / std::sqrt(1.0 - k2 * c * c);
+			if (!(next > lo && next < hi))
+			{
+				next = 0.5 * (lo + hi);
+			}
+			if (std::abs(next - t) <= 4.0 * DBL_EPSILON * std::max(1.0, std::abs(t)))
+			{
+				return next;
+			}
+			t = next;
+		}
+		return t;
+	}
+
+	double EllipticArcFrame::azimuth(double t) const noexcept
+	{
+		// World tangent and outward normal; east = z x N and north = N x east,
+		// the latter carrying an extra factor |N|
+		const E3 tangent = W * std::cos(t) - U * std::sin(t);
+		const E3 normal = tangent.cross(H);
+		const E3 east{ -normal.y, normal.x, 0.0 };
+		const E3 north = normal.cross(east);
+		return std::atan2(tangent.dot(east) * normal.mag(), tangent.dot(north));
+	}
+}
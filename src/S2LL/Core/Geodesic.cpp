@@ -0,0 +1,785 @@
+// The geodesic solver in this file is a port of the C library of
+// GeographicLib (geodesic.c), by Charles Karney, after
+// Karney, C. F. F. (2013). Algorithms for geodesics. Journal of Geodesy, 87(1), 43-55. https://doi.org/10.1007/s00190-012-0578-z
+// It is distributed under the original license:
+//
+// Copyright (c) Charles Karney (2012-2022) <karney@alum.mit.edu>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cassert>
+#include <cfenv>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+#include <vector>
+#include <S2LL/Core/Geodesics.hpp>
+#include <S2LL/Core/Numerics.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		constexpr int nC = 6;
+
+		constexpr double pi = std::numbers::pi;
+		constexpr double tiny = 0x1p-511;	// sqrt(DBL_MIN)
+		constexpr double tol0 = DBL_EPSILON;
+		constexpr double tol1 = 200 * tol0;
+		constexpr double tol2 = 0x1p-26;	// sqrt(DBL_EPSILON)
+		constexpr double tolb = tol0 * tol2;
+		constexpr double xthresh = 1000 * tol2;
+		constexpr unsigned maxit1 = 20;
+		constexpr unsigned maxit2 = maxit1 + DBL_MANT_DIG + 10;
+
+		inline double sq(double x) noexcept { return x * x; }
+
+		inline void norm2(double& s, double& c) noexcept
+		{
+			const double r = std::hypot(s, c);
+			s /= r;
+			c /= r;
+		}
+
+		/// Rounds tiny magnitudes to zero, so that points within about 1e-18
+		/// radians of the equator are treated as lying on it
+		inline double ang_round(double x) noexcept
+		{
+			constexpr double z = 1.0 / 16.0;
+			double y = std::abs(x);
+			y = y < z ? z - (z - y) : y;
+			return std::copysign(y, x);
+		}
+
+		/// sin and cos with exact results at multiples of pi/2
+		inline void sin_cos(double x, double& s, double& c) noexcept
+		{
+			const double q = std::round(x / (0.5 * pi));
+			const double r = x - q * (0.5 * pi);
+			const double sr = std::sin(r), cr = std::cos(r);
+			switch (static_cast<long long>(q) & 3)
+			{
+			case 0: s = sr; c = cr; break;
+			case 1: s = cr; c = -sr; break;
+			case 2: s = -sr; c = -cr; break;
+			default: s = -cr; c = sr; break;
+			}
+			// Avoid -0 so that atan2 keeps to its principal quadrants
+			s += 0.0;
+			c += 0.0;
+		}
+
+		/// Clenshaw summation of sum_{l=1..n} c[l] sin(2 l x)
+		inline double sin_series(double sinx, double cosx, const double c[], int n) noexcept
+		{
+			c += n + 1;
+			const double ar = 2 * (cosx - sinx) * (cosx + sinx);	// 2 cos(2x)
+			double y0 = (n & 1) ? *--c : 0.0, y1 = 0.0;
+			for (n /= 2; n--;)
+			{
+				y1 = ar * y0 - y1 + *--c;
+				y0 = ar * y1 - y0 + *--c;
+			}
+			return 2 * sinx * cosx * y0;
+		}
+
+		// Series in eps of Karney (2013), eqs. (17), (18), (21), (42), (43).
+		// The polynomials in eps^2 are written out in Horner form.
+
+		/// A1 - 1, the scale of the distance integral
+		inline double A1m1f(double eps) noexcept
+		{
+			const double e2 = sq(eps);
+			const double t = e2 * (1.0 / 4 + e2 * (1.0 / 64 + e2 * (1.0 / 256)));
+			return (t + eps) / (1 - eps);
+		}
+
+		/// Coefficients C1[l] of the distance integral
+		inline void C1f(double eps, double c[]) noexcept
+		{
+			const double e2 = sq(eps);
+			double d = eps;
+			c[1] = d * (-1.0 / 2 + e2 * (3.0 / 16 + e2 * (-1.0 / 32)));
+			d *= eps;
+			c[2] = d * (-1.0 / 16 + e2 * (1.0 / 32 + e2 * (-9.0 / 2048)));
+			d *= eps;
+			c[3] = d * (-1.0 / 48 + e2 * (3.0 / 256));
+			d *= eps;
+			c[4] = d * (-5.0 / 512 + e2 * (3.0 / 512));
+			d *= eps;
+			c[5] = d * (-7.0 / 1280);
+			d *= eps;
+			c[6] = d * (-7.0 / 2048);
+		}
+
+		/// Coefficients C1'[l] of the reverted distance series
+		inline void C1pf(double eps, double c[]) noexcept
+		{
+			const double e2 = sq(eps);
+			double d = eps;
+			c[1] = d * (1.0 / 2 + e2 * (-9.0 / 32 + e2 * (205.0 / 1536)));
+			d *= eps;
+			c[2] = d * (5.0 / 16 + e2 * (-37.0 / 96 + e2 * (1335.0 / 4096)));
+			d *= eps;
+			c[3] = d * (29.0 / 96 + e2 * (-75.0 / 128));
+			d *= eps;
+			c[4] = d * (539.0 / 1536 + e2 * (-2391.0 / 2560));
+			d *= eps;
+			c[5] = d * (3467.0 / 7680);
+			d *= eps;
+			c[6] = d * (38081.0 / 61440);
+		}
+
+		/// A2 - 1, the scale of the reduced length integral
+		inline double A2m1f(double eps) noexcept
+		{
+			const double e2 = sq(eps);
+			const double t = e2 * (-3.0 / 4 + e2 * (-7.0 / 64 + e2 * (-11.0 / 256)));
+			return (t - eps) / (1 + eps);
+		}
+
+		/// Coefficients C2[l] of the reduced length integral
+		inline void C2f(double eps, double c[]) noexcept
+		{
+			const double e2 = sq(eps);
+			double d = eps;
+			c[1] = d * (1.0 / 2 + e2 * (1.0 / 16 + e2 * (1.0 / 32)));
+			d *= eps;
+			c[2] = d * (3.0 / 16 + e2 * (1.0 / 32 + e2 * (35.0 / 2048)));
+			d *= eps;
+			c[3] = d * (5.0 / 48 + e2 * (5.0 / 256));
+			d *= eps;
+			c[4] = d * (35.0 / 512 + e2 * (7.0 / 512));
+			d *= eps;
+			c[5] = d * (63.0 / 1280);
+			d *= eps;
+			c[6] = d * (77.0 / 2048);
+		}
+
+		/// Largest root of k^4 + 2k^3 - (x^2 + y^2 - 1)k^2 - 2y^2 k - y^2 = 0,
+		/// the astroid problem for nearly antipodal points
+		double astroid(double x, double y) noexcept
+		{
+			const double p = sq(x), q = sq(y), r = (p + q - 1) / 6;
+			if (q == 0 && r <= 0)
+			{
+				return 0.0;
+			}
+			const double S = p * q / 4, r2 = sq(r), r3 = r * r2;
+			const double disc = S * (S + 2 * r3);
+			double u = r;
+			if (disc >= 0)
+			{
+				double T3 = S + r3;
+				T3 += T3 < 0 ? -std::sqrt(disc) : std::sqrt(disc);
+				const double T = std::cbrt(T3);
+				u += T + (T != 0 ? r2 / T : 0);
+			}
+			else
+			{
+				const double ang = std::atan2(std::sqrt(-disc), -(S + r3));
+				u += 2 * r * std::cos(ang / 3);
+			}
+			const double v = std::sqrt(sq(u) + q);
+			const double uv = u < 0 ? q / (v - u) : u + v;
+			const double w = (uv - q) / (2 * v);
+			return uv / (std::sqrt(uv + sq(w)) + w);
+		}
+	}
+
+	GeodesicSolver::GeodesicSolver(const Ellipsoid& e)
+		: a(e.major()),
+		  f(static_cast<double>(S2LL::Sub(1.0, e.axis_ratio())))
+	{
+		if (!e.is_spheroid() || !(f >= 0.0))
+		{
+			std::feraiseexcept(FE_INVALID);
+			a = f = std::numeric_limits<double>::quiet_NaN();
+		}
+		f1 = 1 - f;
+		e2 = f * (2 - f);
+		ep2 = e2 / sq(f1);
+		n = f / (2 - f);
+		b = a * f1;
+		etol2 = 0.1 * tol2 / std::sqrt(std::max(0.001, std::abs(f)) * std::min(1.0, 1 - f / 2) / 2);
+
+		// A3 and C3[l] of eq. (24), (25): coefficients of eps^j, polynomials in n
+		for (auto& row : C3x)
+		{
+			std::fill(std::begin(row), std::end(row), 0.0);
+		}
+		A3x[0] = 1;
+		A3x[1] = -(1.0 / 2 - n / 2);
+		A3x[2] = -(1.0 / 4 + n * (1.0 / 8 - n * (3.0 / 8)));
+		A3x[3] = -(1.0 / 16 + n * (3.0 / 16 + n * (1.0 / 16)));
+		A3x[4] = -(3.0 / 64 + n * (1.0 / 32));
+		A3x[5] = -3.0 / 128;
+
+		C3x[1][1] = 1.0 / 4 - n / 4;
+		C3x[1][2] = 1.0 / 8 - n * n / 8;
+		C3x[1][3] = 3.0 / 64 + n * (3.0 / 64 - n / 64);
+		C3x[1][4] = 5.0 / 128 + n / 64;
+		C3x[1][5] = 3.0 / 128;
+		C3x[2][2] = 1.0 / 16 + n * (-3.0 / 32 + n / 32);
+		C3x[2][3] = 3.0 / 64 + n * (-1.0 / 32 - n * (3.0 / 64));
+		C3x[2][4] = 3.0 / 128 + n / 128;
+		C3x[2][5] = 5.0 / 256;
+		C3x[3][3] = 5.0 / 192 + n * (-3.0 / 64 + n * (5.0 / 192));
+		C3x[3][4] = 3.0 / 128 - n * (5.0 / 192);
+		C3x[3][5] = 7.0 / 512;
+		C3x[4][4] = 7.0 / 512 - n * (7.0 / 256);
+		C3x[4][5] = 7.0 / 512;
+		C3x[5][5] = 21.0 / 2560;
+	}
+
+	double GeodesicSolver::A3f(double eps) const noexcept
+	{
+		double t = 0.0;
+		for (int j = order - 1; j >= 0; --j)
+		{
+			t = t * eps + A3x[j];
+		}
+		return t;
+	}
+
+	void GeodesicSolver::C3f(double eps, double c[]) const noexcept
+	{
+		double mult = 1.0;
+		for (int l = 1; l < order; ++l)
+		{
+			mult *= eps;
+			double t = 0.0;
+			for (int j = order - 1; j >= l; --j)
+			{
+				t = t * eps + C3x[l][j];
+			}
+			c[l] = t * mult;
+		}
+	}
+
+	void GeodesicSolver::lengths(double eps, double sig12,
+		double ssig1, double csig1, double dn1,
+		double ssig2, double csig2, double dn2,
+		double* s12b, double* m12b) const noexcept
+	{
+		// Distance and reduced length, both missing a factor of b
+		double Ca[nC + 1], Cb[nC + 1];
+		const double A1m1 = A1m1f(eps);
+		C1f(eps, Ca);
+		const double A1 = 1 + A1m1;
+		const double B1 = sin_series(ssig2, csig2, Ca, nC) - sin_series(ssig1, csig1, Ca, nC);
+		if (s12b)
+		{
+			*s12b = A1 * (sig12 + B1);
+		}
+		if (m12b)
+		{
+			const double A2m1 = A2m1f(eps);
+			C2f(eps, Cb);
+			const double m0 = A1m1 - A2m1;
+			const double A2 = 1 + A2m1;
+			const double B2 = sin_series(ssig2, csig2, Cb, nC) - sin_series(ssig1, csig1, Cb, nC);
+			const double J12 = m0 * sig12 + (A1 * B1 - A2 * B2);
+			// Parenthesized products cancel exactly for coincident points
+			*m12b = dn2 * (csig1 * ssig2) - dn1 * (ssig1 * csig2) - csig1 * csig2 * J12;
+		}
+	}
+
+	double GeodesicSolver::inverse_start(double sbet1, double cbet1, double sbet2, double cbet2,
+		double lam12, double slam12, double clam12,
+		double& salp1, double& calp1, double& salp2, double& calp2, double& dnm) const noexcept
+	{
+		// Returns a starting alp1 for Newton's method and -1, or, for short
+		// lines where no iteration is needed, alp1, alp2 and sig12 >= 0
+		double sig12 = -1;
+		const double sbet12 = sbet2 * cbet1 - cbet2 * sbet1;
+		const double cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+		const double sbet12a = sbet2 * cbet1 + cbet2 * sbet1;
+		const bool shortline = cbet12 >= 0 && sbet12 < 0.5 && cbet2 * lam12 < 0.5;
+
+		double somg12, comg12;
+		if (shortline)
+		{
+			// sin((bet1 + bet2) / 2)^2
+			double sbetm2 = sq(sbet1 + sbet2);
+			sbetm2 /= sbetm2 + sq(cbet1 + cbet2);
+			dnm = std::sqrt(1 + ep2 * sbetm2);
+			const double omg12 = lam12 / (f1 * dnm);
+			somg12 = std::sin(omg12);
+			comg12 = std::cos(omg12);
+		}
+		else
+		{
+			somg12 = slam12;
+			comg12 = clam12;
+		}
+
+		salp1 = cbet2 * somg12;
+		calp1 = comg12 >= 0
+			? sbet12 + cbet2 * sbet1 * sq(somg12) / (1 + comg12)
+			: sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+
+		const double ssig12 = std::hypot(salp1, calp1);
+		const double csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+		if (shortline && ssig12 < etol2)
+		{
+			salp2 = cbet1 * somg12;
+			calp2 = sbet12 - cbet1 * sbet2 * (comg12 >= 0 ? sq(somg12) / (1 + comg12) : 1 - comg12);
+			norm2(salp2, calp2);
+			sig12 = std::atan2(ssig12, csig12);
+		}
+		else if (std::abs(n) > 0.1 || csig12 >= 0 || ssig12 >= 6 * std::abs(n) * pi * sq(cbet1))
+		{
+			// The zeroth-order spherical estimate is good enough
+		}
+		else
+		{
+			// Nearly antipodal (f > 0 here): scale to the coordinates in which the
+			// antipode is the origin and the singular point is (-1, 0)
+			const double lam12x = std::atan2(-slam12, -clam12);	// lam12 - pi
+			const double k2 = sq(sbet1) * ep2;
+			const double eps = k2 / (2 * (1 + std::sqrt(1 + k2)) + k2);
+			const double lamscale = f * cbet1 * A3f(eps) * pi;
+			const double betscale = lamscale * cbet1;
+			const double x = lam12x / lamscale;
+			const double y = sbet12a / betscale;
+
+			if (y > -tol1 && x > -1 - xthresh)
+			{
+				// Strip near the cut
+				salp1 = std::min(1.0, -x);
+				calp1 = -std::sqrt(1 - sq(salp1));
+			}
+			else
+			{
+				const double k = astroid(x, y);
+				const double omg12a = lamscale * (-x * k / (1 + k));
+				somg12 = std::sin(omg12a);
+				comg12 = -std::cos(omg12a);
+				salp1 = cbet2 * somg12;
+				calp1 = sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+			}
+		}
+
+		// The reversed test lets NaN through
+		if (!(salp1 <= 0))
+		{
+			norm2(salp1, calp1);
+		}
+		else
+		{
+			salp1 = 1;
+			calp1 = 0;
+		}
+		return sig12;
+	}
+
+	double GeodesicSolver::lambda12(double sbet1, double cbet1, double dn1,
+		double sbet2, double cbet2, double dn2,
+		double salp1, double calp1, double slam120, double clam120,
+		double& salp2, double& calp2, double& sig12,
+		double& ssig1, double& csig1, double& ssig2, double& csig2,
+		double& eps, bool diffp, double& dlam12) const noexcept
+	{
+		if (sbet1 == 0 && calp1 == 0)
+		{
+			// Break the degeneracy of the equatorial line, handled elsewhere
+			calp1 = -tiny;
+		}
+
+		// sin(alp0) = sin(alp1) cos(bet1)
+		const double salp0 = salp1 * cbet1;
+		const double calp0 = std::hypot(calp1, salp1 * sbet1);
+
+		// tan(bet1) = tan(sig1) cos(alp1), tan(omg1) = sin(alp0) tan(sig1)
+		ssig1 = sbet1;
+		const double somg1 = salp0 * sbet1;
+		csig1 = calp1 * cbet1;
+		const double comg1 = csig1;
+		norm2(ssig1, csig1);
+
+		// Enforce the symmetries of |bet2| == -bet1, where Newton's method
+		// would otherwise meet singularities
+		salp2 = cbet2 != cbet1 ? salp0 / cbet2 : salp1;
+		calp2 = cbet2 != cbet1 || std::abs(sbet2) != -sbet1
+			? std::sqrt(sq(calp1 * cbet1) + (cbet1 < -sbet1
+				? (cbet2 - cbet1) * (cbet1 + cbet2)
+				: (sbet1 - sbet2) * (sbet1 + sbet2))) / cbet2
+			: std::abs(calp1);
+
+		ssig2 = sbet2;
+		const double somg2 = salp0 * sbet2;
+		csig2 = calp2 * cbet2;
+		const double comg2 = csig2;
+		norm2(ssig2, csig2);
+
+		// sig12 = sig2 - sig1 and omg12 = omg2 - omg1, limited to [0, pi]
+		sig12 = std::atan2(std::max(0.0, csig1 * ssig2 - ssig1 * csig2), csig1 * csig2 + ssig1 * ssig2);
+		const double somg12 = std::max(0.0, comg1 * somg2 - somg1 * comg2);
+		const double comg12 = comg1 * comg2 + somg1 * somg2;
+		// eta = omg12 - lam120
+		const double eta = std::atan2(somg12 * clam120 - comg12 * slam120, comg12 * clam120 + somg12 * slam120);
+
+		const double k2 = sq(calp0) * ep2;
+		eps = k2 / (2 * (1 + std::sqrt(1 + k2)) + k2);
+		double Ca[nC];
+		C3f(eps, Ca);
+		const double B312 = sin_series(ssig2, csig2, Ca, nC - 1) - sin_series(ssig1, csig1, Ca, nC - 1);
+		const double domg12 = -f * A3f(eps) * salp0 * (sig12 + B312);
+
+		if (diffp)
+		{
+			if (calp2 == 0)
+			{
+				dlam12 = -2 * f1 * dn1 / sbet1;
+			}
+			else
+			{
+				lengths(eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, nullptr, &dlam12);
+				dlam12 *= f1 / (calp2 * cbet2);
+			}
+		}
+		// lambda12(alp1) - lam120, the residual of the Newton iteration
+		return eta + domg12;
+	}
+
+	GeodesicSolver::Site GeodesicSolver::site(const LL& p) const noexcept
+	{
+		Site s{ ang_round(p.lat), p.lon, 0.0, 0.0, 0.0 };
+		sin_cos(s.lat, s.sbet, s.cbet);
+		s.sbet *= f1;
+		// cbet = +epsilon at the poles
+		norm2(s.sbet, s.cbet);
+		s.cbet = std::max(tiny, s.cbet);
+		s.dn = std::sqrt(1 + ep2 * sq(s.sbet));
+		return s;
+	}
+
+	GeodesicInverse GeodesicSolver::solve(const Site& p1, const Site& p2) const noexcept
+	{
+		if (std::isnan(f))
+		{
+			const double nan = std::numeric_limits<double>::quiet_NaN();
+			return GeodesicInverse{ nan, nan, nan };
+		}
+
+		// Bring the problem to the canonical form
+		//   0 <= lam12 <= pi, -pi/2 <= lat1 <= -0, lat1 <= lat2 <= -lat1
+		// remembering the signs to undo it on the azimuths
+		double lam12 = std::remainder(p2.lon - p1.lon, 2 * pi);
+		int lonsign = std::signbit(lam12) ? -1 : 1;
+		lam12 *= lonsign;
+		double slam12, clam12;
+		sin_cos(lam12, slam12, clam12);
+
+		const Site* q1 = &p1;
+		const Site* q2 = &p2;
+		const int swapp = std::abs(p1.lat) < std::abs(p2.lat) || std::isnan(p2.lat) ? -1 : 1;
+		if (swapp < 0)
+		{
+			lonsign *= -1;
+			std::swap(q1, q2);
+		}
+		const int latsign = std::signbit(q1->lat) ? 1 : -1;
+		const double lat1 = q1->lat * latsign;
+		double sbet1 = q1->sbet * latsign, cbet1 = q1->cbet;
+		double sbet2 = q2->sbet * latsign, cbet2 = q2->cbet;
+		const double dn1 = q1->dn, dn2 = q2->dn;
+
+		// If cbet1 < -sbet1, cbet2 - cbet1 measures |bet1| - |bet2| well,
+		// otherwise |sbet2| + sbet1 does; where the measure vanishes force
+		// bet2 = +/-bet1 exactly (Lambda12 relies on it)
+		if (cbet1 < -sbet1)
+		{
+			if (cbet2 == cbet1)
+			{
+				sbet2 = std::copysign(sbet1, sbet2);
+			}
+		}
+		else if (std::abs(sbet2) == -sbet1)
+		{
+			cbet2 = cbet1;
+		}
+
+		double s12x = 0, m12x = 0, sig12 = 0;
+		double salp1 = 0, calp1 = 0, salp2 = 0, calp2 = 0;
+		bool meridian = lat1 == -0.5 * pi || slam12 == 0;
+
+		if (meridian)
+		{
+			// Both ends lie on one full meridian; the geodesic might follow it
+			calp1 = clam12; salp1 = slam12;
+			calp2 = 1; salp2 = 0;
+
+			const double ssig1 = sbet1, csig1 = calp1 * cbet1;
+			const double ssig2 = sbet2, csig2 = calp2 * cbet2;
+			sig12 = std::atan2(std::max(0.0, csig1 * ssig2 - ssig1 * csig2), csig1 * csig2 + ssig1 * ssig2);
+			lengths(n, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, &s12x, &m12x);
+
+			// A meridian with sig12 > pi/2 is not a shortest path once m12 < 0
+			if (sig12 < 1 || m12x >= 0)
+			{
+				if (sig12 < 3 * tiny || (sig12 < tol0 && (s12x < 0 || m12x < 0)))
+				{
+					sig12 = m12x = s12x = 0;
+				}
+				s12x *= b;
+			}
+			else
+			{
+				meridian = false;
+			}
+		}
+
+		if (!meridian && sbet1 == 0 && (f <= 0 || pi - lam12 >= f * pi))
+		{
+			// Along the equator (sbet2 == 0 too)
+			calp1 = calp2 = 0;
+			salp1 = salp2 = 1;
+			s12x = a * lam12;
+		}
+		else if (!meridian)
+		{
+			double dnm = 0;
+			sig12 = inverse_start(sbet1, cbet1, sbet2, cbet2, lam12, slam12, clam12,
+				salp1, calp1, salp2, calp2, dnm);
+
+			if (sig12 >= 0)
+			{
+				// Short line, solved directly by the start estimate
+				s12x = sig12 * b * dnm;
+			}
+			else
+			{
+				// Newton's method on lambda12(alp1) - lam12, which has exactly one
+				// root in (0, pi) with positive slope there. A bracket (alp1a,
+				// alp1b) is kept and bisected whenever a Newton step misbehaves.
+				double ssig1 = 0, csig1 = 0, ssig2 = 0, csig2 = 0, eps = 0;
+				double salp1a = tiny, calp1a = 1, salp1b = tiny, calp1b = -1;
+				bool tripn = false, tripb = false;
+				for (unsigned numit = 0;; ++numit)
+				{
+					double dv = 0;
+					const double v = lambda12(sbet1, cbet1, dn1, sbet2, cbet2, dn2, salp1, calp1,
+						slam12, clam12, salp2, calp2, sig12, ssig1, csig1, ssig2, csig2,
+						eps, numit < maxit1, dv);
+					// The reversed test allows escape with NaN
+					if (tripb || !(std::abs(v) >= (tripn ? 8 : 1) * tol0) || numit == maxit2)
+					{
+						break;
+					}
+					if (v > 0 && (numit > maxit1 || calp1 / salp1 > calp1b / salp1b))
+					{
+						salp1b = salp1; calp1b = calp1;
+					}
+					else if (v < 0 && (numit > maxit1 || calp1 / salp1 < calp1a / salp1a))
+					{
+						salp1a = salp1; calp1a = calp1;
+					}
+					if (numit < maxit1 && dv > 0)
+					{
+						const double dalp1 = -v / dv;
+						if (std::abs(dalp1) < pi)
+						{
+							const double sdalp1 = std::sin(dalp1), cdalp1 = std::cos(dalp1);
+							const double nsalp1 = salp1 * cdalp1 + calp1 * sdalp1;
+							if (nsalp1 > 0)
+							{
+								calp1 = calp1 * cdalp1 - salp1 * sdalp1;
+								salp1 = nsalp1;
+								norm2(salp1, calp1);
+								// Where the slope tends to zero convergence is only
+								// linear, so test against epsilon rather than its root
+								tripn = std::abs(v) <= 16 * tol0;
+								continue;
+							}
+						}
+					}
+					salp1 = (salp1a + salp1b) / 2;
+					calp1 = (calp1a + calp1b) / 2;
+					norm2(salp1, calp1);
+					tripn = false;
+					tripb = std::abs(salp1a - salp1) + (calp1a - calp1) < tolb
+						|| std::abs(salp1 - salp1b) + (calp1 - calp1b) < tolb;
+				}
+				lengths(eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, &s12x, nullptr);
+				s12x *= b;
+			}
+		}
+
+		// Undo the canonical transformation on the azimuths
+		if (swapp < 0)
+		{
+			std::swap(salp1, salp2);
+			std::swap(calp1, calp2);
+		}
+		salp1 *= swapp * lonsign; calp1 *= swapp * latsign;
+		salp2 *= swapp * lonsign; calp2 *= swapp * latsign;
+
+		return GeodesicInverse{
+			0.0 + s12x,
+			std::atan2(salp1, calp1),
+			std::atan2(salp2, calp2)
+		};
+	}
+
+	GeodesicInverse GeodesicSolver::inverse(const LL& p1, const LL& p2) const noexcept
+	{
+		return solve(site(p1), site(p2));
+	}
+
+	GeodesicDirect GeodesicSolver::direct(const LL& p1, double azi1, double s12) const noexcept
+	{
+		return GeodesicLine(*this, p1, azi1).position(s12);
+	}
+
+	void GeodesicSolver::inverse(std::span<const LL> p1, std::span<const LL> p2,
+		std::span<GeodesicInverse> out) const noexcept
+	{
+		assert(p1.size() == p2.size() && p1.size() == out.size());
+		for (size_t i = 0; i < out.size(); ++i)
+		{
+			out[i] = solve(site(p1[i]), site(p2[i]));
+		}
+	}
+
+	void GeodesicSolver::distances(std::span<const LL> from, std::span<const LL> to,
+		std::span<double> out) const
+	{
+		assert(out.size() == from.size() * to.size());
+		const size_t cols = to.size();
+		std::vector<Site> rows(from.size());
+		std::transform(from.begin(), from.end(), rows.begin(), [this](const LL& p) { return site(p); });
+
+		if (from.data() == to.data() && from.size() == to.size())
+		{
+			for (size_t i = 0; i < rows.size(); ++i)
+			{
+				out[i * cols + i] = 0.0;
+				for (size_t j = i + 1; j < cols; ++j)
+				{
+					out[i * cols + j] = out[j * cols + i] = solve(rows[i], rows[j]).s12;
+				}
+			}
+			return;
+		}
+
+		std::vector<Site> columns(cols);
+		std::transform(to.begin(), to.end(), columns.begin(), [this](const LL& p) { return site(p); });
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			for (size_t j = 0; j < cols; ++j)
+			{
+				out[i * cols + j] = solve(rows[i], columns[j]).s12;
+			}
+		}
+	}
+
+	GeodesicLine::GeodesicLine(const GeodesicSolver& g, const LL& p1, double azi1)
+		: f(g.f), b(g.b), f1(g.f1), lat1(p1.lat), lon1(p1.lon), azi1(azi1)
+	{
+		double salp1, calp1, sbet1, cbet1;
+		sin_cos(ang_round(azi1), salp1, calp1);
+		sin_cos(ang_round(lat1), sbet1, cbet1);
+		sbet1 *= f1;
+		norm2(sbet1, cbet1);
+		cbet1 = std::max(tiny, cbet1);
+
+		// sin(alp0) = sin(alp1) cos(bet1); the hypot form of cos(alp0) stays
+		// accurate for salp1 = 0
+		salp0 = salp1 * cbet1;
+		calp0 = std::hypot(calp1, salp1 * sbet1);
+
+		// sig = 0 is the nearest northward crossing of the equator;
+		// tan(bet1) = tan(sig1) cos(alp1), tan(omg1) = sin(alp0) tan(sig1)
+		ssig1 = sbet1;
+		somg1 = salp0 * sbet1;
+		csig1 = comg1 = sbet1 != 0 || calp1 != 0 ? cbet1 * calp1 : 1;
+		norm2(ssig1, csig1);
+
+		k2 = sq(calp0) * g.ep2;
+		const double eps = k2 / (2 * (1 + std::sqrt(1 + k2)) + k2);
+
+		A1m1 = A1m1f(eps);
+		C1f(eps, C1a);
+		B11 = sin_series(ssig1, csig1, C1a, nC);
+		const double s = std::sin(B11), c = std::cos(B11);
+		// tau1 = sig1 + B11
+		stau1 = ssig1 * c + csig1 * s;
+		ctau1 = csig1 * c - ssig1 * s;
+		C1pf(eps, C1pa);
+
+		A3c = -f * salp0 * g.A3f(eps);
+		g.C3f(eps, C3a);
+		B31 = sin_series(ssig1, csig1, C3a, nC - 1);
+	}
+
+	GeodesicDirect GeodesicLine::position(double s12) const noexcept
+	{
+		// Distance to arc length through the reverted series
+		const double tau12 = s12 / (b * (1 + A1m1));
+		const double st = std::sin(tau12), ct = std::cos(tau12);
+		double B12 = -sin_series(stau1 * ct + ctau1 * st, ctau1 * ct - stau1 * st, C1pa, nC);
+		double sig12 = tau12 - (B12 - B11);
+		double ssig12 = std::sin(sig12), csig12 = std::cos(sig12);
+		if (std::abs(f) > 0.01)
+		{
+			// The reverted series loses accuracy beyond |f| = 1/100; one
+			// Newton step on the forward series restores it
+			const double ssig2 = ssig1 * csig12 + csig1 * ssig12;
+			const double csig2 = csig1 * csig12 - ssig1 * ssig12;
+			B12 = sin_series(ssig2, csig2, C1a, nC);
+			const double serr = (1 + A1m1) * (sig12 + (B12 - B11)) - s12 / b;
+			sig12 -= serr / std::sqrt(1 + k2 * sq(ssig2));
+			ssig12 = std::sin(sig12);
+			csig12 = std::cos(sig12);
+		}
+
+		// sig2 = sig1 + sig12
+		const double ssig2 = ssig1 * csig12 + csig1 * ssig12;
+		double csig2 = csig1 * csig12 - ssig1 * ssig12;
+		// sin(bet2) = cos(alp0) sin(sig2)
+		const double sbet2 = calp0 * ssig2;
+		double cbet2 = std::hypot(salp0, calp0 * csig2);
+		if (cbet2 == 0)
+		{
+			// salp0 = 0 and csig2 = 0: break the degeneracy
+			cbet2 = csig2 = tiny;
+		}
+		// tan(alp0) = cos(sig2) tan(alp2)
+		const double salp2 = salp0, calp2 = calp0 * csig2;
+
+		// tan(omg2) = sin(alp0) tan(sig2), omg12 = omg2 - omg1
+		const double somg2 = salp0 * ssig2, comg2 = csig2;
+		const double omg12 = std::atan2(somg2 * comg1 - comg2 * somg1, comg2 * comg1 + somg2 * somg1);
+		const double lam12 = omg12 + A3c * (sig12 + (sin_series(ssig2, csig2, C3a, nC - 1) - B31));
+
+		return GeodesicDirect{
+			LL{
+				std::atan2(sbet2, f1 * cbet2),
+				std::remainder(std::remainder(lon1, 2 * pi) + lam12, 2 * pi)
+			},
+			std::atan2(salp2, calp2)
+		};
+	}
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <S2LL/Core/Regions.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		/// Angle between two directions, accurate at both ends of [0, pi]
+		inline double angle(const E3& x, const E3& y) noexcept
+		{
+			return std::atan2(x.cross(y).mag(), x.dot(y));
+		}
+
+		/// Geodetic coordinates of the surface point on the ray of p. Radial
+		/// scaling keeps z / rho, and on the surface tan(lat) = (a / c)^2 z / rho.
+		inline LL geodetic(const Ellipsoid& e, const E3& p) noexcept
+		{
+			const double a = e.major(), c = e.minor();
+			return LL{ std::atan2(a * a * p.z, c * c * std::hypot(p.x, p.y)), std::atan2(p.y, p.x) };
+		}
+
+		/// Surface point with the given geodetic coordinates
+		inline E3 image(const Ellipsoid& e, const LL& ll) noexcept
+		{
+			return e.to_E3<Precision::Fast>(LLH{ ll.lat, ll.lon, 0.0 });
+		}
+	}
+
+	GeodesicArcFrame::GeodesicArcFrame(const GeodesicArc& arc)
+		: surface(arc.surface)
+	{
+		if (!surface.is_sphere())
+		{
+			owned = std::make_shared<const GeodesicSolver>(surface);
+			solver = owned.get();
+		}
+		init(arc);
+	}
+
+	GeodesicArcFrame::GeodesicArcFrame(const GeodesicArc& arc, const GeodesicSolver& g)
+		: surface(arc.surface)
+	{
+		if (!surface.is_sphere())
+		{
+			solver = &g;
+		}
+		init(arc);
+	}
+
+	void GeodesicArcFrame::init(const GeodesicArc& arc)
+	{
+		if (surface.is_sphere())
+		{
+			radius = surface.major();
+			u = arc.a.normalized();
+			const E3 v = arc.b.normalized();
+			const E3 c = v - u * u.dot(v);
+			const double m = c.mag();
+			w = m > 0.0 ? c * (1.0 / m) : E3{ 0.0, 0.0, 0.0 };
+			theta = angle(u, v);
+			s12 = radius * theta;
+			pa = u * radius;
+			pb = v * radius;
+			return;
+		}
+
+		radius = 0.0;
+		theta = 0.0;
+		const LL la = geodetic(surface, arc.a);
+		const LL lb = geodetic(surface, arc.b);
+		const GeodesicInverse inv = solver->inverse(la, lb);
+		s12 = inv.s12;
+		line.emplace(*solver, la, inv.azi1);
+		pa = image(surface, la);
+		pb = image(surface, lb);
+	}
+
+	E3 GeodesicArcFrame::at_distance(double s) const noexcept
+	{
+		if (radius > 0.0)
+		{
+			const double t = s / radius;
+			return (u * std::cos(t) + w * std::sin(t)) * radius;
+		}
+		return image(surface, line->position(s).ll2);
+	}
+
+	ArcProjection GeodesicArcFrame::closest(const E3& p) const noexcept
+	{
+		if (radius > 0.0)
+		{
+			// Project onto the plane of the great circle; the foot lies on the
+			// arc when its angle from a is within [0, theta], otherwise the
+			// nearer endpoint wins
+			const E3 q = p.normalized();
+			const E3 n = u.cross(w);
+			const E3 foot = q - n * q.dot(n);
+			const double t = std::atan2(foot.dot(w), foot.dot(u));
+			if (foot.mag() > 0.0 && t >= 0.0 && t <= theta)
+			{
+				const E3 x = u * std::cos(t) + w * std::sin(t);
+				return ArcProjection{ x * radius, radius * t, radius * angle(q, x) };
+			}
+			const double da = angle(q, pa), db = angle(q, pb);
+			return da <= db
+				? ArcProjection{ pa, 0.0, radius * da }
+				: ArcProjection{ pb, s12, radius * db };
+		}
+
+		// The distance d(s) from p to the line point X(s) has derivative
+		// cos(alpha(s) - beta(s)), where alpha is the azimuth of the line at X
+		// and beta that of the geodesic from p arriving at X. An interior
+		// minimum is a sign change of that derivative from - to +.
+		const LL lp = geodetic(surface, p);
+		struct Probe
+		{
+			LL ll;
+			double slope, distance;
+		};
+		const auto probe = [&](double s) {
+			const GeodesicDirect x = line->position(s);
+			const GeodesicInverse r = solver->inverse(lp, x.ll2);
+			return Probe{ x.ll2, std::cos(x.azi2 - r.azi2), r.s12 };
+		};
+
+		const Probe start = probe(0.0);
+		const Probe end = probe(s12);
+		ArcProjection best = start.distance <= end.distance
+			? ArcProjection{ pa, 0.0, start.distance }
+			: ArcProjection{ pb, s12, end.distance };
+		if (!(start.slope < 0.0 && end.slope > 0.0) || best.distance == 0.0)
+		{
+			return best;
+		}
+
+		// Illinois variant of regula falsi on the slope. The distance is flat
+		// at the minimum, so the root of the slope locates the foot, not the
+		// smallest distance seen.
+		double lo = 0.0, hi = s12;
+		double flo = start.slope, fhi = end.slope;
+		double s = 0.0;
+		Probe x = start;
+		int side = 0;
+		const double tol = 4.0 * DBL_EPSILON * s12;
+		for (int i = 0; i < 100 && hi - lo > tol; ++i)
+		{
+			s = (lo * fhi - hi * flo) / (fhi - flo);
+			if (!(s > lo && s < hi))
+			{
+				s = 0.5 * (lo + hi);
+			}
+			x = probe(s);
+			if (x.slope == 0.0 || x.distance == 0.0)
+			{
+				break;
+			}
+			if (x.slope < 0.0)
+			{
+				lo = s;
+				flo = x.slope;
+				if (side == -1)
+				{
+					fhi *= 0.5;
+				}
+				side = -1;
+			}
+			else
+			{
+				hi = s;
+				fhi = x.slope;
+				if (side == 1)
+				{
+					flo *= 0.5;
+				}
+				side = 1;
+			}
+		}
+		if (x.distance <= best.distance)
+		{
+			best = ArcProjection{ image(surface, x.ll), s, x.distance };
+		}
+		return best;
+	}
+}
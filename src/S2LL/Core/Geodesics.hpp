@@ -0,0 +1,143 @@
+#pragma once
+
+// References:
+// Karney, C. F. F. (2013). Algorithms for geodesics. Journal of Geodesy, 87(1), 43-55. https://doi.org/10.1007/s00190-012-0578-z
+
+#include <S2LL/Core/Coordinates.hpp>
+#include <S2LL/Core/Surfaces.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace S2LL
+{
+	class GeodesicSolver;
+
+	/// Solution of the inverse geodesic problem: the distance, in the unit of
+	/// the ellipsoid, and the forward azimuths at both ends (radians,
+	/// clockwise from north)
+	struct GeodesicInverse
+	{
+		double s12;
+		double azi1;
+		double azi2;
+	};
+
+	/// Solution of the direct geodesic problem: the end point and the forward
+	/// azimuth there (radians, clockwise from north)
+	struct GeodesicDirect
+	{
+		LL ll2;
+		double azi2;
+	};
+
+	/// A geodesic fixed by its start point and azimuth. The series
+	/// coefficients of the line are evaluated once, so each position costs
+	/// a few trigonometric calls and three Clenshaw sums.
+	class GeodesicLine
+	{
+		static constexpr int order = 6;
+
+		double f, b, f1;
+		double lat1, lon1, azi1;
+		double salp0, calp0, k2;
+		double ssig1, csig1, somg1, comg1, stau1, ctau1;
+		double A1m1, B11, A3c, B31;
+		double C1a[order + 1], C1pa[order + 1], C3a[order];
+
+	public:
+		/// Prepares the geodesic through p1 with forward azimuth azi1
+		GeodesicLine(const GeodesicSolver& g, const LL& p1, double azi1);
+
+		/// Position and forward azimuth at signed distance s12 from the start
+		GeodesicDirect position(double s12) const noexcept;
+
+		/// Start point of the line
+		inline LL origin() const noexcept { return LL{ lat1, lon1 }; }
+
+		/// Forward azimuth at the start point
+		inline double azimuth() const noexcept { return azi1; }
+	};
+
+	/// Solver for the direct and inverse geodesic problems on an oblate
+	/// spheroid (or sphere), after Karney (2013), with sixth-order series.
+	/// The ellipsoid-dependent coefficients are cached at construction, so one
+	/// solver serves any number of queries and threads. The series truncation
+	/// error is below double round-off for |f| <= 1/100: distances are
+	/// accurate to about 15 nm on WGS 84 everywhere, including nearly
+	/// antipodal points. Angles are in radians.
+	class GeodesicSolver
+	{
+		friend class GeodesicLine;
+
+		static constexpr int order = 6;
+
+		double a, f, f1, e2, ep2, n, b, etol2;
+		double A3x[order];
+		double C3x[order][order];
+
+		/// Precomputed reduced latitude of one endpoint
+		struct Site
+		{
+			double lat, lon, sbet, cbet, dn;
+		};
+
+		Site site(const LL& p) const noexcept;
+		GeodesicInverse solve(const Site& p1, const Site& p2) const noexcept;
+
+		double A3f(double eps) const noexcept;
+		void C3f(double eps, double c[]) const noexcept;
+
+		void lengths(double eps, double sig12,
+			double ssig1, double csig1, double dn1,
+			double ssig2, double csig2, double dn2,
+			double* s12b, double* m12b) const noexcept;
+
+		double inverse_start(double sbet1, double cbet1, double sbet2, double cbet2,
+			double lam12, double slam12, double clam12,
+			double& salp1, double& calp1, double& salp2, double& calp2, double& dnm) const noexcept;
+
+		double lambda12(double sbet1, double cbet1, double dn1,
+			double sbet2, double cbet2, double dn2,
+			double salp1, double calp1, double slam120, double clam120,
+			double& salp2, double& calp2, double& sig12,
+			double& ssig1, double& csig1, double& ssig2, double& csig2,
+			double& eps, bool diffp, double& dlam12) const noexcept;
+
+	public:
+		/// Caches the series coefficients of the given surface. Triaxial and
+		/// prolate surfaces raise FE_INVALID; every query then yields NaN.
+		explicit GeodesicSolver(const Ellipsoid& e);
+
+		/// Solves the inverse problem between two points
+		GeodesicInverse inverse(const LL& p1, const LL& p2) const noexcept;
+
+		/// Shortest distance between two points
+		inline double distance(const LL& p1, const LL& p2) const noexcept
+		{
+			return inverse(p1, p2).s12;
+		}
+
+		/// Solves the direct problem: the point at distance s12 from p1 when
+		/// setting out with azimuth azi1
+		GeodesicDirect direct(const LL& p1, double azi1, double s12) const noexcept;
+
+		/// Geodesic line through p1 with azimuth azi1, for repeated positions
+		inline GeodesicLine line(const LL& p1, double azi1) const
+		{
+			return GeodesicLine(*this, p1, azi1);
+		}
+
+		/// Pairwise inverse problems: out[i] solves p1[i] -> p2[i]. All three
+		/// spans must have the same length.
+		void inverse(std::span<const LL> p1, std::span<const LL> p2,
+			std::span<GeodesicInverse> out) const noexcept;
+
+		/// Distance matrix, row-major: out[i * to.size() + j] is the distance
+		/// from from[i] to to[j]. Reduced latitudes are computed once per
+		/// site; when both spans are the same range only the upper triangle
+		/// is solved and mirrored.
+		void distances(std::span<const LL> from, std::span<const LL> to,
+			std::span<double> out) const;
+	};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace S2LL
+{
+	// Steps of the incremental 3D hull shared by convex_hull() and
+	// delaunay(). Faces are triangles with vertices v and the faces across
+	// their edges adj, edge i running from v[i] to v[i + 1]. Like Vectors.hpp,
+	// these are not part of the library interface.
+	namespace Internal
+	{
+		/// Edge ab of a face seen from a new point, with the face beyond it
+		/// that the point does not see
+		struct Horizon
+		{
+			uint32_t a, b, seen, beyond;
+		};
+
+		/// Faces seen from a point, a connected patch around the start face,
+		/// and the horizon around them. stamp(f) is the mark of face f, set
+		/// to round on every face of the patch; sees(f) tells whether the
+		/// point sees f.
+		template <typename Faces, typename Stamp, typename Sees>
+		void visible_patch(const Faces& faces, uint32_t start, uint32_t round, Stamp&& stamp, Sees&& sees,
+			std::vector<uint32_t>& stack, std::vector<uint32_t>& visible, std::vector<Horizon>& horizon)
+		{
+			visible.clear();
+			horizon.clear();
+			stack.assign(1, start);
+			stamp(start) = round;
+			while (!stack.empty())
+			{
+				const uint32_t f = stack.back();
+				stack.pop_back();
+				visible.push_back(f);
+				for (int e = 0; e < 3; ++e)
+				{
+					const uint32_t g = faces[f].adj[e];
+					if (stamp(g) == round)
+					{
+						continue;
+					}
+					if (sees(g))
+					{
+						stamp(g) = round;
+						stack.push_back(g);
+					}
+					else
+					{
+						horizon.push_back({ faces[f].v[e], faces[f].v[(e + 1) % 3], f, g });
+					}
+				}
+			}
+		}
+
+		/// The cone from a point over the horizon: make(h) adds the face
+		/// (h.a, h.b, point) across h from h.beyond and returns its index.
+		/// The cone faces are linked around the point and to the faces
+		/// beyond the horizon; cone_from is scratch indexed by vertex.
+		template <typename Faces, typename Make>
+		void build_cone(Faces& faces, const std::vector<Horizon>& horizon, Make&& make,
+			std::vector<uint32_t>& cone_from, std::vector<uint32_t>& cone)
+		{
+			cone.clear();
+			for (const Horizon& h : horizon)
+			{
+				const uint32_t f = make(h);
+				for (uint32_t& back : faces[h.beyond].adj)
+				{
+					if (back == h.seen)
+					{
+						back = f;
+					}
+				}
+				cone_from[h.a] = f;
+				cone.push_back(f);
+			}
+			for (const uint32_t f : cone)
+			{
+				faces[f].adj[1] = cone_from[faces[f].v[1]];
+				faces[faces[f].adj[1]].adj[2] = f;
+			}
+		}
+	}
+}
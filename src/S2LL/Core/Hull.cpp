@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <S2LL/Core/Horizon.hpp>
+#include <S2LL/Core/Hull.hpp>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Points per chunk below which the planar hull runs on one thread
+		constexpr size_t min_chunk = 4096;
+
+		constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+		inline E3 difference(const E3& a, const E3& b) noexcept
+		{
+			return E3{ a.x - b.x, a.y - b.y, a.z - b.z };
+		}
+
+		/// Andrew's monotone chain over the given point indices, which it
+		/// sorts: the hull vertices, counterclockwise. The points come in
+		/// order of their gnomonic coordinate along the direction whose cross
+		/// product with the hemisphere center is n, decided by orient(a, b, n).
+		std::vector<uint32_t> monotone_chain(const std::vector<E3>& u, std::vector<uint32_t>& ids, const E3& n)
+		{
+			std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+				return orient(u[a], u[b], n) < 0;
+			});
+			ids.erase(std::unique(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+				return same(u[a], u[b]);
+			}), ids.end());
+			const size_t m = ids.size();
+			if (m < 3)
+			{
+				return ids;
+			}
+
+			std::vector<uint32_t> hull(2 * m);
+			size_t k = 0;
+			const auto push = [&](uint32_t i, size_t floor) {
+				while (k >= floor && orient(u[hull[k - 2]], u[hull[k - 1]], u[i]) <= 0)
+				{
+					--k;
+				}
+				hull[k++] = i;
+			};
+			for (size_t i = 0; i < m; ++i)
+			{
+				push(ids[i], 2);
+			}
+			const size_t lower = k + 1;
+			for (size_t i = m - 1; i-- > 0;)
+			{
+				push(ids[i], lower);
+			}
+			hull.resize(k - 1);
+			return hull;
+		}
+
+		/// Triangle of the 3D hull with the faces across its edges: edge i
+		/// runs from v[i] to v[i + 1]
+		struct Face
+		{
+			std::array<uint32_t, 3> v;
+			std::array<uint32_t, 3> adj{ none, none, none };
+			std::vector<uint32_t> outside;
+			uint32_t visited = 0;
+			bool dead = false;
+		};
+	}
+
+	GP<> convex_hull(std::span<const E3> points, unsigned threads)
+	{
+		GP<> out;
+		const size_t n = points.size();
+		if (n == 0)
+		{
+			return out;
+		}
+		std::vector<E3> u(n);
+		std::transform(points.begin(), points.end(), u.begin(), unit);
+		const std::optional<E3> h = hemisphere(u);
+		if (!h)
+		{
+			return out;
+		}
+		const E3 n_dir = plain_cross(unit(ref_dir(*h)), *h);
+
+		// Hulls of the chunks, in parallel, then the hull of their vertices
+		if (threads == 0)
+		{
+			threads = default_threads();
+		}
+		const size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, n / min_chunk));
+		std::vector<std::vector<uint32_t>> parts(chunks);
+		parallel_for(chunks, [&](size_t begin, size_t end) {
+			for (size_t c = begin; c < end; ++c)
+			{
+				std::vector<uint32_t> ids(n * (c + 1) / chunks - n * c / chunks);
+				std::iota(ids.begin(), ids.end(), static_cast<uint32_t>(n * c / chunks));
+				parts[c] = monotone_chain(u, ids, n_dir);
+			}
+		}, threads, 1);
+
+		std::vector<uint32_t> ids;
+		for (const std::vector<uint32_t>& part : parts)
+		{
+			ids.insert(ids.end(), part.begin(), part.end());
+		}
+		const std::vector<uint32_t> hull = chunks == 1 ? parts[0] : monotone_chain(u, ids, n_dir);
+		out.boundary.vertices.reserve(hull.size());
+		for (const uint32_t i : hull)
+		{
+			out.boundary.vertices.push_back(points[i]);
+		}
+		return out;
+	}
+
+	std::vector<std::array<uint32_t, 3>> convex_hull_3d(std::span<const E3> points)
+	{
+		std::vector<std::array<uint32_t, 3>> out;
+		const uint32_t n = static_cast<uint32_t>(points.size());
+		if (n < 4)
+		{
+			return out;
+		}
+
+		// Initial tetrahedron: two far apart points, the point farthest
+		// from their line, then any point off their plane
+		uint32_t i0 = 0;
+		for (uint32_t i = 1; i < n; ++i)
+		{
+			if (points[i].x < points[i0].x)
+			{
+				i0 = i;
+			}
+		}
+		const auto farthest = [&](auto&& measure) {
+			uint32_t best = none;
+			double best_value = 0.0;
+			for (uint32_t i = 0; i < n; ++i)
+			{
+				const double value = measure(points[i]);
+				if (value > best_value)
+				{
+					best = i;
+					best_value = value;
+				}
+			}
+			return best;
+		};
+		uint32_t i1 = farthest([&](const E3& p) {
+			const E3 d = difference(p, points[i0]);
+			return plain_dot(d, d);
+		});
+		if (i1 == none)
+		{
+			return out;
+		}
+		const E3 axis = difference(points[i1], points[i0]);
+		uint32_t i2 = farthest([&](const E3& p) {
+			const E3 c = plain_cross(axis, difference(p, points[i0]));
+			return plain_dot(c, c);
+		});
+		if (i2 == none)
+		{
+			return out;
+		}
+		uint32_t i3 = farthest([&](const E3& p) {
+			return std::abs(plain_dot(plain_cross(axis, difference(points[i2], points[i0])), difference(p, points[i0])));
+		});
+		if (i3 == none || orient3d(points[i0], points[i1], points[i2], points[i3]) == 0)
+		{
+			// Rounding may hide the last point off the plane
+			i3 = none;
+			for (uint32_t i = 0; i < n && i3 == none; ++i)
+			{
+				if (orient3d(points[i0], points[i1], points[i2], points[i]) != 0)
+				{
+					i3 = i;
+				}
+			}
+			if (i3 == none)
+			{
+				return out;
+			}
+		}
+		if (orient3d(points[i0], points[i1], points[i2], points[i3]) > 0)
+		{
+			std::swap(i1, i2);
+		}
+
+		// The fourth point is below the first face; the others follow
+		std::vector<Face> faces(4);
+		faces[0].v = { i0, i1, i2 };
+		faces[1].v = { i0, i3, i1 };
+		faces[2].v = { i1, i3, i2 };
+		faces[3].v = { i2, i3, i0 };
+		faces[0].adj = { 1, 2, 3 };
+		faces[1].adj = { 3, 2, 0 };
+		faces[2].adj = { 1, 3, 0 };
+		faces[3].adj = { 2, 1, 0 };
+
+		const auto sees = [&](const Face& f, uint32_t p) {
+			return orient3d(points[f.v[0]], points[f.v[1]], points[f.v[2]], points[p]) > 0;
+		};
+		for (uint32_t p = 0; p < n; ++p)
+		{
+			if (p == i0 || p == i1 || p == i2 || p == i3)
+			{
+				continue;
+			}
+			for (Face& f : faces)
+			{
+				if (sees(f, p))
+				{
+					f.outside.push_back(p);
+					break;
+				}
+			}
+		}
+
+		std::vector<uint32_t> pending{ 0, 1, 2, 3 };
+		std::vector<uint32_t> visible, stack, cone;
+		std::vector<Horizon> horizon;
+		// The cone faces by the first vertex of their horizon edge
+		std::vector<uint32_t> cone_from(n, none);
+		uint32_t round = 0;
+		while (!pending.empty())
+		{
+			const uint32_t start = pending.back();
+			pending.pop_back();
+			if (faces[start].dead || faces[start].outside.empty())
+			{
+				continue;
+			}
+
+			// The point farthest from the face (in double: any point outside
+			// is correct, the farthest keeps the hull small along the way)
+			const Face& f0 = faces[start];
+			const E3& a = points[f0.v[0]];
+			const E3 normal = plain_cross(difference(points[f0.v[1]], a), difference(points[f0.v[2]], a));
+			uint32_t apex = f0.outside[0];
+			double apex_distance = -1.0;
+			for (const uint32_t p : f0.outside)
+			{
+				const double d = plain_dot(normal, difference(points[p], a));
+				if (d > apex_distance)
+				{
+					apex = p;
+					apex_distance = d;
+				}
+			}
+
+			// Faces seen from the apex, a connected patch around the start
+			++round;
+			visible_patch(faces, start, round, [&](uint32_t fi) -> uint32_t& { return faces[fi].visited; },
+				[&](uint32_t fi) { return sees(faces[fi], apex); }, stack, visible, horizon);
+
+			// The cone from the apex over the horizon
+			build_cone(faces, horizon, [&](const Horizon& h) {
+				const uint32_t fi = static_cast<uint32_t>(faces.size());
+				Face& f = faces.emplace_back();
+				f.v = { h.a, h.b, apex };
+				f.adj[0] = h.beyond;
+				return fi;
+			}, cone_from, cone);
+
+			// Outside points of the removed faces move to the cone
+			for (const uint32_t fi : visible)
+			{
+				faces[fi].dead = true;
+				for (const uint32_t p : faces[fi].outside)
+				{
+					if (p == apex)
+					{
+						continue;
+					}
+					for (const uint32_t c : cone)
+					{
+						if (sees(faces[c], p))
+						{
+							faces[c].outside.push_back(p);
+							break;
+						}
+					}
+				}
+				std::vector<uint32_t>().swap(faces[fi].outside);
+			}
+			for (const uint32_t c : cone)
+			{
+				if (!faces[c].outside.empty())
+				{
+					pending.push_back(c);
+				}
+			}
+		}
+
+		for (const Face& f : faces)
+		{
+			if (!f.dead)
+			{
+				out.push_back(f.v);
+			}
+		}
+		return out;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+// References:
+// Andrew, A. M. (1979). Another efficient algorithm for convex hulls in two dimensions. Information Processing Letters, 9(5), 216-219. https://doi.org/10.1016/0020-0190(79)90072-3
+// Barber, C. B., Dobkin, D. P., & Huhdanpaa, H. (1996). The quickhull algorithm for convex hulls. ACM Transactions on Mathematical Software, 22(4), 469-483. https://doi.org/10.1145/235815.235821
+// Chan, T. M. (1996). Optimal output-sensitive convex hull algorithms in two and three dimensions. Discrete & Computational Geometry, 16(4), 361-368. https://doi.org/10.1007/BF02712873
+
+#include <S2LL/Core/Regions.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Spherical convex hull of directions that lie in an open hemisphere:
+	/// the smallest convex spherical polygon containing them, counterclockwise
+	/// seen from outside, its vertices taken from the input. Points need not
+	/// be unit vectors; duplicates are dropped.
+	///
+	/// A hemisphere holding the points is found first (perceptron updates
+	/// from their mean direction); the hull is empty when none turns up,
+	/// which is also the answer for points spread beyond a hemisphere. In that
+	/// hemisphere, great circles behave as lines of the gnomonic projection,
+	/// so Andrew's monotone chain applies with orient as the turn test and
+	/// with points ordered exactly along a fixed direction by orient as well.
+	/// The points are split into up to `threads` (0: one per hardware
+	/// thread) chunks whose hulls are computed in parallel; the hull of their
+	/// vertices is the result.
+	GP<> convex_hull(std::span<const E3> points, unsigned threads = 1);
+
+	/// Convex hull in E3 of points on (or near) the sphere: triangles of
+	/// indices into `points`, counterclockwise seen from outside. Empty when
+	/// all points are coplanar or fewer than four.
+	///
+	/// Quickhull: every face keeps the points outside it; the farthest point
+	/// of a face is added by removing the faces it sees and joining it to
+	/// their horizon. Visibility is decided by orient3d, exactly, so a point
+	/// coplanar with a face does not see it and coplanar points give flat
+	/// pairs of triangles rather than merged faces. Distinct unit vectors
+	/// are all hull vertices, save points so close (about 1e-8 rad) that
+	/// rounding off the sphere puts one inside, and the hull of unit vectors
+	/// is their spherical Delaunay triangulation.
+	std::vector<std::array<uint32_t, 3>> convex_hull_3d(std::span<const E3> points);
+}
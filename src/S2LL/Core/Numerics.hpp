@@ -18,6 +18,18 @@
 
 namespace S2LL
 {
+	// Precision-policy tags: select the arithmetic of batch kernels. Fast runs
+	// plain double loops the compiler can vectorize; Accurate carries every
+	// product and sum in Double and rounds once per output component.
+	namespace Precision
+	{
+		// Plain double arithmetic
+		struct Fast;
+
+		// Extended-precision (double-double) arithmetic
+		struct Accurate;
+	}
+
 	struct Double
 	{
 		double hi;
@@ -202,20 +214,22 @@ namespace S2LL
 		}
 	}
 
-	/// Double-double addition
+	/// Double-double addition. The result is renormalized with Two-Sum so
+	/// that cancellation (a.hi == -b.hi) cannot leave a zero high component
+	/// beside a nonzero low one; otherwise it equals the unrenormalized sum.
 	inline Double Add(const Double& a, const Double& b)
 	{
 		Double s = Double::twoSum(a.hi, b.hi);
-		return Double::make(s.hi, s.lo + a.lo + b.lo);
+		return Double::twoSum(s.hi, s.lo + a.lo + b.lo);
 	}
 
-	/// Double-double subtraction
+	/// Double-double subtraction, renormalized like Add
 	inline Double Sub(const Double& a, const Double& b)
 	{
 		double d = a.hi - b.hi;
 		double q_virt = a.hi - d;
 		double d_lo = q_virt - b.hi;
-		return Double::make(d, (d_lo - b.lo) + a.lo);
+		return Double::twoSum(d, (d_lo - b.lo) + a.lo);
 	}
 
 	/// Double-double multiplication
@@ -0,0 +1,482 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <S2LL/Core/Area.hpp>
+#include <S2LL/Core/Containment.hpp>
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/Overlay.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Angular padding of the edge caps tested against the ring caps
+		constexpr double cap_padding = 1e-10;
+
+		/// Angle within which a vertex of one operand lies on a vertex or an
+		/// edge of the other, far above the rounding of coordinates computed
+		/// separately for a shared boundary
+		constexpr double node_tolerance = 1e-12;
+
+		constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+		/// True if the minor arc ab may meet the cap
+		bool overlaps(const Cap& cap, const E3& a, const E3& b) noexcept
+		{
+			if (cap.is_full())
+			{
+				return true;
+			}
+			const E3 u = unit(a), v = unit(b);
+			const E3 mid = unit(E3{ u.x + v.x, u.y + v.y, u.z + v.z });
+			return angle(cap.axis, mid) <= cap.radius() + 0.5 * angle(u, v) + cap_padding;
+		}
+
+		/// One operand: its rings oriented around their own interiors (the
+		/// smaller side when it fits in a hemisphere), each with its bounding
+		/// cap and edge hierarchy, and whether the interior of the operand
+		/// lies to the right of the ring (holes)
+		struct Operand
+		{
+			std::vector<std::vector<E3>> rings;
+			std::vector<Cap> caps;
+			std::vector<EdgeBVH> bvhs;
+			std::vector<bool> flipped;
+			// Global number of the first edge of each ring, plus the total
+			std::vector<size_t> edge_offsets{ 0 };
+
+			explicit Operand(const Compound<GP<>>& region)
+			{
+				for (const GP<>& poly : region.polygons)
+				{
+					if (poly.size() < 3)
+					{
+						continue;
+					}
+					std::vector<E3> ring(poly.boundary.vertices.begin(), poly.boundary.vertices.end());
+					PreparedPolygon prepared{ LoopView<E3>(ring) };
+					if (prepared.cap().is_full())
+					{
+						// The smaller side of a ring fitting in a hemisphere
+						// is its interior, as in RegionIndex
+						std::vector<E3> reversed(ring.rbegin(), ring.rend());
+						PreparedPolygon flipped{ LoopView<E3>(reversed) };
+						if (!flipped.cap().is_full())
+						{
+							ring = std::move(reversed);
+							prepared = std::move(flipped);
+						}
+					}
+					caps.push_back(prepared.cap());
+					bvhs.emplace_back(LoopView<E3>(ring));
+					edge_offsets.push_back(edge_offsets.back() + ring.size());
+					rings.push_back(std::move(ring));
+				}
+
+				// Near a ring lying inside an odd number of the other rings,
+				// the region is on the outer side of the ring
+				flipped.assign(rings.size(), false);
+				for (size_t r = 0; r < rings.size(); ++r)
+				{
+					const E3 mid = unit(rings[r][0]) + unit(rings[r][1]);
+					for (size_t s = 0; s < rings.size(); ++s)
+					{
+						if (s != r && caps[s].contains(mid) && bvhs[s].contains(mid))
+						{
+							flipped[r] = !flipped[r];
+						}
+					}
+				}
+			}
+
+			bool contains(const E3& p) const
+			{
+				bool inside = false;
+				for (size_t r = 0; r < rings.size(); ++r)
+				{
+					inside ^= caps[r].contains(p) && bvhs[r].contains(p);
+				}
+				return inside;
+			}
+		};
+
+		/// Vertices and crossing points, numbered by their exact coordinates
+		class Nodes
+		{
+			struct Hash
+			{
+				size_t operator()(const std::array<uint64_t, 3>& k) const noexcept
+				{
+					uint64_t h = k[0] * 0x9E3779B97F4A7C15ull;
+					h = (h ^ (h >> 29) ^ k[1]) * 0xBF58476D1CE4E5B9ull;
+					h = (h ^ (h >> 32) ^ k[2]) * 0x94D049BB133111EBull;
+					return static_cast<size_t>(h ^ (h >> 31));
+				}
+			};
+
+			std::unordered_map<std::array<uint64_t, 3>, uint32_t, Hash> ids;
+
+		public:
+			std::vector<E3> points;
+
+			uint32_t id(const E3& p)
+			{
+				const auto [it, inserted] = ids.try_emplace(key(p), static_cast<uint32_t>(points.size()));
+				if (inserted)
+				{
+					points.push_back(p);
+				}
+				return it->second;
+			}
+
+			/// Numbers p as the node `id` unless it already has a number
+			void alias(const E3& p, uint32_t id)
+			{
+				ids.try_emplace(key(p), id);
+			}
+
+		private:
+			static std::array<uint64_t, 3> key(const E3& p) noexcept
+			{
+				// Adding zero folds -0.0 into +0.0, which compare equal
+				return {
+					std::bit_cast<uint64_t>(p.x + 0.0),
+					std::bit_cast<uint64_t>(p.y + 0.0),
+					std::bit_cast<uint64_t>(p.z + 0.0)
+				};
+			}
+		};
+
+		/// Directed piece of an edge between two nodes
+		struct Piece
+		{
+			uint32_t from, to;
+		};
+
+		inline uint64_t piece_key(uint32_t from, uint32_t to) noexcept
+		{
+			return (static_cast<uint64_t>(from) << 32) | to;
+		}
+
+		/// True if an endpoint of either arc lies within the node tolerance
+		/// of the other arc
+		inline bool touches(const E3& a0, const E3& a1, const E3& b0, const E3& b1) noexcept
+		{
+			const E3 u0 = unit(a0), u1 = unit(a1), v0 = unit(b0), v1 = unit(b1);
+			return arc_distance(u0, v0, v1) <= node_tolerance || arc_distance(u1, v0, v1) <= node_tolerance
+				|| arc_distance(v0, u0, u1) <= node_tolerance || arc_distance(v1, u0, u1) <= node_tolerance;
+		}
+
+		/// Places the vertices of `from` on the boundary of `to`. A vertex
+		/// within the tolerance of a vertex of `to` is numbered as that vertex
+		/// when `merge` is set (and left alone otherwise); one within it of
+		/// the interior of an edge of `to` is added to the split nodes of that
+		/// edge, so that boundaries shared through different vertices, or
+		/// partly overlapping along a great circle, meet at common nodes.
+		void touch(const Operand& from, const Operand& to, bool merge,
+			std::vector<std::vector<uint32_t>>& splits, Nodes& nodes)
+		{
+			std::vector<size_t> edges;
+			for (const std::vector<E3>& ring : from.rings)
+			{
+				for (const E3& v : ring)
+				{
+					const E3 q = unit(v);
+					uint32_t node = none;
+					edges.clear();
+					for (size_t s = 0; s < to.rings.size() && node == none; ++s)
+					{
+						const std::vector<E3>& other = to.rings[s];
+						for (const EdgeHit& h : to.bvhs[s].within(q, 2.0 * node_tolerance))
+						{
+							const size_t j = h.edge, k = (h.edge + 1) % other.size();
+							const E3 a = unit(other[j]), b = unit(other[k]);
+							if (angle(q, a) <= node_tolerance || angle(q, b) <= node_tolerance)
+							{
+								node = nodes.id(angle(q, a) <= angle(q, b) ? other[j] : other[k]);
+								break;
+							}
+							if (arc_distance(q, a, b) <= node_tolerance)
+							{
+								edges.push_back(to.edge_offsets[s] + j);
+							}
+						}
+					}
+					if (node != none)
+					{
+						if (merge)
+						{
+							nodes.alias(v, node);
+						}
+						continue;
+					}
+					for (const size_t e : edges)
+					{
+						splits[e].push_back(nodes.id(v));
+					}
+				}
+			}
+		}
+
+		/// Splits every edge of the operand at its crossing nodes, ordered
+		/// along the edge, into pieces with the operand interior on the left
+		std::vector<Piece> split(const Operand& x, const std::vector<std::vector<uint32_t>>& crossings, Nodes& nodes)
+		{
+			std::vector<Piece> pieces;
+			std::vector<std::pair<double, uint32_t>> along;
+			for (size_t r = 0; r < x.rings.size(); ++r)
+			{
+				const std::vector<E3>& ring = x.rings[r];
+				const size_t n = ring.size();
+				for (size_t i = 0; i < n; ++i)
+				{
+					const uint32_t start = nodes.id(ring[i]);
+					const uint32_t end = nodes.id(ring[(i + 1) % n]);
+					const E3 s = unit(ring[i]);
+					along.clear();
+					for (const uint32_t c : crossings[x.edge_offsets[r] + i])
+					{
+						along.push_back({ angle(s, unit(nodes.points[c])), c });
+					}
+					std::sort(along.begin(), along.end());
+					const auto emit = [&](uint32_t u, uint32_t v) {
+						pieces.push_back(x.flipped[r] ? Piece{ v, u } : Piece{ u, v });
+					};
+					uint32_t from = start;
+					for (const auto& [t, c] : along)
+					{
+						if (c != from)
+						{
+							emit(from, c);
+							from = c;
+						}
+					}
+					if (end != from)
+					{
+						emit(from, end);
+					}
+				}
+			}
+			return pieces;
+		}
+
+		/// True if the ring is narrower than the node tolerance: its area is
+		/// below the tolerance times its length. Such rings are left where
+		/// boundaries meeting within the tolerance double back on each other.
+		bool sliver(const std::vector<E3>& ring)
+		{
+			double length = 0.0;
+			for (size_t i = 0; i < ring.size(); ++i)
+			{
+				length += angle(unit(ring[i]), unit(ring[(i + 1) % ring.size()]));
+			}
+			return std::abs(spherical_area(LoopView<E3>(ring))) <= node_tolerance * length;
+		}
+
+		/// Links directed pieces into rings, taking at every node the
+		/// outgoing piece met first turning clockwise from the incoming one
+		Compound<GP<>> link(const std::vector<Piece>& pieces, const Nodes& nodes)
+		{
+			const size_t k = pieces.size();
+			std::vector<size_t> offsets(nodes.points.size() + 1, 0);
+			for (const Piece& p : pieces)
+			{
+				++offsets[p.from + 1];
+			}
+			for (size_t i = 1; i < offsets.size(); ++i)
+			{
+				offsets[i] += offsets[i - 1];
+			}
+			std::vector<uint32_t> outgoing(k);
+			std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < k; ++i)
+			{
+				outgoing[cursor[pieces[i].from]++] = static_cast<uint32_t>(i);
+			}
+
+			Compound<GP<>> result;
+			std::vector<bool> used(k, false);
+			std::vector<E3> ring;
+			for (size_t first = 0; first < k; ++first)
+			{
+				if (used[first])
+				{
+					continue;
+				}
+				used[first] = true;
+				ring.clear();
+				size_t current = first;
+				bool closed = false;
+				while (true)
+				{
+					const Piece& p = pieces[current];
+					ring.push_back(nodes.points[p.from]);
+					const E3& back = nodes.points[p.from];
+					const E3& here = nodes.points[p.to];
+					uint32_t best = none;
+					for (size_t j = offsets[p.to]; j < offsets[p.to + 1]; ++j)
+					{
+						const uint32_t e = outgoing[j];
+						if (used[e] && e != first)
+						{
+							continue;
+						}
+						if (best == none || ordered_ccw(nodes.points[pieces[best].to], nodes.points[pieces[e].to], back, here))
+						{
+							best = e;
+						}
+					}
+					if (best == none)
+					{
+						break;
+					}
+					if (best == first)
+					{
+						closed = true;
+						break;
+					}
+					used[best] = true;
+					current = best;
+				}
+				if (closed && ring.size() >= 3 && !sliver(ring))
+				{
+					GP<> poly;
+					poly.boundary.vertices = ring;
+					result.polygons.push_back(std::move(poly));
+				}
+			}
+			return result;
+		}
+	}
+
+	Compound<GP<>> overlay(const Compound<GP<>>& a, const Compound<GP<>>& b, BooleanOp op)
+	{
+		const Operand x(a), y(b);
+		Nodes nodes;
+		std::vector<std::vector<uint32_t>> xs(x.edge_offsets.back()), ys(y.edge_offsets.back());
+
+		// The vertices of a are numbered first; the vertices of b that lie on
+		// them take their nodes, and vertices lying on an edge of the other
+		// operand split it
+		for (const std::vector<E3>& ring : x.rings)
+		{
+			for (const E3& v : ring)
+			{
+				nodes.id(v);
+			}
+		}
+		touch(y, x, true, xs, nodes);
+		touch(x, y, false, ys, nodes);
+
+		// Proper crossings between the operands; the crossing point is always
+		// evaluated with the edge of a first, so both edges share one node.
+		// Edges with an endpoint on the other edge meet there instead.
+		for (size_t r = 0; r < x.rings.size(); ++r)
+		{
+			const std::vector<E3>& ring = x.rings[r];
+			for (size_t i = 0; i < ring.size(); ++i)
+			{
+				const E3& a0 = ring[i];
+				const E3& a1 = ring[(i + 1) % ring.size()];
+				for (size_t s = 0; s < y.rings.size(); ++s)
+				{
+					if (!overlaps(y.caps[s], a0, a1))
+					{
+						continue;
+					}
+					const std::vector<E3>& other = y.rings[s];
+					for (const size_t j : y.bvhs[s].crossing_edges(a0, a1))
+					{
+						const E3& b0 = other[j];
+						const E3& b1 = other[(j + 1) % other.size()];
+						if (touches(a0, a1, b0, b1))
+						{
+							continue;
+						}
+						const uint32_t c = nodes.id(crossing_point(a0, a1, b0, b1));
+						xs[x.edge_offsets[r] + i].push_back(c);
+						ys[y.edge_offsets[s] + j].push_back(c);
+					}
+				}
+			}
+		}
+		const std::vector<Piece> xp = split(x, xs, nodes);
+		const std::vector<Piece> yp = split(y, ys, nodes);
+
+		// Pieces of b by endpoints, to find the pieces both operands share
+		std::unordered_map<uint64_t, size_t> shared;
+		for (size_t i = 0; i < yp.size(); ++i)
+		{
+			shared.try_emplace(piece_key(yp[i].from, yp[i].to), i);
+		}
+		std::vector<bool> taken(yp.size(), false);
+
+		const auto midpoint = [&](const Piece& p) {
+			const E3& u = nodes.points[p.from];
+			const E3& v = nodes.points[p.to];
+			return unit(u) + unit(v);
+		};
+
+		std::vector<Piece> kept;
+		for (const Piece& p : xp)
+		{
+			const auto same = shared.find(piece_key(p.from, p.to));
+			const auto opposite = shared.find(piece_key(p.to, p.from));
+			if (same != shared.end())
+			{
+				// Both interiors on the same side: one boundary for union and
+				// intersection, none for the difference
+				taken[same->second] = true;
+				if (op != BooleanOp::Difference)
+				{
+					kept.push_back(p);
+				}
+				continue;
+			}
+			if (opposite != shared.end())
+			{
+				// Interiors on either side: only a minus b keeps a boundary
+				taken[opposite->second] = true;
+				if (op == BooleanOp::Difference)
+				{
+					kept.push_back(p);
+				}
+				continue;
+			}
+			const bool in_b = y.contains(midpoint(p));
+			if (op == BooleanOp::Intersection ? in_b : !in_b)
+			{
+				kept.push_back(p);
+			}
+		}
+		for (size_t i = 0; i < yp.size(); ++i)
+		{
+			if (taken[i])
+			{
+				continue;
+			}
+			const Piece& p = yp[i];
+			const bool in_a = x.contains(midpoint(p));
+			switch (op)
+			{
+			case BooleanOp::Union:
+				if (!in_a) kept.push_back(p);
+				break;
+			case BooleanOp::Intersection:
+				if (in_a) kept.push_back(p);
+				break;
+			case BooleanOp::Difference:
+				// The boundary of b inside a bounds the difference, reversed
+				if (in_a) kept.push_back({ p.to, p.from });
+				break;
+			}
+		}
+		return link(kept, nodes);
+	}
+}
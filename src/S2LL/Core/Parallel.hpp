@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace S2LL
+{
+	/// Number of threads used when a parallel algorithm is given 0
+	inline unsigned default_threads() noexcept
+	{
+		const unsigned n = std::thread::hardware_concurrency();
+		return n == 0 ? 1 : n;
+	}
+
+	/// Calls f(begin, end) over contiguous chunks partitioning [0, n), from up
+	/// to `threads` threads (0: one per hardware thread). Chunks hold at least
+	/// `grain` indices, so small inputs run inline on the calling thread, which
+	/// always takes the first chunk. f must be safe to call concurrently on
+	/// disjoint ranges; the first exception it throws is rethrown here after
+	/// all threads have joined.
+	template <typename F>
+	void parallel_for(size_t n, F&& f, unsigned threads = 0, size_t grain = 1024)
+	{
+		if (threads == 0)
+		{
+			threads = default_threads();
+		}
+		const size_t chunks = std::min<size_t>(threads, std::max<size_t>(1, n / std::max<size_t>(grain, 1)));
+		if (chunks <= 1)
+		{
+			if (n > 0)
+			{
+				f(size_t{ 0 }, n);
+			}
+			return;
+		}
+
+		std::exception_ptr error;
+		std::mutex error_mutex;
+		const auto run = [&](size_t c) {
+			try
+			{
+				f(n * c / chunks, n * (c + 1) / chunks);
+			}
+			catch (...)
+			{
+				const std::lock_guard<std::mutex> lock(error_mutex);
+				if (!error)
+				{
+					error = std::current_exception();
+				}
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(chunks - 1);
+		for (size_t c = 1; c < chunks; ++c)
+		{
+			workers.emplace_back(run, c);
+		}
+		run(0);
+		for (std::thread& t : workers)
+		{
+			t.join();
+		}
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+}
@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/PointIndex.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		inline double coord(const E3& p, int axis) noexcept
+		{
+			return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+		}
+
+		/// Squared chord between two unit vectors
+		inline double chord2(const E3& a, const E3& b) noexcept
+		{
+			const double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+			return dx * dx + dy * dy + dz * dz;
+		}
+
+		/// Squared distance from q to a box. Every term is at most the one of
+		/// any point in the box and rounds no higher, so the sum never
+		/// exceeds the squared chord to such a point.
+		template <typename Node>
+		inline double distance2(const Node& node, const E3& q) noexcept
+		{
+			double d2 = 0.0;
+			for (int k = 0; k < 3; ++k)
+			{
+				const double x = coord(q, k);
+				const double d = x < node.lo[k] ? node.lo[k] - x : x > node.hi[k] ? x - node.hi[k] : 0.0;
+				d2 += d * d;
+			}
+			return d2;
+		}
+
+		/// Angle subtended by a chord of the unit sphere
+		inline double chord_angle(double d2) noexcept
+		{
+			return 2.0 * std::asin(std::min(1.0, 0.5 * std::sqrt(d2)));
+		}
+
+		/// Squared chord of an angle; past a half turn, every point
+		inline double angle_chord2(double radius) noexcept
+		{
+			if (radius >= std::numbers::pi)
+			{
+				return std::numeric_limits<double>::infinity();
+			}
+			const double c = 2.0 * std::sin(0.5 * std::max(radius, 0.0));
+			return c * c;
+		}
+
+		/// Query indices in Morton order of their directions, so consecutive
+		/// queries descend through the same nodes while they are cached
+		std::vector<uint64_t> morton_order(std::span<const E3> queries, unsigned threads)
+		{
+			std::vector<uint64_t> keys(queries.size());
+			parallel_for(queries.size(), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					const E3 u = unit(queries[i]);
+					keys[i] = (((spread10(u.x) << 2) | (spread10(u.y) << 1) | spread10(u.z)) << 32) | i;
+				}
+			}, threads, 4096);
+			std::sort(keys.begin(), keys.end());
+			return keys;
+		}
+
+		using Candidate = std::pair<double, uint32_t>;
+	}
+
+	PointIndex::PointIndex(std::span<const E3> input, unsigned threads)
+	{
+		const size_t n = input.size();
+		assert(n < std::numeric_limits<uint32_t>::max());
+		struct Item
+		{
+			E3 p;
+			uint32_t id;
+		};
+		std::vector<Item> items(n);
+		parallel_for(n, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				items[i] = Item{ unit(input[i]), static_cast<uint32_t>(i) };
+			}
+		}, threads, 4096);
+
+		// One level at a time: the children of the inner nodes of a level,
+		// in order, make up the next level, so their indices are known
+		// before any node is split
+		struct Range
+		{
+			uint32_t begin, end;
+		};
+		std::vector<Range> level, next;
+		std::vector<uint32_t> child;
+		if (n > 0)
+		{
+			level.push_back(Range{ 0, static_cast<uint32_t>(n) });
+		}
+		while (!level.empty())
+		{
+			const size_t base = nodes.size();
+			nodes.resize(base + level.size());
+			child.resize(level.size());
+			size_t inner = 0;
+			for (size_t k = 0; k < level.size(); ++k)
+			{
+				child[k] = static_cast<uint32_t>(base + level.size() + 2 * inner);
+				inner += level[k].end - level[k].begin > leaf_size;
+			}
+
+			parallel_for(level.size(), [&](size_t begin, size_t end) {
+				for (size_t k = begin; k < end; ++k)
+				{
+					const auto [first, last] = level[k];
+					Node& node = nodes[base + k];
+					for (int a = 0; a < 3; ++a)
+					{
+						node.lo[a] = std::numeric_limits<double>::infinity();
+						node.hi[a] = -std::numeric_limits<double>::infinity();
+					}
+					for (uint32_t i = first; i < last; ++i)
+					{
+						for (int a = 0; a < 3; ++a)
+						{
+							node.lo[a] = std::min(node.lo[a], coord(items[i].p, a));
+							node.hi[a] = std::max(node.hi[a], coord(items[i].p, a));
+						}
+					}
+					if (last - first <= leaf_size)
+					{
+						node.first = first;
+						node.count = last - first;
+						continue;
+					}
+					int axis = 0;
+					for (int a = 1; a < 3; ++a)
+					{
+						if (node.hi[a] - node.lo[a] > node.hi[axis] - node.lo[axis])
+						{
+							axis = a;
+						}
+					}
+					const uint32_t mid = first + (last - first) / 2;
+					std::nth_element(items.begin() + first, items.begin() + mid, items.begin() + last, [axis](const Item& a, const Item& b) {
+						const double x = coord(a.p, axis), y = coord(b.p, axis);
+						return x != y ? x < y : a.id < b.id;
+					});
+					node.first = child[k];
+					node.count = 0;
+				}
+			}, threads, 1);
+
+			next.clear();
+			for (const Range& r : level)
+			{
+				if (r.end - r.begin > leaf_size)
+				{
+					const uint32_t mid = r.begin + (r.end - r.begin) / 2;
+					next.push_back(Range{ r.begin, mid });
+					next.push_back(Range{ mid, r.end });
+				}
+			}
+			level.swap(next);
+		}
+
+		points.resize(n);
+		ids.resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			points[i] = items[i].p;
+			ids[i] = items[i].id;
+		}
+	}
+
+	void PointIndex::nearest(const E3& q, size_t k, std::vector<Candidate>& heap) const
+	{
+		heap.clear();
+		if (k == 0 || nodes.empty())
+		{
+			return;
+		}
+		// Max-heap of the best k so far, by squared chord and then index
+		const auto worst = [&] {
+			return heap.size() < k ? std::numeric_limits<double>::infinity() : heap.front().first;
+		};
+
+		struct Entry
+		{
+			uint32_t node;
+			double bound;
+		};
+		Entry stack[96];
+		int top = 0;
+		stack[top++] = Entry{ 0, distance2(nodes[0], q) };
+		while (top > 0)
+		{
+			const Entry e = stack[--top];
+			if (e.bound > worst())
+			{
+				continue;
+			}
+			const Node& node = nodes[e.node];
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; ++i)
+				{
+					const Candidate c{ chord2(q, points[i]), ids[i] };
+					if (heap.size() < k)
+					{
+						heap.push_back(c);
+						std::push_heap(heap.begin(), heap.end());
+					}
+					else if (c < heap.front())
+					{
+						std::pop_heap(heap.begin(), heap.end());
+						heap.back() = c;
+						std::push_heap(heap.begin(), heap.end());
+					}
+				}
+				continue;
+			}
+			// Nearer child on top of the stack
+			Entry left{ node.first, distance2(nodes[node.first], q) };
+			Entry right{ node.first + 1, distance2(nodes[node.first + 1], q) };
+			if (left.bound < right.bound)
+			{
+				std::swap(left, right);
+			}
+			stack[top++] = left;
+			stack[top++] = right;
+		}
+		std::sort_heap(heap.begin(), heap.end());
+	}
+
+	void PointIndex::within(const E3& q, double limit, std::vector<Candidate>& out) const
+	{
+		out.clear();
+		if (nodes.empty())
+		{
+			return;
+		}
+		uint32_t stack[96];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const Node& node = nodes[stack[--top]];
+			if (distance2(node, q) > limit)
+			{
+				continue;
+			}
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; ++i)
+				{
+					const double d2 = chord2(q, points[i]);
+					if (d2 <= limit)
+					{
+						out.emplace_back(d2, ids[i]);
+					}
+				}
+				continue;
+			}
+			stack[top++] = node.first + 1;
+			stack[top++] = node.first;
+		}
+		std::sort(out.begin(), out.end());
+	}
+
+	std::vector<Neighbor> PointIndex::nearest(const E3& p, size_t k) const
+	{
+		std::vector<Candidate> heap;
+		heap.reserve(std::min(k, size()));
+		nearest(unit(p), k, heap);
+		std::vector<Neighbor> out;
+		out.reserve(heap.size());
+		for (const auto& [d2, id] : heap)
+		{
+			out.push_back(Neighbor{ id, chord_angle(d2) });
+		}
+		return out;
+	}
+
+	std::vector<Neighbor> PointIndex::within(const E3& p, double radius) const
+	{
+		std::vector<Candidate> found;
+		within(unit(p), angle_chord2(radius), found);
+		std::vector<Neighbor> out;
+		out.reserve(found.size());
+		for (const auto& [d2, id] : found)
+		{
+			out.push_back(Neighbor{ id, chord_angle(d2) });
+		}
+		return out;
+	}
+
+	void PointIndex::nearest(std::span<const E3> queries, size_t k, std::span<Neighbor> out, unsigned threads) const
+	{
+		assert(out.size() == queries.size() * k);
+		const std::vector<uint64_t> order = morton_order(queries, threads);
+		parallel_for(queries.size(), [&](size_t begin, size_t end) {
+			std::vector<Candidate> heap;
+			heap.reserve(std::min(k, size()));
+			for (size_t j = begin; j < end; ++j)
+			{
+				const size_t i = static_cast<uint32_t>(order[j]);
+				nearest(unit(queries[i]), k, heap);
+				Neighbor* row = out.data() + i * k;
+				for (size_t slot = 0; slot < k; ++slot)
+				{
+					row[slot] = slot < heap.size() ? Neighbor{ heap[slot].second, chord_angle(heap[slot].first) }
+						: Neighbor{ Neighbor::npos, std::numeric_limits<double>::infinity() };
+				}
+			}
+		}, threads, 256);
+	}
+
+	NeighborLists PointIndex::within(std::span<const E3> queries, double radius, unsigned threads) const
+	{
+		// Blocks of queries gather their neighbors apart, then the blocks
+		// are copied into place after a prefix sum of the counts
+		constexpr size_t block = 256;
+		const size_t n = queries.size(), blocks = (n + block - 1) / block;
+		const double limit = angle_chord2(radius);
+		NeighborLists out;
+		out.offsets.assign(n + 1, 0);
+		std::vector<std::vector<Neighbor>> found(blocks);
+		parallel_for(blocks, [&](size_t begin, size_t end) {
+			std::vector<Candidate> hits;
+			for (size_t b = begin; b < end; ++b)
+			{
+				for (size_t i = b * block; i < std::min(n, (b + 1) * block); ++i)
+				{
+					within(unit(queries[i]), limit, hits);
+					out.offsets[i + 1] = hits.size();
+					for (const auto& [d2, id] : hits)
+					{
+						found[b].push_back(Neighbor{ id, chord_angle(d2) });
+					}
+				}
+			}
+		}, threads, 1);
+		for (size_t i = 0; i < n; ++i)
+		{
+			out.offsets[i + 1] += out.offsets[i];
+		}
+		out.neighbors.resize(out.offsets[n]);
+		parallel_for(blocks, [&](size_t begin, size_t end) {
+			for (size_t b = begin; b < end; ++b)
+			{
+				std::copy(found[b].begin(), found[b].end(), out.neighbors.begin() + static_cast<ptrdiff_t>(out.offsets[b * block]));
+			}
+		}, threads, 1);
+		return out;
+	}
+
+	size_t PointIndex::memory_usage() const noexcept
+	{
+		return points.capacity() * sizeof(E3) + ids.capacity() * sizeof(uint32_t) + nodes.capacity() * sizeof(Node);
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// References:
+// Bentley, J. L. (1975). Multidimensional binary search trees used for associative searching. Communications of the ACM, 18(9), 509-517. https://doi.org/10.1145/361002.361007
+// Friedman, J. H., Bentley, J. L., & Finkel, R. A. (1977). An algorithm for finding best matches in logarithmic expected time. ACM Transactions on Mathematical Software, 3(3), 209-226. https://doi.org/10.1145/355744.355745
+
+#include <S2LL/Core/Coordinates.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace S2LL
+{
+	/// Point reached by a query: its index in the indexed span and the angle
+	/// to it in radians
+	struct Neighbor
+	{
+		/// Index of the empty slots of a batch query asking for more
+		/// neighbors than there are points
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		size_t index;
+		double angle;
+	};
+
+	/// Neighbor lists of a batch query, as in Voronoi: query i found
+	/// neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1], nearest first
+	struct NeighborLists
+	{
+		std::vector<size_t> offsets;
+		std::vector<Neighbor> neighbors;
+	};
+
+	/// Static nearest-neighbor index over the directions of a point cloud
+	/// (which need not be unit vectors). The directions are normalized and
+	/// kept in a kd-tree in E3: every node splits its points at the median
+	/// along the longest side of their bounding box, down to leaves of at
+	/// most leaf_size points, and stores that box. The nodes of each level
+	/// follow the nodes of the level above in one flat array, and the points
+	/// are permuted into leaf order, so a query reads contiguous memory.
+	///
+	/// On the unit sphere the chord length grows with the angle, so queries
+	/// rank and prune by squared chord, which needs no trigonometry, and
+	/// convert to angles only for the points they return. Ties are exact:
+	/// points at the same squared chord are ordered by index, and a box is
+	/// pruned only when it is strictly farther than the current bound.
+	class PointIndex
+	{
+		struct Node
+		{
+			double lo[3], hi[3];
+			// Leaf: points [first, first + count); inner node: count is zero
+			// and first is the index of the left child, the right one follows
+			uint32_t first, count;
+		};
+
+		std::vector<E3> points;
+		std::vector<uint32_t> ids;
+		std::vector<Node> nodes;
+
+		void nearest(const E3& q, size_t k, std::vector<std::pair<double, uint32_t>>& heap) const;
+
+		void within(const E3& q, double chord2, std::vector<std::pair<double, uint32_t>>& out) const;
+
+	public:
+		/// Points per leaf, at most
+		static constexpr uint32_t leaf_size = 8;
+
+		/// Builds the tree level by level; the nodes of a level are split by
+		/// up to `threads` threads (0: one per hardware thread). The tree does
+		/// not depend on the thread count.
+		explicit PointIndex(std::span<const E3> points, unsigned threads = 1);
+
+		/// Number of points
+		inline size_t size() const noexcept { return points.size(); }
+
+		/// Number of tree nodes
+		inline size_t node_count() const noexcept { return nodes.size(); }
+
+		/// The k points nearest to the direction p (all of them if there are
+		/// fewer), nearest first; equal distances by index
+		std::vector<Neighbor> nearest(const E3& p, size_t k) const;
+
+		/// Points within an angle of the direction p, boundary included,
+		/// nearest first; equal distances by index
+		std::vector<Neighbor> within(const E3& p, double radius) const;
+
+		/// Batch k nearest: out[i * k + j] is the j-th neighbor of query i,
+		/// and out must hold queries.size() * k entries. Slots past the
+		/// number of points hold npos at infinite angle. The queries are
+		/// visited in Morton order of their directions, which keeps the nodes
+		/// they share in cache, and split among up to `threads` threads
+		/// (0: one per hardware thread).
+		void nearest(std::span<const E3> queries, size_t k, std::span<Neighbor> out, unsigned threads = 1) const;
+
+		/// Batch radius query: the neighbors of every query within the same
+		/// angle, gathered by up to `threads` threads into one flat list
+		NeighborLists within(std::span<const E3> queries, double radius, unsigned threads = 1) const;
+
+		/// Heap bytes held by the index
+		size_t memory_usage() const noexcept;
+	};
+}
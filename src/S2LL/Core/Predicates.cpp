@@ -0,0 +1,401 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		inline bool less(const E3& a, const E3& b) noexcept
+		{
+			if (a.x != b.x) return a.x < b.x;
+			if (a.y != b.y) return a.y < b.y;
+			return a.z < b.z;
+		}
+
+		inline int sign(double x) noexcept
+		{
+			return (x > 0.0) - (x < 0.0);
+		}
+
+		/// Relative error bound of a triple product evaluated as a dot product
+		/// with a rounded cross product, against its permanent
+		constexpr double triple_error = 8.0 * DBL_EPSILON;
+
+		/// Relative error bound of det(b - a, c - a, d - a) from rounded
+		/// differences, against the permanent of those differences: the
+		/// (7 + 56 eps) eps of Shewchuk's orient3d stage A, with eps = 2^-53
+		constexpr double difference_error = 4.0 * DBL_EPSILON;
+
+		/// Sign of d when it exceeds the error bound, else 0, as a double
+		inline double filtered_sign(double d, double bound) noexcept
+		{
+			return static_cast<double>(d > bound) - static_cast<double>(d < -bound);
+		}
+
+		/// Exact sign of a sum of doubles, accumulated into a nonoverlapping
+		/// expansion by Grow-Expansion (Shewchuk 1997, Theorem 10)
+		template <size_t N>
+		int exact_sign(const std::array<double, N>& terms) noexcept
+		{
+			std::array<double, N> e{};
+			size_t n = 0;
+			for (const double b : terms)
+			{
+				double q = b;
+				size_t k = 0;
+				for (size_t i = 0; i < n; ++i)
+				{
+					const double s = q + e[i];
+					const double v = s - q;
+					const double err = (q - (s - v)) + (e[i] - v);
+					q = s;
+					if (err != 0.0)
+					{
+						e[k++] = err;
+					}
+				}
+				if (q != 0.0)
+				{
+					e[k++] = q;
+				}
+				n = k;
+			}
+			return n == 0 ? 0 : sign(e[n - 1]);
+		}
+
+		/// Exact product a b = hi + lo
+		inline std::pair<double, double> two_product(double a, double b) noexcept
+		{
+			const double p = a * b;
+			return { p, std::fma(a, b, -p) };
+		}
+
+		/// Exact sign of a b - c d
+		inline int sign_minor(double a, double b, double c, double d) noexcept
+		{
+			const double ab = a * b, cd = c * d;
+			const double bound = 3.0 * DBL_EPSILON * (std::abs(ab) + std::abs(cd));
+			if (std::abs(ab - cd) > bound)
+			{
+				return sign(ab - cd);
+			}
+			const auto [p, q] = two_product(a, b);
+			const auto [r, s] = two_product(c, d);
+			return exact_sign(std::array<double, 4>{ q, -s, p, -r });
+		}
+
+		/// det(a, b, c) in double, with its permanent (the same sum with
+		/// absolute values), which bounds its rounding error
+		inline std::pair<double, double> rounded_det(const E3& a, const E3& b, const E3& c) noexcept
+		{
+			const double m1 = b.y * c.z - b.z * c.y;
+			const double m2 = b.z * c.x - b.x * c.z;
+			const double m3 = b.x * c.y - b.y * c.x;
+			const double det = a.x * m1 + a.y * m2 + a.z * m3;
+			const double permanent =
+				std::abs(a.x) * (std::abs(b.y * c.z) + std::abs(b.z * c.y)) +
+				std::abs(a.y) * (std::abs(b.z * c.x) + std::abs(b.x * c.z)) +
+				std::abs(a.z) * (std::abs(b.x * c.y) + std::abs(b.y * c.x));
+			return { det, permanent };
+		}
+
+		/// Appends at terms[k] the 24 doubles whose sum is exactly det(a, b, c):
+		/// each of its six triple products is exactly the sum of four doubles
+		template <size_t N>
+		void det_terms(const E3& a, const E3& b, const E3& c, std::array<double, N>& terms, size_t& k) noexcept
+		{
+			const auto triple = [&](double x, double y, double z) {
+				const auto [p, q] = two_product(x, y);
+				const auto [p1, p2] = two_product(p, z);
+				const auto [q1, q2] = two_product(q, z);
+				terms[k++] = q2;
+				terms[k++] = q1;
+				terms[k++] = p2;
+				terms[k++] = p1;
+			};
+			triple(a.x, b.y, c.z);
+			triple(-a.x, b.z, c.y);
+			triple(a.y, b.z, c.x);
+			triple(-a.y, b.x, c.z);
+			triple(a.z, b.x, c.y);
+			triple(-a.z, b.y, c.x);
+		}
+
+		/// Exact sign of det(a, b, c), zero when the points are coplanar with
+		/// the origin
+		int exact_orient(const E3& a, const E3& b, const E3& c) noexcept
+		{
+			const auto [det, permanent] = rounded_det(a, b, c);
+			if (std::abs(det) > triple_error * permanent)
+			{
+				return sign(det);
+			}
+			std::array<double, 24> terms;
+			size_t k = 0;
+			det_terms(a, b, c, terms, k);
+			return exact_sign(terms);
+		}
+
+		/// Sign of det(a, b, c) under the symbolic perturbation of Simulation
+		/// of Simplicity, for a < b < c lexicographically and det == 0. Each
+		/// point is perturbed by a distinct infinitesimal, larger for smaller
+		/// points; the first nonzero coefficient of the perturbed determinant
+		/// decides.
+		int perturbed_sign(const E3& a, const E3& b, const E3& c) noexcept
+		{
+			int s = sign_minor(b.x, c.y, b.y, c.x);
+			if (s != 0) return s;
+			s = sign_minor(b.z, c.x, b.x, c.z);
+			if (s != 0) return s;
+			s = sign_minor(b.y, c.z, b.z, c.y);
+			if (s != 0) return s;
+
+			s = sign_minor(c.x, a.y, c.y, a.x);
+			if (s != 0) return s;
+			s = sign(c.x);
+			if (s != 0) return s;
+			s = -sign(c.y);
+			if (s != 0) return s;
+			s = sign_minor(c.z, a.x, c.x, a.z);
+			if (s != 0) return s;
+			s = sign(c.z);
+			if (s != 0) return s;
+
+			// c is the zero vector from here on
+			s = sign_minor(a.x, b.y, a.y, b.x);
+			if (s != 0) return s;
+			s = -sign(b.x);
+			if (s != 0) return s;
+			s = sign(b.y);
+			if (s != 0) return s;
+			s = sign(a.x);
+			if (s != 0) return s;
+			return 1;
+		}
+	}
+
+	int orient(const E3& a, const E3& b, const E3& c) noexcept
+	{
+		if (same(a, b) || same(b, c) || same(c, a))
+		{
+			return 0;
+		}
+		const int s = exact_orient(a, b, c);
+		if (s != 0)
+		{
+			return s;
+		}
+
+		// Sort lexicographically, tracking the parity of the permutation
+		E3 p = a, q = b, r = c;
+		int parity = 1;
+		if (less(q, p)) { std::swap(p, q); parity = -parity; }
+		if (less(r, q)) { std::swap(q, r); parity = -parity; }
+		if (less(q, p)) { std::swap(p, q); parity = -parity; }
+		return parity * perturbed_sign(p, q, r);
+	}
+
+	bool ordered_ccw(const E3& a, const E3& b, const E3& c, const E3& o) noexcept
+	{
+		int sum = 0;
+		if (orient(b, o, a) >= 0) ++sum;
+		if (orient(c, o, b) >= 0) ++sum;
+		if (orient(a, o, c) > 0) ++sum;
+		return sum >= 2;
+	}
+
+	int orient3d(const E3& a, const E3& b, const E3& c, const E3& d) noexcept
+	{
+		// Nearby points make a small determinant of small differences, which
+		// the differences resolve first
+		const E3 ab{ b.x - a.x, b.y - a.y, b.z - a.z };
+		const E3 ac{ c.x - a.x, c.y - a.y, c.z - a.z };
+		const E3 ad{ d.x - a.x, d.y - a.y, d.z - a.z };
+		const auto [d0, p0] = rounded_det(ab, ac, ad);
+		if (std::abs(d0) > difference_error * p0)
+		{
+			return sign(d0);
+		}
+
+		// det(b - a, c - a, d - a) = [bcd] - [acd] + [abd] - [abc], a sum of
+		// triple products of the stored coordinates, so no difference is
+		// rounded before the exact stage
+		const E3 na{ -a.x, -a.y, -a.z };
+		const auto [d1, p1] = rounded_det(b, c, d);
+		const auto [d2, p2] = rounded_det(na, c, d);
+		const auto [d3, p3] = rounded_det(a, b, d);
+		const auto [d4, p4] = rounded_det(na, b, c);
+		const double det = (d1 + d2) + (d3 + d4);
+		if (std::abs(det) > 2.0 * triple_error * (p1 + p2 + p3 + p4))
+		{
+			return sign(det);
+		}
+		std::array<double, 96> terms;
+		size_t k = 0;
+		det_terms(b, c, d, terms, k);
+		det_terms(na, c, d, terms, k);
+		det_terms(a, b, d, terms, k);
+		det_terms(na, b, c, terms, k);
+		return exact_sign(terms);
+	}
+
+	E3 ref_dir(const E3& a) noexcept
+	{
+		// Cross with a fixed vector that is nearly aligned with the axis
+		// preceding the largest component of a, so it is never parallel to a
+		const double ax = std::abs(a.x), ay = std::abs(a.y), az = std::abs(a.z);
+		const int largest = ax > ay ? (ax > az ? 0 : 2) : (ay > az ? 1 : 2);
+		std::array<double, 3> t{ 0.012, 0.0053, 0.00457 };
+		t[(largest + 2) % 3] = 1.0;
+		return a.cross(E3{ t[0], t[1], t[2] });
+	}
+
+	int crossing_sign(const E3& a, const E3& b, const E3& c, const E3& d) noexcept
+	{
+		if (same(a, c) || same(a, d) || same(b, c) || same(b, d))
+		{
+			return 0;
+		}
+		if (same(a, b) || same(c, d))
+		{
+			return -1;
+		}
+
+		// The arcs cross iff c and d straddle the plane of ab, a and b
+		// straddle the plane of cd, and both happen on the same hemisphere
+		const int acb = -orient(a, b, c);
+		if (orient(a, b, d) != acb)
+		{
+			return -1;
+		}
+		if (-orient(c, d, b) != acb)
+		{
+			return -1;
+		}
+		return orient(c, d, a) == acb ? 1 : -1;
+	}
+
+	bool vertex_crossing(const E3& a, const E3& b, const E3& c, const E3& d) noexcept
+	{
+		if (same(a, b) || same(c, d))
+		{
+			return false;
+		}
+
+		// Around the shared vertex, the crossing counts iff ab is further
+		// counterclockwise than cd, starting from a fixed reference direction
+		if (same(a, c))
+		{
+			return same(b, d) || ordered_ccw(ref_dir(a), d, b, a);
+		}
+		if (same(b, d))
+		{
+			return ordered_ccw(ref_dir(b), c, a, b);
+		}
+		if (same(a, d))
+		{
+			return same(b, c) || ordered_ccw(ref_dir(a), c, b, a);
+		}
+		if (same(b, c))
+		{
+			return ordered_ccw(ref_dir(b), d, a, b);
+		}
+		return false;
+	}
+
+	size_t crossing_signs(const E3& a, const E3& b,
+		std::span<const E3> c, std::span<const E3> d, std::span<signed char> out) noexcept
+	{
+		assert(c.size() == d.size() && c.size() == out.size());
+		const size_t n = c.size();
+
+		// Normal of ab and the absolute products bounding its rounding
+		const double mx = a.y * b.z - a.z * b.y, my = a.z * b.x - a.x * b.z, mz = a.x * b.y - a.y * b.x;
+		const double px = std::abs(a.y * b.z) + std::abs(a.z * b.y);
+		const double py = std::abs(a.z * b.x) + std::abs(a.x * b.z);
+		const double pz = std::abs(a.x * b.y) + std::abs(a.y * b.x);
+		const double ax = std::abs(a.x), ay = std::abs(a.y), az = std::abs(a.z);
+		const double bx = std::abs(b.x), by = std::abs(b.y), bz = std::abs(b.z);
+		const E3* cs = c.data();
+		const E3* ds = d.data();
+		signed char* s = out.data();
+
+		// The arcs cross iff orient(a, b, d) == orient(c, d, a) ==
+		// -orient(a, b, c) == -orient(c, d, b). Coinciding points make two
+		// of the signs undecided, so a lane with a decided mismatch within
+		// either pair is a certain miss; other undecided lanes are marked 0.
+		// Blocks of edges are first copied into component arrays, and the
+		// signs are carried as doubles, so the compiler vectorizes the loop.
+		constexpr size_t block = 64;
+		double c0[block], c1[block], c2[block], d0[block], d1[block], d2[block];
+		for (size_t first = 0; first < n; first += block)
+		{
+			const size_t m = std::min(block, n - first);
+			for (size_t i = 0; i < m; ++i)
+			{
+				c0[i] = cs[first + i].x;
+				c1[i] = cs[first + i].y;
+				c2[i] = cs[first + i].z;
+				d0[i] = ds[first + i].x;
+				d1[i] = ds[first + i].y;
+				d2[i] = ds[first + i].z;
+			}
+			signed char* o = s + first;
+			for (size_t i = 0; i < m; ++i)
+			{
+				const double cx = c0[i], cy = c1[i], cz = c2[i];
+				const double dx = d0[i], dy = d1[i], dz = d2[i];
+				const double nx = cy * dz - cz * dy, ny = cz * dx - cx * dz, nz = cx * dy - cy * dx;
+				const double qx = std::abs(cy * dz) + std::abs(cz * dy);
+				const double qy = std::abs(cz * dx) + std::abs(cx * dz);
+				const double qz = std::abs(cx * dy) + std::abs(cy * dx);
+
+				const double abc = filtered_sign(mx * cx + my * cy + mz * cz,
+					triple_error * (px * std::abs(cx) + py * std::abs(cy) + pz * std::abs(cz)));
+				const double abd = filtered_sign(mx * dx + my * dy + mz * dz,
+					triple_error * (px * std::abs(dx) + py * std::abs(dy) + pz * std::abs(dz)));
+				const double cda = filtered_sign(nx * a.x + ny * a.y + nz * a.z,
+					triple_error * (qx * ax + qy * ay + qz * az));
+				const double cdb = filtered_sign(nx * b.x + ny * b.y + nz * b.z,
+					triple_error * (qx * bx + qy * by + qz * bz));
+
+				// Miss: -1; decided crossing: 1 or -1 by the sign of -abc cda
+				const double miss = std::max(abc * abd, cda * cdb) > 0.0 ? 1.0 : 0.0;
+				const double decided = std::abs(abc * abd * cda * cdb);
+				o[i] = static_cast<signed char>((1.0 - miss) * decided * (-abc * cda) - miss);
+			}
+		}
+
+		size_t count = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (s[i] == 0)
+			{
+				s[i] = static_cast<signed char>(crossing_sign(a, b, cs[i], ds[i]));
+			}
+			count += s[i] > 0;
+		}
+		return count;
+	}
+
+	size_t crossing_signs(const E3& a, const E3& b, LoopView<E3> ring, std::span<signed char> out) noexcept
+	{
+		assert(ring.size() == out.size());
+		const size_t n = ring.size();
+		if (n == 0)
+		{
+			return 0;
+		}
+		const size_t count = crossing_signs(a, b, ring.first(n - 1), ring.subspan(1), out.first(n - 1));
+		out[n - 1] = static_cast<signed char>(crossing_sign(a, b, ring[n - 1], ring[0]));
+		return count + (out[n - 1] > 0);
+	}
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+// References:
+// Shewchuk, J. R. (1997). Adaptive precision floating-point arithmetic and fast robust geometric predicates. Discrete & Computational Geometry, 18(3), 305-363. https://doi.org/10.1007/PL00009321
+// Edelsbrunner, H., & Mucke, E. P. (1990). Simulation of simplicity. ACM Transactions on Graphics, 9(1), 66-104. https://doi.org/10.1145/77635.77639
+
+#include <S2LL/Core/Coordinates.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace S2LL
+{
+	// Exact predicates on directions from the origin. Points need not be unit
+	// vectors: every sign depends only on the directions, and is evaluated on
+	// the coordinates exactly as stored. Coordinates are assumed to be far
+	// from the overflow and underflow thresholds.
+
+	/// Exact, symbolically perturbed sign of det(a, b, c) = a . (b x c):
+	/// +1 when a, b, c turn counterclockwise seen from outside the sphere,
+	/// -1 when clockwise. Collinear (coplanar with the origin) triples get a
+	/// consistent nonzero sign; zero is returned only if two points are equal.
+	int orient(const E3& a, const E3& b, const E3& c) noexcept;
+
+	/// True if the rays o->a, o->b, o->c are met in this order, counterclockwise
+	/// around o (b may coincide with a or c, but a and c must differ)
+	bool ordered_ccw(const E3& a, const E3& b, const E3& c, const E3& o) noexcept;
+
+	/// Exact sign of det(b - a, c - a, d - a): +1 when d lies on the side of
+	/// the plane through a, b, c from which they turn counterclockwise, -1
+	/// on the other side, 0 when the four points are coplanar (no symbolic
+	/// perturbation). Unlike orient, this depends on the points themselves,
+	/// not only on their directions.
+	int orient3d(const E3& a, const E3& b, const E3& c, const E3& d) noexcept;
+
+	/// Reference direction orthogonal to a, a fixed function of a
+	E3 ref_dir(const E3& a) noexcept;
+
+	/// Crossing of the minor arcs ab and cd: +1 if they cross at an interior
+	/// point of both, -1 if they do not cross, 0 if two of the points are
+	/// equal (a shared vertex; see vertex_crossing)
+	int crossing_sign(const E3& a, const E3& b, const E3& c, const E3& d) noexcept;
+
+	/// For arcs ab and cd sharing a vertex, whether the crossing counts: the
+	/// rule makes parity counts consistent along chains of edges
+	bool vertex_crossing(const E3& a, const E3& b, const E3& c, const E3& d) noexcept;
+
+	/// Crossing test for parity counts: a proper crossing, or a vertex
+	/// crossing under vertex_crossing
+	inline bool edge_or_vertex_crossing(const E3& a, const E3& b, const E3& c, const E3& d) noexcept
+	{
+		const int s = crossing_sign(a, b, c, d);
+		return s == 0 ? vertex_crossing(a, b, c, d) : s > 0;
+	}
+
+	/// Batch crossing test of the arc ab against the arcs c[i] d[i]: out[i]
+	/// is crossing_sign(a, b, c[i], d[i]), and the number of proper
+	/// crossings is returned. The four triple products of each pair are
+	/// filtered in plain double over the whole batch, in a branch-free loop
+	/// the compiler vectorizes; only lanes the error bounds leave undecided
+	/// (near-degenerate pairs and shared vertices) go to the exact
+	/// predicates. The spans must have the same length.
+	size_t crossing_signs(const E3& a, const E3& b,
+		std::span<const E3> c, std::span<const E3> d, std::span<signed char> out) noexcept;
+
+	/// Batch crossing test of the arc ab against the edges of a loop: out[i]
+	/// is the crossing sign of the edge from ring[i] to ring[i + 1] (wrapping
+	/// around), and out has one entry per vertex
+	size_t crossing_signs(const E3& a, const E3& b, LoopView<E3> ring, std::span<signed char> out) noexcept;
+
+	/// Crossing point of the arcs ab and cd, which must cross: the unit
+	/// vector on both great circles on the side of ab. Precision::Fast works
+	/// in plain double; Precision::Accurate carries both edge normals and
+	/// their cross product in Double and rounds once per component.
+	template <typename P = Precision::Accurate>
+	E3 crossing_point(const E3& a, const E3& b, const E3& c, const E3& d) noexcept;
+
+	/// Proper crossing of an arc with edge `edge` of a batch, at `point`
+	struct EdgeCrossing
+	{
+		size_t edge;
+		E3 point;
+	};
+
+	/// Appends the proper crossings of the arc ab with the arcs c[i] d[i] to
+	/// out, in increasing edge order, with their points evaluated under the
+	/// precision policy P; returns the number appended
+	template <typename P = Precision::Accurate>
+	size_t crossings(const E3& a, const E3& b,
+		std::span<const E3> c, std::span<const E3> d, std::vector<EdgeCrossing>& out);
+
+	template <typename P>
+	inline E3 crossing_point(const E3& a, const E3& b, const E3& c, const E3& d) noexcept
+	{
+		if constexpr (std::is_same_v<P, Precision::Fast>)
+		{
+			const double mx = a.y * b.z - a.z * b.y, my = a.z * b.x - a.x * b.z, mz = a.x * b.y - a.y * b.x;
+			const double nx = c.y * d.z - c.z * d.y, ny = c.z * d.x - c.x * d.z, nz = c.x * d.y - c.y * d.x;
+			double x = my * nz - mz * ny, y = mz * nx - mx * nz, z = mx * ny - my * nx;
+			const double side = x * (a.x + b.x) + y * (a.y + b.y) + z * (a.z + b.z);
+			const double scale = (side < 0.0 ? -1.0 : 1.0) / std::sqrt(x * x + y * y + z * z);
+			return E3{ x * scale, y * scale, z * scale };
+		}
+		else
+		{
+			static_assert(std::is_same_v<P, Precision::Accurate>, "unknown precision policy");
+			const Double mx = Mul(a.y, b.z) - Mul(a.z, b.y), my = Mul(a.z, b.x) - Mul(a.x, b.z), mz = Mul(a.x, b.y) - Mul(a.y, b.x);
+			const Double nx = Mul(c.y, d.z) - Mul(c.z, d.y), ny = Mul(c.z, d.x) - Mul(c.x, d.z), nz = Mul(c.x, d.y) - Mul(c.y, d.x);
+			const Double x = my * nz - mz * ny, y = mz * nx - mx * nz, z = mx * ny - my * nx;
+			const Double side = x * Add(a.x, b.x) + y * Add(a.y, b.y) + z * Add(a.z, b.z);
+			const Double m = Sqrt(Sq(x) + Sq(y) + Sq(z));
+			const Double scale = (side < Double::Zero ? Double::NegOne : Double::One) / m;
+			return E3{
+				static_cast<double>(x * scale),
+				static_cast<double>(y * scale),
+				static_cast<double>(z * scale)
+			};
+		}
+	}
+
+	template <typename P>
+	inline size_t crossings(const E3& a, const E3& b,
+		std::span<const E3> c, std::span<const E3> d, std::vector<EdgeCrossing>& out)
+	{
+		// Signs go through a fixed block on the stack, so large batches need
+		// no allocation beyond the output
+		constexpr size_t block = 256;
+		std::array<signed char, block> signs;
+		size_t found = 0;
+		for (size_t first = 0; first < c.size(); first += block)
+		{
+			const size_t count = std::min(block, c.size() - first);
+			if (crossing_signs(a, b, c.subspan(first, count), d.subspan(first, count), std::span(signs).first(count)) == 0)
+			{
+				continue;
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (signs[i] > 0)
+				{
+					out.push_back({ first + i, crossing_point<P>(a, b, c[first + i], d[first + i]) });
+					++found;
+				}
+			}
+		}
+		return found;
+	}
+}
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		constexpr uint32_t unmarked = static_cast<uint32_t>(-1);
+
+		/// Latitude / longitude rectangle bounding a cap, as in S2's
+		/// S2Cap::GetRectBound; the longitude range is [lon_lo, lon_hi] and
+		/// may extend past +-pi, or covers every longitude when full_lon
+		struct CapRect
+		{
+			double lat_lo, lat_hi, lon_lo, lon_hi;
+			bool full_lon;
+		};
+
+		/// Angular padding of the rectangle, above the rounding of its
+		/// latitudes and longitudes
+		constexpr double rect_padding = 1e-12;
+
+		/// Largest sin r / cos lat given a longitude half width: asin loses
+		/// its accuracy as the ratio nears 1, where the cap almost reaches a
+		/// pole and every longitude is taken instead
+		constexpr double max_width_ratio = 1.0 - 1e-6;
+
+		CapRect rect_bound(const Cap& cap) noexcept
+		{
+			constexpr double half_pi = 0.5 * std::numbers::pi;
+			const double r = cap.radius() + rect_padding;
+			const double lat = std::atan2(cap.axis.z, std::hypot(cap.axis.x, cap.axis.y));
+			CapRect rect{ lat - r, lat + r, 0.0, 0.0, false };
+			const double ratio = std::sin(r) / std::cos(lat);
+			if (rect.lat_lo <= -half_pi || rect.lat_hi >= half_pi || !(ratio <= max_width_ratio))
+			{
+				// A pole is inside, or nearly: every longitude is reached
+				rect.lat_lo = std::max(rect.lat_lo, -half_pi);
+				rect.lat_hi = std::min(rect.lat_hi, half_pi);
+				rect.full_lon = true;
+				return rect;
+			}
+			const double lon = std::atan2(cap.axis.y, cap.axis.x);
+			const double half_width = std::asin(ratio) + rect_padding;
+			rect.lon_lo = lon - half_width;
+			rect.lon_hi = lon + half_width;
+			return rect;
+		}
+	}
+
+	RegionIndex::RegionIndex(const FlatCompoundSet<E3>& regions, size_t grid_rows)
+		: ring_offsets(regions.part_offsets)
+	{
+		rings.reserve(regions.ring_count());
+		std::vector<E3> reversed;
+		for (size_t r = 0; r < regions.ring_count(); ++r)
+		{
+			const LoopView<E3> ring = regions.ring(r);
+			rings.emplace_back(ring);
+			if (ring.size() < 3 || !rings.back().cap().is_full())
+			{
+				continue;
+			}
+
+			// The ring fits no cap as given: when the reversed ring does, its
+			// interior is the smaller side and the reversed ring is kept
+			reversed.assign(ring.rbegin(), ring.rend());
+			PreparedPolygon flipped{ LoopView<E3>(reversed) };
+			if (!flipped.cap().is_full())
+			{
+				rings.back() = std::move(flipped);
+			}
+		}
+		build(grid_rows);
+	}
+
+	void RegionIndex::build(size_t grid_rows)
+	{
+		const size_t n = size();
+		rows = grid_rows > 0
+			? grid_rows
+			: std::clamp<size_t>(std::bit_ceil(static_cast<size_t>(std::sqrt(static_cast<double>(rings.size())))), 8, 1024);
+		cols = 2 * rows;
+		const double row_height = std::numbers::pi / static_cast<double>(rows);
+		const double col_width = 2.0 * std::numbers::pi / static_cast<double>(cols);
+		const auto row_of = [&](double lat) {
+			const double k = std::floor((lat + 0.5 * std::numbers::pi) / row_height);
+			return static_cast<size_t>(std::clamp(k, 0.0, static_cast<double>(rows - 1)));
+		};
+
+		// Calls f once per grid cell touched by the ring caps of region r
+		std::vector<uint32_t> mark(rows * cols, unmarked);
+		const auto visit = [&](uint32_t r, auto&& f) {
+			for (size_t k = ring_offsets[r]; k < ring_offsets[r + 1]; ++k)
+			{
+				if (rings[k].size() < 3)
+				{
+					continue;
+				}
+				const CapRect rect = rect_bound(rings[k].cap());
+				ptrdiff_t c0 = 0, c1 = static_cast<ptrdiff_t>(cols) - 1;
+				if (!rect.full_lon)
+				{
+					c0 = static_cast<ptrdiff_t>(std::floor((rect.lon_lo + std::numbers::pi) / col_width));
+					c1 = static_cast<ptrdiff_t>(std::floor((rect.lon_hi + std::numbers::pi) / col_width));
+					if (c1 - c0 + 1 >= static_cast<ptrdiff_t>(cols))
+					{
+						c0 = 0;
+						c1 = static_cast<ptrdiff_t>(cols) - 1;
+					}
+				}
+				const ptrdiff_t m = static_cast<ptrdiff_t>(cols);
+				for (size_t row = row_of(rect.lat_lo); row <= row_of(rect.lat_hi); ++row)
+				{
+					for (ptrdiff_t c = c0; c <= c1; ++c)
+					{
+						const size_t cell = row * cols + static_cast<size_t>(((c % m) + m) % m);
+						if (mark[cell] != r)
+						{
+							mark[cell] = r;
+							f(cell);
+						}
+					}
+				}
+			}
+		};
+
+		std::vector<uint32_t> bounded;
+		bounded.reserve(n);
+		for (size_t r = 0; r < n; ++r)
+		{
+			bool full = false;
+			for (size_t k = ring_offsets[r]; k < ring_offsets[r + 1]; ++k)
+			{
+				full |= rings[k].size() >= 3 && rings[k].cap().is_full();
+			}
+			(full ? unbounded : bounded).push_back(static_cast<uint32_t>(r));
+		}
+
+		// Count, prefix-sum and fill the inverted index; regions are visited
+		// in ascending order, so every cell list comes out sorted
+		cell_offsets.assign(rows * cols + 1, 0);
+		for (const uint32_t r : bounded)
+		{
+			visit(r, [&](size_t cell) { ++cell_offsets[cell + 1]; });
+		}
+		for (size_t c = 0; c < rows * cols; ++c)
+		{
+			cell_offsets[c + 1] += cell_offsets[c];
+		}
+		candidates.resize(cell_offsets.back());
+		std::vector<size_t> cursor(cell_offsets.begin(), cell_offsets.end() - 1);
+		std::fill(mark.begin(), mark.end(), unmarked);
+		for (const uint32_t r : bounded)
+		{
+			visit(r, [&](size_t cell) { candidates[cursor[cell]++] = r; });
+		}
+	}
+
+	size_t RegionIndex::cell(const E3& p) const noexcept
+	{
+		const double lat = std::atan2(p.z, std::hypot(p.x, p.y));
+		const double lon = std::atan2(p.y, p.x);
+		const double row = std::floor((lat + 0.5 * std::numbers::pi) * static_cast<double>(rows) / std::numbers::pi);
+		const double col = std::floor((lon + std::numbers::pi) * static_cast<double>(cols) / (2.0 * std::numbers::pi));
+		return static_cast<size_t>(std::clamp(row, 0.0, static_cast<double>(rows - 1))) * cols
+			+ static_cast<size_t>(std::clamp(col, 0.0, static_cast<double>(cols - 1)));
+	}
+
+	bool RegionIndex::contains(size_t region, const E3& p, PreparedPolygon::Scratch& scratch) const
+	{
+		bool inside = false;
+		for (size_t k = ring_offsets[region]; k < ring_offsets[region + 1]; ++k)
+		{
+			inside ^= rings[k].contains(p, scratch);
+		}
+		return inside;
+	}
+
+	bool RegionIndex::contains(size_t region, const E3& p) const
+	{
+		PreparedPolygon::Scratch scratch;
+		return contains(region, p, scratch);
+	}
+
+	size_t RegionIndex::locate(const E3& p, PreparedPolygon::Scratch& scratch) const
+	{
+		const size_t c = cell(p);
+		size_t best = npos;
+		for (size_t i = cell_offsets[c]; i < cell_offsets[c + 1]; ++i)
+		{
+			if (contains(candidates[i], p, scratch))
+			{
+				best = candidates[i];
+				break;
+			}
+		}
+		for (const uint32_t r : unbounded)
+		{
+			if (r >= best)
+			{
+				break;
+			}
+			if (contains(r, p, scratch))
+			{
+				return r;
+			}
+		}
+		return best;
+	}
+
+	size_t RegionIndex::locate(const E3& p) const
+	{
+		PreparedPolygon::Scratch scratch;
+		return locate(p, scratch);
+	}
+
+	std::vector<size_t> RegionIndex::locate_all(const E3& p) const
+	{
+		PreparedPolygon::Scratch scratch;
+		std::vector<size_t> out;
+		const size_t c = cell(p);
+		for (size_t i = cell_offsets[c]; i < cell_offsets[c + 1]; ++i)
+		{
+			if (contains(candidates[i], p, scratch))
+			{
+				out.push_back(candidates[i]);
+			}
+		}
+		const size_t bounded = out.size();
+		for (const uint32_t r : unbounded)
+		{
+			if (contains(r, p, scratch))
+			{
+				out.push_back(r);
+			}
+		}
+		std::inplace_merge(out.begin(), out.begin() + static_cast<ptrdiff_t>(bounded), out.end());
+		return out;
+	}
+
+	void RegionIndex::locate(std::span<const E3> points, std::span<size_t> out, unsigned threads) const
+	{
+		assert(points.size() == out.size());
+		parallel_for(points.size(), [&](size_t begin, size_t end) {
+			PreparedPolygon::Scratch scratch;
+			for (size_t i = begin; i < end; ++i)
+			{
+				out[i] = locate(points[i], scratch);
+			}
+		}, threads, 256);
+	}
+
+	size_t RegionIndex::memory_usage() const noexcept
+	{
+		size_t bytes = rings.capacity() * sizeof(PreparedPolygon)
+			+ (ring_offsets.capacity() + cell_offsets.capacity()) * sizeof(size_t)
+			+ (candidates.capacity() + unbounded.capacity()) * sizeof(uint32_t);
+		for (const PreparedPolygon& ring : rings)
+		{
+			bytes += ring.memory_usage();
+		}
+		return bytes;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <S2LL/Core/Containment.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Point-location index over a set of Compound regions of spherical
+	/// polygons. A point lies in a region when it is inside an odd number of
+	/// its rings, so holes and disjoint parts follow from the ring list alone.
+	/// A ring whose vertices fit in a hemisphere is taken to bound the smaller
+	/// of its two sides, whatever its orientation (shapefile outer rings run
+	/// clockwise); larger rings keep the interior-on-the-left convention.
+	///
+	/// Built once: every ring is prepared for exact containment, and each
+	/// region is filed under the cells of a latitude/longitude grid touched by
+	/// the bounding rectangles of its ring caps, in a CSR inverted index.
+	/// Regions with a ring too large for a cap are checked for every query. A
+	/// query tests only the regions filed under its cell, with the exact
+	/// predicates, so the result does not depend on the grid.
+	class RegionIndex
+	{
+		// Prepared rings, region after region: region r owns the rings
+		// [ring_offsets[r], ring_offsets[r + 1])
+		std::vector<PreparedPolygon> rings;
+		std::vector<size_t> ring_offsets{ 0 };
+
+		// Grid of rows x cols cells, row-major from the south pole and from
+		// longitude -pi; cell c lists the regions
+		// candidates[cell_offsets[c] .. cell_offsets[c + 1]) in ascending order
+		size_t rows = 0, cols = 0;
+		std::vector<size_t> cell_offsets;
+		std::vector<uint32_t> candidates;
+
+		// Regions with an unbounded ring, ascending
+		std::vector<uint32_t> unbounded;
+
+		void build(size_t grid_rows);
+
+		size_t cell(const E3& p) const noexcept;
+
+		bool contains(size_t region, const E3& p, PreparedPolygon::Scratch& scratch) const;
+
+		size_t locate(const E3& p, PreparedPolygon::Scratch& scratch) const;
+
+	public:
+		/// Result of locate for points in no region
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		/// Indexes the parts of a flat compound set; grid_rows = 0 sizes the
+		/// grid from the number of rings
+		explicit RegionIndex(const FlatCompoundSet<E3>& regions, size_t grid_rows = 0);
+
+		/// Indexes nested Compound polygons
+		template <size_t N>
+		explicit RegionIndex(const std::vector<Compound<GP<N>>>& regions, size_t grid_rows = 0)
+			: RegionIndex(FlatCompoundSet<E3>::from(regions), grid_rows)
+		{
+		}
+
+		/// Number of regions
+		inline size_t size() const noexcept { return ring_offsets.size() - 1; }
+
+		/// True if the direction p lies in the given region
+		bool contains(size_t region, const E3& p) const;
+
+		/// Lowest-numbered region containing the direction p, or npos
+		size_t locate(const E3& p) const;
+
+		/// All regions containing the direction p, ascending
+		std::vector<size_t> locate_all(const E3& p) const;
+
+		/// Batch location: out[i] = locate(points[i]). The spans must have the
+		/// same length; the points are split among up to `threads` threads
+		/// (0: one per hardware thread).
+		void locate(std::span<const E3> points, std::span<size_t> out, unsigned threads = 1) const;
+
+		/// Heap bytes held by the index, prepared rings included
+		size_t memory_usage() const noexcept;
+	};
+}
@@ -1,12 +1,20 @@
 #pragma once
 
 #include <S2LL/Core/Coordinates.hpp>
+#include <S2LL/Core/Geodesics.hpp>
 #include <S2LL/Core/Surfaces.hpp>
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace S2LL
@@ -32,17 +40,186 @@ namespace S2LL
 		V a, b;
 	};
 
+	class GeodesicArcFrame;
+
+	/// Closest point of an arc to a query point: the point itself, its arc
+	/// length from the start of the arc and its surface distance to the query
+	struct ArcProjection
+	{
+		E3 point;
+		double s;
+		double distance;
+	};
+
 	// Shortest-path edge along the surface between two vertices. On a sphere this
 	// is the minor great-circle arc; on a general ellipsoid it is the ellipsoidal
 	// geodesic, whose shape might not be uniquely defined and depends on the
 	// ellipsoid.
 	//
-	// Placeholder: currently stores only the endpoints; the ellipsoid enters the
-	// picture through the edge factory (and will drive the arc's geometry once it
-	// is implemented).
+	// Vertices are taken as directions from the center: each one stands for the
+	// surface point on its ray. Geodesics are solved on spheres and oblate
+	// spheroids; on triaxial surfaces the queries yield NaN.
 	struct GeodesicArc
 	{
 		E3 a, b;
+		Ellipsoid surface;
+
+		/// Precomputed frame (sphere) or geodesic line (spheroid) for repeated
+		/// queries; a solver for the surface may be passed in to be shared
+		GeodesicArcFrame frame() const;
+		GeodesicArcFrame frame(const GeodesicSolver& g) const;
+
+		/// Surface length of the arc
+		double length() const;
+
+		/// Surface point at the given fraction of the arc length from a
+		E3 interpolate(double fraction) const;
+
+		/// Writes num_segments + 1 points, evenly spaced by arc length from a
+		/// to b, to out
+		template <std::output_iterator<E3> It>
+		It sample(int num_segments, It out) const;
+
+		/// Closest point of the arc to the surface point on the ray of p
+		ArcProjection closest(const E3& p) const;
+
+		/// Surface distance from the surface point on the ray of p to the arc
+		double distance(const E3& p) const;
+	};
+
+	/// Precomputed geometry of a geodesic arc. On a sphere it is the
+	/// orthonormal frame of the great circle, and points follow by slerp; on a
+	/// spheroid it is the geodesic line from a towards b, whose series
+	/// coefficients are evaluated once, together with the solver needed for
+	/// distance queries.
+	class GeodesicArcFrame
+	{
+		E3 pa, pb;		// surface images of the endpoints
+		E3 u, w;		// orthonormal frame of the great circle (sphere)
+		double radius;	// sphere radius, zero on a spheroid
+		double theta;	// central angle (sphere)
+		double s12;		// surface length
+		const GeodesicSolver* solver = nullptr;		// caller's or owned (spheroid)
+		std::shared_ptr<const GeodesicSolver> owned;	// built when none is given
+		std::optional<GeodesicLine> line;
+		Ellipsoid surface;
+
+		void init(const GeodesicArc& arc);
+
+	public:
+		explicit GeodesicArcFrame(const GeodesicArc& arc);
+
+		/// Refers to the solver g, which must have been built for arc.surface
+		/// and must outlive the frame
+		GeodesicArcFrame(const GeodesicArc& arc, const GeodesicSolver& g);
+
+		/// Surface length of the arc
+		inline double length() const noexcept { return s12; }
+
+		/// Surface point at signed arc length s from a
+		E3 at_distance(double s) const noexcept;
+
+		/// Surface point at the given fraction of the arc length from a
+		inline E3 interpolate(double fraction) const noexcept { return at_distance(fraction * s12); }
+
+		/// Writes num_segments + 1 points, evenly spaced by arc length from a
+		/// to b, to out. On a sphere successive points are advanced by a fixed
+		/// rotation instead of per-sample trigonometry; the endpoints are
+		/// written exactly.
+		template <std::output_iterator<E3> It>
+		It sample(int num_segments, It out) const
+		{
+			out = sample_open(num_segments, out);
+			if (num_segments > 0)
+			{
+				*out++ = pb;
+			}
+			return out;
+		}
+
+		/// Writes the points of sample(num_segments, out) except b, so that
+		/// consecutive edges chain into a ring without duplicates
+		template <std::output_iterator<E3> It>
+		It sample_open(int num_segments, It out) const
+		{
+			*out++ = pa;
+			if (radius > 0.0)
+			{
+				const double h = theta / num_segments;
+				const double ch = std::cos(h), sh = std::sin(h);
+				double c = 1.0, s = 0.0;
+				for (int i = 1; i < num_segments; ++i)
+				{
+					const double cn = c * ch - s * sh;
+					s = s * ch + c * sh;
+					c = cn;
+					*out++ = (u * c + w * s) * radius;
+				}
+			}
+			else
+			{
+				for (int i = 1; i < num_segments; ++i)
+				{
+					*out++ = at_distance(s12 * i / num_segments);
+				}
+			}
+			return out;
+		}
+
+		/// Closest point of the arc to the surface point on the ray of p.
+		/// On a spheroid the foot of the perpendicular geodesic is found by a
+		/// safeguarded root search along the line.
+		ArcProjection closest(const E3& p) const noexcept;
+
+		/// Surface distance from the surface point on the ray of p to the arc
+		inline double distance(const E3& p) const noexcept { return closest(p).distance; }
+	};
+
+	inline GeodesicArcFrame GeodesicArc::frame() const
+	{
+		return GeodesicArcFrame(*this);
+	}
+
+	inline GeodesicArcFrame GeodesicArc::frame(const GeodesicSolver& g) const
+	{
+		return GeodesicArcFrame(*this, g);
+	}
+
+	inline double GeodesicArc::length() const
+	{
+		return frame().length();
+	}
+
+	inline E3 GeodesicArc::interpolate(double fraction) const
+	{
+		return frame().interpolate(fraction);
+	}
+
+	template <std::output_iterator<E3> It>
+	inline It GeodesicArc::sample(int num_segments, It out) const
+	{
+		return frame().sample(num_segments, out);
+	}
+
+	inline ArcProjection GeodesicArc::closest(const E3& p) const
+	{
+		return frame().closest(p);
+	}
+
+	inline double GeodesicArc::distance(const E3& p) const
+	{
+		return frame().distance(p);
+	}
+
+	class EllipticArcFrame;
+
+	/// Solution of the inverse problem along an elliptic arc: its length and
+	/// the forward azimuths at both ends (radians, clockwise from north)
+	struct EllipticArcInverse
+	{
+		double s12;
+		double azi1;
+		double azi2;
 	};
 
 	// Edge traced by the intersection of the surface with the plane through the
@@ -60,27 +237,180 @@ namespace S2LL
 		/// sphere and pushed through the transformation.
 		inline std::vector<E3> sample(int num_segments = 32) const
 		{
-			std::vector<E3> points;
-			points.reserve(static_cast<size_t>(num_segments) + 1);
+			std::vector<E3> points(static_cast<size_t>(num_segments) + 1);
+			sample(std::span<E3>(points));
+			return points;
+		}
 
-			E3 u = a.normalized();
-			E3 v = b.normalized();
+		/// Writes num_segments + 1 evenly spaced (in pre-image angle) world
+		/// points from a to b to out, without allocating. Successive points
+		/// are advanced by a fixed rotation instead of per-sample trigonometry.
+		template <std::output_iterator<E3> It>
+		It sample(int num_segments, It out) const
+		{
+			E3 U, W;
+			const double theta = section(U, W);
+			const double h = theta / num_segments;
+			const double ch = std::cos(h), sh = std::sin(h);
+			double c = 1.0, s = 0.0;
+			*out++ = U;
+			for (int i = 1; i < num_segments; ++i)
+			{
+				const double cn = c * ch - s * sh;
+				s = s * ch + c * sh;
+				c = cn;
+				*out++ = U * c + W * s;
+			}
+			if (num_segments > 0)
+			{
+				*out++ = U * std::cos(theta) + W * std::sin(theta);
+			}
+			return out;
+		}
 
-			double d = std::clamp(u.dot(v), -1.0, 1.0);
-			double theta = std::acos(d);
-			E3 w = (v - u * d).normalized();
+		/// Fills out with out.size() evenly spaced world points from a to b
+		inline void sample(std::span<E3> out) const
+		{
+			if (!out.empty())
+			{
+				sample(static_cast<int>(out.size() - 1), out.begin());
+			}
+		}
 
-			for (int i = 0; i <= num_segments; ++i)
+		/// Smallest segment count whose chords stay within the given world
+		/// distance of the arc. With step h in pre-image angle, a chord's
+		/// midpoint is off the arc by P(t) (1 - cos(h / 2)), so the bound
+		/// follows from the world semi-major axis of the section.
+		inline int segments(double tolerance) const noexcept
+		{
+			E3 U, W;
+			const double theta = section(U, W);
+			const double uu = U.dot(U), ww = W.dot(W), uw = U.dot(W);
+			const double major = std::sqrt(0.5 * (uu + ww) + std::hypot(0.5 * (uu - ww), uw));
+			if (!(tolerance > 0.0) || tolerance >= major)
 			{
-				double t = static_cast<double>(i) / num_segments;
-				double angle = t * theta;
-				E3 p = (std::cos(angle) * u + std::sin(angle) * w) * radius;
-				points.push_back(transform(p));
+				return tolerance > 0.0 ? 1 : 0;
 			}
-			return points;
+			const double h = 2.0 * std::acos(1.0 - tolerance / major);
+			return std::max(1, static_cast<int>(std::ceil(theta / h)));
+		}
+
+		/// Samples the arc with as few points as keep every chord within the
+		/// given world distance of it (see segments); writes to out
+		template <std::output_iterator<E3> It>
+		It sample_within(double tolerance, It out) const
+		{
+			return sample(segments(tolerance), out);
+		}
+
+		/// Precomputed frame for repeated length, azimuth and point queries
+		EllipticArcFrame frame() const;
+
+		/// World-space arc length from a to b
+		double length() const;
+
+		/// Arc length and end azimuths
+		EllipticArcInverse inverse() const;
+
+		/// World point at the given fraction of the arc length from a
+		E3 interpolate(double fraction) const;
+
+	private:
+		/// World images U, W of the orthonormal pre-image frame (times the
+		/// radius); returns the pre-image central angle
+		inline double section(E3& U, E3& W) const noexcept
+		{
+			const E3 u = a.normalized();
+			const E3 v = b.normalized();
+			const double d = u.dot(v);
+			const E3 w = (v - u * d).normalized();
+			U = transform(u * radius);
+			W = transform(w * radius);
+			return std::atan2(u.cross(v).mag(), d);
+		}
+	};
+
+	/// Precomputed geometry of an elliptic arc. The world arc is
+	/// P(t) = U cos(t) + W sin(t) for the pre-image angle t in [0, angle()],
+	/// where U and W are the images of the orthonormal pre-image frame. The
+	/// principal axes of that ellipse are found once, so that arc length is an
+	/// incomplete elliptic integral of the second kind (Carlson's symmetric
+	/// forms) and point-at-distance is a short Newton iteration.
+	class EllipticArcFrame
+	{
+		E3 U, W;		// world images of the pre-image frame, times the radius
+		E3 H;			// world image of the pre-image pole u x w
+		double theta;	// pre-image central angle
+		double phase;	// pre-image angle of the major axis
+		double major, minor;
+		double k2;		// 1 - (minor / major)^2
+		double complete;	// E(k), the integral over a quarter period
+		double e0;		// E(pi / 2 - phase), the integral at t = 0
+		double total;
+
+		double integral(double t) const noexcept;
+
+	public:
+		explicit EllipticArcFrame(const EllipticArc& arc);
+
+		/// Pre-image central angle of the arc (radians)
+		inline double angle() const noexcept { return theta; }
+
+		/// World-space arc length
+		inline double length() const noexcept { return total; }
+
+		/// World point at pre-image angle t
+		inline E3 point(double t) const noexcept
+		{
+			return U * std::cos(t) + W * std::sin(t);
+		}
+
+		/// Arc length from a to the point at pre-image angle t (signed)
+		inline double length_to(double t) const noexcept
+		{
+			return major * (integral(t) - e0);
+		}
+
+		/// Pre-image angle of the point at signed arc length s from a
+		double angle_at(double s) const noexcept;
+
+		/// World point at signed arc length s from a
+		inline E3 at_distance(double s) const noexcept { return point(angle_at(s)); }
+
+		/// World point at the given fraction of the arc length from a
+		inline E3 interpolate(double fraction) const noexcept { return at_distance(fraction * total); }
+
+		/// Forward azimuth (radians, clockwise from the world +z meridian) at
+		/// pre-image angle t; zero where the surface normal is along z
+		double azimuth(double t) const noexcept;
+
+		/// Arc length and end azimuths
+		inline EllipticArcInverse inverse() const noexcept
+		{
+			return EllipticArcInverse{ total, azimuth(0.0), azimuth(theta) };
 		}
 	};
 
+	inline EllipticArcFrame EllipticArc::frame() const
+	{
+		return EllipticArcFrame(*this);
+	}
+
+	inline double EllipticArc::length() const
+	{
+		return frame().length();
+	}
+
+	inline EllipticArcInverse EllipticArc::inverse() const
+	{
+		return frame().inverse();
+	}
+
+	inline E3 EllipticArc::interpolate(double fraction) const
+	{
+		return frame().interpolate(fraction);
+	}
+
 	// Edge-model traits. Every supported (geometry tag, vertex type) combination
 	// specializes EdgeTraits with an edge_type and an edge(a, b, e) factory.
 	// The primary template is intentionally undefined: an unspecialized
@@ -138,11 +468,11 @@ namespace S2LL
 	{
 		using edge_type = GeodesicArc;
 
-		static constexpr GeodesicArc edge(
-			const E3& a, const E3& b, const Ellipsoid&,
+		static inline GeodesicArc edge(
+			const E3& a, const E3& b, const Ellipsoid& e,
 			const LinearTransformation& = LinearTransformation{})
 		{
-			return GeodesicArc{ a, b };
+			return GeodesicArc{ a, b, e };
 		}
 	};
 
@@ -199,14 +529,248 @@ namespace S2LL
 	template <size_t N = 0>
 	using GP = PolygonBase<E3, EdgeTag::Geodesic, N>;
 
-	/// Placeholder: Algebraic representation of Compound polygons
+	/// Perimeter of a great elliptic polygon on the given (sheared) surface
+	template <size_t N>
+	inline double perimeter(
+		const GEP<N>& poly, const Ellipsoid& e = UnitSphere,
+		const LinearTransformation& T = LinearTransformation{})
+	{
+		Double sum{};
+		for (size_t i = 0; i < poly.size(); ++i)
+		{
+			sum = sum + poly.edge(static_cast<ptrdiff_t>(i), e, T).length();
+		}
+		return static_cast<double>(sum);
+	}
+
+	/// Samples the whole boundary of a geodesic polygon into one contiguous
+	/// ring: every edge contributes its first num_segments points (its end
+	/// is the start of the next edge), so out receives size() * num_segments
+	/// points (num_segments must be positive). On a spheroid one solver
+	/// serves all the edges.
+	template <size_t N, std::output_iterator<E3> It>
+	It sample_boundary(const GP<N>& poly, int num_segments, It out, const Ellipsoid& e = UnitSphere)
+	{
+		const std::optional<GeodesicSolver> g = e.is_sphere()
+			? std::nullopt : std::optional<GeodesicSolver>(std::in_place, e);
+		for (size_t i = 0; i < poly.size(); ++i)
+		{
+			const GeodesicArc arc = poly.edge(static_cast<ptrdiff_t>(i), e);
+			out = (g ? arc.frame(*g) : arc.frame()).sample_open(num_segments, out);
+		}
+		return out;
+	}
+
+	/// Spherical cap: the directions within an angle r of a unit axis, stored
+	/// as cos r. cos r <= -1 is the full sphere.
+	struct Cap
+	{
+		E3 axis{ 0.0, 0.0, 1.0 };
+		double cos_radius = -1.0;
+
+		/// The cap covering every direction
+		static constexpr Cap full() noexcept { return Cap{}; }
+
+		/// True if the cap covers every direction
+		constexpr bool is_full() const noexcept { return cos_radius <= -1.0; }
+
+		/// Angular radius
+		inline double radius() const noexcept { return is_full() ? std::numbers::pi : std::acos(cos_radius); }
+
+		/// True if the direction p (not necessarily unit) lies in the cap
+		constexpr bool contains(const E3& p) const noexcept
+		{
+			if (is_full())
+			{
+				return true;
+			}
+			// Compare d = p . axis with cos r |p| without a square root
+			const double d = p.x * axis.x + p.y * axis.y + p.z * axis.z;
+			const double rhs = cos_radius * cos_radius * (p.x * p.x + p.y * p.y + p.z * p.z);
+			return cos_radius >= 0.0
+				? d >= 0.0 && d * d >= rhs
+				: d >= 0.0 || d * d <= rhs;
+		}
+	};
+
+	/// Compound polygon: a list of rings (outer boundaries and holes) making
+	/// up one region. RegionIndex and overlay() read a point as inside when
+	/// it lies in an odd number of the rings.
 	template <typename T>
 	struct Compound
 	{
-
 		std::vector<T> polygons;
 	};
 
+	/// Flat (CSR) storage of a collection of Compound polygons: one contiguous
+	/// vertex buffer, ring offsets into the vertex buffer, and part offsets into
+	/// the ring offsets (one part per Compound). Ring r spans the vertices
+	/// [ring_offsets[r], ring_offsets[r + 1]); part c spans the rings
+	/// [part_offsets[c], part_offsets[c + 1]). Bulk algorithms stream over
+	/// `vertices` directly instead of chasing three levels of vectors.
+	template <typename V>
+	struct FlatCompoundSet
+	{
+		using value_type = V;
+
+		/// Read-only view of one part: its rings as LoopViews into the buffer
+		class PartView
+		{
+			const FlatCompoundSet* set;
+			size_t first, last;
+
+		public:
+			constexpr PartView(const FlatCompoundSet& s, size_t first, size_t last) noexcept
+				: set(&s), first(first), last(last) {}
+
+			/// Number of rings in this part
+			constexpr size_t size() const noexcept { return last - first; }
+
+			/// Index of the first ring of this part within the whole set
+			constexpr size_t first_ring() const noexcept { return first; }
+
+			/// The i-th ring of this part
+			constexpr LoopView<V> operator[](size_t i) const noexcept { return set->ring(first + i); }
+
+			/// All vertices of this part, contiguous across its rings
+			constexpr LoopView<V> vertices() const noexcept
+			{
+				const size_t b = set->ring_offsets[first];
+				const size_t e = set->ring_offsets[last];
+				return LoopView<V>(set->vertices.data() + b, e - b);
+			}
+		};
+
+		/// All ring vertices, ring after ring and part after part
+		std::vector<V> vertices;
+
+		/// Vertex index at which each ring starts, plus the total vertex count
+		std::vector<size_t> ring_offsets{ 0 };
+
+		/// Ring index at which each part starts, plus the total ring count
+		std::vector<size_t> part_offsets{ 0 };
+
+		/// Number of parts (Compound polygons)
+		constexpr size_t size() const noexcept { return part_offsets.size() - 1; }
+
+		/// True if the set holds no parts
+		constexpr bool empty() const noexcept { return size() == 0; }
+
+		/// Total number of rings over all parts
+		constexpr size_t ring_count() const noexcept { return ring_offsets.size() - 1; }
+
+		/// The r-th ring over all parts as a view into the vertex buffer
+		constexpr LoopView<V> ring(size_t r) const noexcept
+		{
+			const size_t b = ring_offsets[r];
+			return LoopView<V>(vertices.data() + b, ring_offsets[r + 1] - b);
+		}
+
+		/// View of the c-th part
+		constexpr PartView operator[](size_t c) const noexcept
+		{
+			return PartView(*this, part_offsets[c], part_offsets[c + 1]);
+		}
+
+		/// Removes all parts, keeping the allocated capacity
+		void clear() noexcept
+		{
+			vertices.clear();
+			ring_offsets.assign(1, 0);
+			part_offsets.assign(1, 0);
+		}
+
+		/// Reserves capacity for the given numbers of parts, rings and vertices
+		void reserve(size_t parts, size_t rings, size_t verts)
+		{
+			part_offsets.reserve(parts + 1);
+			ring_offsets.reserve(rings + 1);
+			vertices.reserve(verts);
+		}
+
+		/// Appends a ring to the last part (opened by begin_part)
+		void push_ring(LoopView<V> ring)
+		{
+			assert(!empty());
+			vertices.insert(vertices.end(), ring.begin(), ring.end());
+			ring_offsets.push_back(vertices.size());
+			part_offsets.back() = ring_count();
+		}
+
+		/// Opens a new, empty part; subsequent push_ring calls fill it
+		void begin_part()
+		{
+			part_offsets.push_back(ring_count());
+		}
+
+		/// Appends a Compound polygon as a new part
+		template <typename P>
+			requires std::is_same_v<typename P::vertex_type, V>
+		void push_back(const Compound<P>& c)
+		{
+			begin_part();
+			for (const auto& poly : c.polygons)
+			{
+				push_ring(poly.boundary);
+			}
+		}
+
+		/// Rebuilds the c-th part as a nested Compound polygon
+		template <typename P>
+			requires std::is_same_v<typename P::vertex_type, V>
+		Compound<P> compound(size_t c) const
+		{
+			const PartView part = (*this)[c];
+			Compound<P> out;
+			out.polygons.resize(part.size());
+			for (size_t i = 0; i < part.size(); ++i)
+			{
+				const LoopView<V> r = part[i];
+				out.polygons[i].boundary.vertices.assign(r.begin(), r.end());
+			}
+			return out;
+		}
+
+		/// Flattens nested Compound polygons, allocating each buffer once
+		template <typename P>
+			requires std::is_same_v<typename P::vertex_type, V>
+		static FlatCompoundSet from(const std::vector<Compound<P>>& nested)
+		{
+			size_t rings = 0;
+			size_t verts = 0;
+			for (const auto& c : nested)
+			{
+				rings += c.polygons.size();
+				for (const auto& poly : c.polygons)
+				{
+					verts += poly.size();
+				}
+			}
+
+			FlatCompoundSet flat;
+			flat.reserve(nested.size(), rings, verts);
+			for (const auto& c : nested)
+			{
+				flat.push_back(c);
+			}
+			return flat;
+		}
+
+		/// Expands back into nested Compound polygons
+		template <typename P>
+			requires std::is_same_v<typename P::vertex_type, V>
+		std::vector<Compound<P>> to() const
+		{
+			std::vector<Compound<P>> nested;
+			nested.reserve(size());
+			for (size_t c = 0; c < size(); ++c)
+			{
+				nested.push_back(compound<P>(c));
+			}
+			return nested;
+		}
+	};
+
 	// Fixed-size polygon flavors are plain-old-data: trivial
 	// (including default construction) and standard-layout
 	S2LL_ASSERT_POD(PlanePolygon<4>);
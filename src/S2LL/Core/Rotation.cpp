@@ -0,0 +1,85 @@
+#include <cmath>
+#include <S2LL/Core/Rotations.hpp>
+#include <S2LL/Core/Numerics.hpp>
+
+namespace S2LL
+{
+	Rotation Rotation::axis_angle(const E3& axis, const Double& angle)
+	{
+		const Double n = axis.Mag();
+		const auto [s, c] = SinCos(Mul(angle, 0.5));
+		const Double k = Div(s, n);
+		return Rotation{ c, Mul(axis.x, k), Mul(axis.y, k), Mul(axis.z, k) };
+	}
+
+	Rotation Rotation::between(const E3& from, const E3& to)
+	{
+		// q = (|f||t| + f.t, f x t), normalized: the half-angle quaternion
+		// without any trigonometry (Shoemake 1985)
+		const Double cx = Mul(from.y, to.z) - Mul(from.z, to.y);
+		const Double cy = Mul(from.z, to.x) - Mul(from.x, to.z);
+		const Double cz = Mul(from.x, to.y) - Mul(from.y, to.x);
+		const Double d = Mul(from.x, to.x) + Mul(from.y, to.y) + Mul(from.z, to.z);
+		const Double w = Mul(from.Mag(), to.Mag()) + d;
+
+		Rotation q{ w, cx, cy, cz };
+		const double scale = std::abs(static_cast<double>(Mul(from.Mag(), to.Mag())));
+		if (static_cast<double>(w) <= 1e-15 * scale)
+		{
+			// Antipodal: half-turn about any axis perpendicular to `from`,
+			// crossing with the coordinate axis least aligned with it
+			const double ax = std::abs(from.x), ay = std::abs(from.y), az = std::abs(from.z);
+			const E3 e = (ax <= ay && ax <= az) ? E3{ 1.0, 0.0, 0.0 }
+				: (ay <= az ? E3{ 0.0, 1.0, 0.0 } : E3{ 0.0, 0.0, 1.0 });
+			const E3 axis = from.cross(e);
+			q = Rotation{ Double::Zero, Lift(axis.x), Lift(axis.y), Lift(axis.z) };
+		}
+		return q.normalize();
+	}
+
+	Rotation Rotation::from_matrix(const RotationMatrix& r)
+	{
+		const double* m = r.m;
+		const double tr = m[0] + m[4] + m[8];
+		Rotation q;
+		// Pick the largest of 4w^2, 4x^2, 4y^2, 4z^2 as the pivot so the
+		// division below never amplifies round-off
+		if (tr >= m[0] && tr >= m[4] && tr >= m[8])
+		{
+			const Double s = Mul(Sqrt(Add(1.0, tr)), 2.0);
+			q = Rotation{ Mul(s, 0.25), Div(m[7] - m[5], s), Div(m[2] - m[6], s), Div(m[3] - m[1], s) };
+		}
+		else if (m[0] >= m[4] && m[0] >= m[8])
+		{
+			const Double s = Mul(Sqrt(Add(1.0, m[0] - m[4] - m[8])), 2.0);
+			q = Rotation{ Div(m[7] - m[5], s), Mul(s, 0.25), Div(m[1] + m[3], s), Div(m[2] + m[6], s) };
+		}
+		else if (m[4] >= m[8])
+		{
+			const Double s = Mul(Sqrt(Add(1.0, m[4] - m[0] - m[8])), 2.0);
+			q = Rotation{ Div(m[2] - m[6], s), Div(m[1] + m[3], s), Mul(s, 0.25), Div(m[5] + m[7], s) };
+		}
+		else
+		{
+			const Double s = Mul(Sqrt(Add(1.0, m[8] - m[0] - m[4])), 2.0);
+			q = Rotation{ Div(m[3] - m[1], s), Div(m[2] + m[6], s), Div(m[5] + m[7], s), Mul(s, 0.25) };
+		}
+		return q.normalize();
+	}
+
+	Rotation& Rotation::normalize()
+	{
+		const Double n = Sqrt(Sq(w) + Sq(x) + Sq(y) + Sq(z));
+		w = Div(w, n);
+		x = Div(x, n);
+		y = Div(y, n);
+		z = Div(z, n);
+		return *this;
+	}
+
+	Double Rotation::angle() const
+	{
+		const Double s = Sqrt(Sq(x) + Sq(y) + Sq(z));
+		return Mul(Atan2(s, w.abs()), 2.0);
+	}
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+// References:
+// Shoemake, K. (1985). Animating rotation with quaternion curves. SIGGRAPH '85, 245-254. https://doi.org/10.1145/325165.325242
+// Shepperd, S. W. (1978). Quaternion from rotation matrix. Journal of Guidance and Control, 1(3), 223-224. https://doi.org/10.2514/3.55767b
+
+#include <S2LL/Core/Coordinates.hpp>
+#include <S2LL/Core/Numerics.hpp>
+#include <S2LL/Core/Utilities.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace S2LL
+{
+	/// Rotation matrix in plain doubles (3x3, row-major), the form consumed by
+	/// the fast batch kernel and by renderers
+	struct RotationMatrix
+	{
+		double m[9];
+
+		/// Applies the matrix to a point
+		inline E3 operator()(const E3& p) const noexcept
+		{
+			return E3{
+				m[0] * p.x + m[1] * p.y + m[2] * p.z,
+				m[3] * p.x + m[4] * p.y + m[5] * p.z,
+				m[6] * p.x + m[7] * p.y + m[8] * p.z
+			};
+		}
+	};
+
+	/// Rotation of 3D space about the origin, stored as a unit quaternion
+	/// w + xi + yj + zk in extended precision. Composition follows function
+	/// composition: (a * b)(p) == a(b(p)).
+	struct Rotation
+	{
+		Double w, x, y, z;
+
+		/// The identity rotation
+		static constexpr Rotation identity() noexcept
+		{
+			return Rotation{ Double{ 1.0, 0.0 }, Double{}, Double{}, Double{} };
+		}
+
+		/// Right-handed rotation by angle (radians) about the given axis; the
+		/// axis need not be normalized but must be nonzero
+		static Rotation axis_angle(const E3& axis, const Double& angle);
+
+		/// Scalar-lifting overload, mirroring Lift
+		template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+		static inline Rotation axis_angle(const E3& axis, const T& angle)
+		{
+			return axis_angle(axis, Lift(angle));
+		}
+
+		/// Rotation carrying direction `from` onto direction `to` along the
+		/// great circle through both (the minimal rotation). Antipodal inputs
+		/// rotate by pi about an arbitrary axis perpendicular to `from`.
+		static Rotation between(const E3& from, const E3& to);
+
+		/// Nearest unit quaternion to an orthonormal matrix (Shepperd 1978)
+		static Rotation from_matrix(const RotationMatrix& r);
+
+		/// The inverse (conjugate) rotation
+		constexpr Rotation inverse() const noexcept
+		{
+			return Rotation{ w, -x, -y, -z };
+		}
+
+		/// Rescales to unit norm; composing many rotations drifts slowly
+		Rotation& normalize();
+
+		/// Rotation angle in [0, pi]
+		Double angle() const;
+
+		/// Rotation matrix, rounded once per entry
+		RotationMatrix matrix() const;
+
+		/// Rotates a single point in extended precision
+		E3 operator()(const E3& p) const;
+
+		/// Rotates a span of points into an output span of the same size.
+		/// Precision::Fast runs a plain double 3x3 kernel; Precision::Accurate
+		/// evaluates each component in Double. `in` and `out` may alias.
+		template <typename P = Precision::Accurate>
+		void apply(std::span<const E3> in, std::span<E3> out) const;
+
+		/// Rotates a span of points in place
+		template <typename P = Precision::Accurate>
+		inline void apply(std::span<E3> points) const
+		{
+			apply<P>(std::span<const E3>(points.data(), points.size()), points);
+		}
+
+		/// Composition: applies b first, then a
+		friend Rotation operator*(const Rotation& a, const Rotation& b)
+		{
+			return Rotation{
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+				a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w
+			};
+		}
+
+	private:
+		/// Matrix entries in extended precision (row-major)
+		void entries(Double r[9]) const;
+	};
+
+	S2LL_ASSERT_POD(RotationMatrix);
+	S2LL_ASSERT_POD(Rotation);
+
+	inline void Rotation::entries(Double r[9]) const
+	{
+		const Double xx = Sq(x), yy = Sq(y), zz = Sq(z);
+		const Double xy = x * y, xz = x * z, yz = y * z;
+		const Double wx = w * x, wy = w * y, wz = w * z;
+		r[0] = 1.0 - 2.0 * (yy + zz);
+		r[1] = 2.0 * (xy - wz);
+		r[2] = 2.0 * (xz + wy);
+		r[3] = 2.0 * (xy + wz);
+		r[4] = 1.0 - 2.0 * (xx + zz);
+		r[5] = 2.0 * (yz - wx);
+		r[6] = 2.0 * (xz - wy);
+		r[7] = 2.0 * (yz + wx);
+		r[8] = 1.0 - 2.0 * (xx + yy);
+	}
+
+	inline RotationMatrix Rotation::matrix() const
+	{
+		Double r[9];
+		entries(r);
+		RotationMatrix out;
+		for (int i = 0; i < 9; ++i)
+		{
+			out.m[i] = static_cast<double>(r[i]);
+		}
+		return out;
+	}
+
+	inline E3 Rotation::operator()(const E3& p) const
+	{
+		Double r[9];
+		entries(r);
+		return E3{
+			static_cast<double>(r[0] * p.x + r[1] * p.y + r[2] * p.z),
+			static_cast<double>(r[3] * p.x + r[4] * p.y + r[5] * p.z),
+			static_cast<double>(r[6] * p.x + r[7] * p.y + r[8] * p.z)
+		};
+	}
+
+	template <typename P>
+	inline void Rotation::apply(std::span<const E3> in, std::span<E3> out) const
+	{
+		assert(in.size() == out.size());
+		const size_t n = in.size();
+		if constexpr (std::is_same_v<P, Precision::Fast>)
+		{
+			// Branch-free straight-line kernel over locals so the compiler can
+			// keep the matrix in registers and vectorize across points
+			const RotationMatrix r = matrix();
+			const double m0 = r.m[0], m1 = r.m[1], m2 = r.m[2];
+			const double m3 = r.m[3], m4 = r.m[4], m5 = r.m[5];
+			const double m6 = r.m[6], m7 = r.m[7], m8 = r.m[8];
+			const E3* src = in.data();
+			E3* dst = out.data();
+			for (size_t i = 0; i < n; ++i)
+			{
+				const double px = src[i].x, py = src[i].y, pz = src[i].z;
+				dst[i].x = m0 * px + m1 * py + m2 * pz;
+				dst[i].y = m3 * px + m4 * py + m5 * pz;
+				dst[i].z = m6 * px + m7 * py + m8 * pz;
+			}
+		}
+		else
+		{
+			static_assert(std::is_same_v<P, Precision::Accurate>, "unknown precision policy");
+			Double r[9];
+			entries(r);
+			for (size_t i = 0; i < n; ++i)
+			{
+				const E3 p = in[i];
+				out[i] = E3{
+					static_cast<double>(r[0] * p.x + r[1] * p.y + r[2] * p.z),
+					static_cast<double>(r[3] * p.x + r[4] * p.y + r[5] * p.z),
+					static_cast<double>(r[6] * p.x + r[7] * p.y + r[8] * p.z)
+				};
+			}
+		}
+	}
+}
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/Simplify.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Halvings of the tolerance tried before simple output gives up and
+		/// keeps the whole ring
+		constexpr int max_halvings = 64;
+
+		/// Area of the spherical triangle of the unit vectors a, b, c (Van
+		/// Oosterom & Strackee 1983)
+		inline double triangle_area(const E3& a, const E3& b, const E3& c) noexcept
+		{
+			const double det = plain_dot(a, plain_cross(b, c));
+			return 2.0 * std::abs(std::atan2(det, 1.0 + plain_dot(a, b) + plain_dot(b, c) + plain_dot(c, a)));
+		}
+
+		std::vector<size_t> douglas_peucker(const std::vector<E3>& u, double tolerance)
+		{
+			const size_t n = u.size();
+			std::vector<bool> keep(n, false);
+
+			// The closed ring is cut at vertex 0 and at the vertex farthest
+			// from it into two chains, simplified independently
+			size_t far = 1;
+			double far_angle = -1.0;
+			for (size_t i = 1; i < n; ++i)
+			{
+				const double t = angle(u[0], u[i]);
+				if (t > far_angle)
+				{
+					far = i;
+					far_angle = t;
+				}
+			}
+			keep[0] = keep[far] = true;
+
+			// Chains [i, j] with j == n standing for vertex 0
+			std::vector<std::pair<size_t, size_t>> stack{ { 0, far }, { far, n } };
+			size_t fallback = 0;
+			double fallback_distance = -1.0;
+			while (!stack.empty())
+			{
+				const auto [i, j] = stack.back();
+				stack.pop_back();
+				if (j - i < 2)
+				{
+					continue;
+				}
+				const E3& a = u[i];
+				const E3& b = u[j % n];
+				size_t worst = i + 1;
+				double worst_distance = -1.0;
+				for (size_t k = i + 1; k < j; ++k)
+				{
+					const double d = arc_distance(u[k], a, b);
+					if (d > worst_distance)
+					{
+						worst = k;
+						worst_distance = d;
+					}
+				}
+				if (worst_distance > tolerance)
+				{
+					keep[worst] = true;
+					stack.push_back({ i, worst });
+					stack.push_back({ worst, j });
+				}
+				else if (worst_distance > fallback_distance)
+				{
+					fallback = worst;
+					fallback_distance = worst_distance;
+				}
+			}
+
+			std::vector<size_t> kept;
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (keep[i])
+				{
+					kept.push_back(i);
+				}
+			}
+			// Two vertices make no ring: add back the farthest dropped one
+			if (kept.size() < 3)
+			{
+				kept.push_back(fallback);
+				std::sort(kept.begin(), kept.end());
+			}
+			return kept;
+		}
+
+		std::vector<size_t> visvalingam(const std::vector<E3>& u, double tolerance)
+		{
+			const size_t n = u.size();
+			const double threshold = tolerance * tolerance;
+			std::vector<size_t> prev(n), next(n);
+			std::vector<double> area(n);
+			for (size_t i = 0; i < n; ++i)
+			{
+				prev[i] = (i + n - 1) % n;
+				next[i] = (i + 1) % n;
+				area[i] = triangle_area(u[prev[i]], u[i], u[next[i]]);
+			}
+
+			// Min-heap of (area, vertex) with lazy deletion: an entry is stale
+			// when the area of its vertex has changed since it was pushed
+			using Entry = std::pair<double, size_t>;
+			std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+			for (size_t i = 0; i < n; ++i)
+			{
+				heap.push({ area[i], i });
+			}
+			std::vector<bool> removed(n, false);
+			size_t remaining = n;
+			while (remaining > 3 && !heap.empty())
+			{
+				const auto [a, i] = heap.top();
+				if (removed[i] || a != area[i])
+				{
+					heap.pop();
+					continue;
+				}
+				if (a >= threshold)
+				{
+					break;
+				}
+				heap.pop();
+				removed[i] = true;
+				--remaining;
+				const size_t p = prev[i], q = next[i];
+				next[p] = q;
+				prev[q] = p;
+
+				// A neighbour never gets a smaller area than the vertex just
+				// eliminated, so elimination runs in nondecreasing area
+				for (const size_t k : { p, q })
+				{
+					area[k] = std::max(a, triangle_area(u[prev[k]], u[k], u[next[k]]));
+					heap.push({ area[k], k });
+				}
+			}
+
+			std::vector<size_t> kept;
+			kept.reserve(remaining);
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (!removed[i])
+				{
+					kept.push_back(i);
+				}
+			}
+			return kept;
+		}
+
+		std::vector<size_t> run(const std::vector<E3>& u, SimplifyMethod method, double tolerance)
+		{
+			return method == SimplifyMethod::Visvalingam ? visvalingam(u, tolerance) : douglas_peucker(u, tolerance);
+		}
+
+		/// True if no two edges of the ring through the selected vertices
+		/// cross properly
+		bool is_simple(LoopView<E3> ring, const std::vector<size_t>& kept)
+		{
+			std::vector<E3> loop(kept.size());
+			std::transform(kept.begin(), kept.end(), loop.begin(), [&](size_t i) { return ring[i]; });
+			const EdgeBVH bvh(loop);
+			for (size_t i = 0; i < loop.size(); ++i)
+			{
+				if (bvh.crosses(loop[i], loop[(i + 1) % loop.size()]))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	std::vector<size_t> simplify_indices(LoopView<E3> ring, const SimplifyOptions& options)
+	{
+		const size_t n = ring.size();
+		std::vector<size_t> all(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			all[i] = i;
+		}
+		if (n <= 3)
+		{
+			return all;
+		}
+
+		std::vector<E3> u(n);
+		std::transform(ring.begin(), ring.end(), u.begin(), unit);
+		double tolerance = options.tolerance;
+		std::vector<size_t> kept = run(u, options.method, tolerance);
+		if (!options.simple)
+		{
+			return kept;
+		}
+		for (int k = 0; k < max_halvings && kept.size() < n; ++k)
+		{
+			if (is_simple(ring, kept))
+			{
+				return kept;
+			}
+			tolerance *= 0.5;
+			kept = run(u, options.method, tolerance);
+		}
+		return kept.size() < n && is_simple(ring, kept) ? kept : all;
+	}
+
+	std::vector<E3> simplify(LoopView<E3> ring, const SimplifyOptions& options)
+	{
+		const std::vector<size_t> kept = simplify_indices(ring, options);
+		std::vector<E3> out(kept.size());
+		std::transform(kept.begin(), kept.end(), out.begin(), [&](size_t i) { return ring[i]; });
+		return out;
+	}
+}
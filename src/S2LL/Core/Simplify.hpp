@@ -0,0 +1,74 @@
+#pragma once
+
+// References:
+// Douglas, D. H., & Peucker, T. K. (1973). Algorithms for the reduction of the number of points required to represent a digitized line or its caricature. Cartographica, 10(2), 112-122. https://doi.org/10.3138/FM57-6770-U75U-7727
+// Visvalingam, M., & Whyatt, J. D. (1993). Line generalisation by repeated elimination of points. The Cartographic Journal, 30(1), 46-51. https://doi.org/10.1179/000870493786962263
+
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace S2LL
+{
+	/// Vertex elimination rule of the simplification
+	enum class SimplifyMethod
+	{
+		/// Keeps every vertex farther than the tolerance from the arc that
+		/// would replace it, splitting recursively at the farthest vertex
+		DouglasPeucker,
+
+		/// Repeatedly drops the vertex whose triangle with its neighbours
+		/// has the smallest area, while that area is below tolerance^2
+		Visvalingam
+	};
+
+	/// Simplification parameters. The tolerance is a great-circle distance
+	/// in radians (divide a surface distance by the radius).
+	struct SimplifyOptions
+	{
+		SimplifyMethod method = SimplifyMethod::DouglasPeucker;
+		double tolerance = 0.0;
+
+		/// Rejects self-intersecting output: the tolerance is halved until
+		/// the simplified ring has no proper edge crossings, falling back to
+		/// the input ring
+		bool simple = false;
+	};
+
+	/// Indices, in ascending order, of the vertices of the ring kept by the
+	/// simplification. Rings keep at least three vertices; rings of three or
+	/// fewer are left unchanged. Distances and areas are measured between
+	/// the directions of the vertices, which need not be unit vectors.
+	std::vector<size_t> simplify_indices(LoopView<E3> ring, const SimplifyOptions& options);
+
+	/// Simplified copy of the ring (the kept vertices, unchanged)
+	std::vector<E3> simplify(LoopView<E3> ring, const SimplifyOptions& options);
+
+	/// Simplified copy of a geodesic polygon, read as a spherical polygon
+	template <size_t N>
+	inline GP<> simplify(const GP<N>& poly, const SimplifyOptions& options)
+	{
+		GP<> out;
+		out.boundary.vertices = simplify(LoopView<E3>(poly.boundary), options);
+		return out;
+	}
+
+	/// Simplified copy of a Compound region: every ring is simplified on its
+	/// own, the rings split among up to `threads` threads (0: one per
+	/// hardware thread)
+	template <size_t N>
+	Compound<GP<>> simplify(const Compound<GP<N>>& region, const SimplifyOptions& options, unsigned threads = 1)
+	{
+		Compound<GP<>> out;
+		out.polygons.resize(region.polygons.size());
+		parallel_for(region.polygons.size(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				out.polygons[i] = simplify(region.polygons[i], options);
+			}
+		}, threads, 1);
+		return out;
+	}
+}
@@ -4,8 +4,13 @@
 #include <S2LL/Core/Numerics.hpp>
 
 #include <array>
+#include <cassert>
+#include <cfenv>
 #include <cmath>
+#include <limits>
 #include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 namespace S2LL
@@ -22,6 +27,22 @@ namespace S2LL
 		/// Semi-minor axis length along the z axis
 		Double c;
 
+		/// First eccentricity squared, (a^2 - c^2) / a^2 (cached)
+		Double ecc2;
+
+		/// Second eccentricity squared, (a^2 - c^2) / c^2 (cached)
+		Double ecc2_prime;
+
+		/// Axis ratio c / a (cached)
+		Double ratio;
+
+		/// Derives the cached constants from the axes
+		void derive();
+
+		/// Accurate geodetic conversions (Ellipsoid.cpp)
+		E3 geodetic_E3(const LLH& g) const noexcept;
+		LLH geodetic_LLH(const E3& p) const noexcept;
+
 	public:
 		/// Constructs a spherical surface with uniform radius r
 		Ellipsoid(double r);
@@ -44,9 +65,32 @@ namespace S2LL
 		/// Returns true if the surface is a sphere (a == b == c)
 		inline bool is_sphere() const noexcept { return a == b && b == static_cast<double>(c); }
 
+		/// Returns true if the surface is a spheroid (a == b), the domain of
+		/// the geodetic conversions
+		inline bool is_spheroid() const noexcept { return a == b; }
+
 		/// Returns the inverse flattening of the ellipsoid
 		double inv_f() const;
 
+		/// Returns the radius of the authalic sphere, whose surface area equals
+		/// that of the spheroid
+		double authalic_radius() const noexcept;
+
+		/// Returns the authalic latitude of a geodetic latitude: its image on
+		/// the authalic sphere under the equal-area mapping that keeps
+		/// longitudes. Spheroids only; other surfaces raise FE_INVALID and
+		/// yield NaN.
+		double authalic_latitude(double lat) const noexcept;
+
+		/// Returns the first eccentricity squared, (a^2 - c^2) / a^2
+		inline const Double& e2() const noexcept { return ecc2; }
+
+		/// Returns the second eccentricity squared, (a^2 - c^2) / c^2
+		inline const Double& ep2() const noexcept { return ecc2_prime; }
+
+		/// Returns the axis ratio c / a (1 - f for a spheroid)
+		inline const Double& axis_ratio() const noexcept { return ratio; }
+
 		/// Converts spherical coordinates (polar angle p, azimuth a) into 3D Cartesian space
 		inline E3 to_E3(const S2& s2) const noexcept
 		{
@@ -59,7 +103,9 @@ namespace S2LL
 			};
 		}
 
-		/// Converts latitude-longitude coordinates (lat, lon) into 3D Cartesian space
+		/// Converts latitude-longitude coordinates (lat, lon) into 3D Cartesian
+		/// space, reading lat as the parametric (reduced) latitude; see
+		/// to_E3(const LLH&) for geodetic latitude
 		inline E3 to_E3(const LL& ll) const noexcept
 		{
 			auto [sin_lat, cos_lat] = SinCos(ll.lat);
@@ -70,8 +116,121 @@ namespace S2LL
 				static_cast<double>(Mul(c, sin_lat))
 			};
 		}
+
+		/// Converts geodetic coordinates (lat, lon, h) into Earth-centered,
+		/// Earth-fixed Cartesian space. Defined for spheroids only; triaxial
+		/// surfaces raise FE_INVALID and yield NaN.
+		template <typename P = Precision::Accurate>
+		E3 to_E3(const LLH& g) const noexcept;
+
+		/// Converts Earth-centered, Earth-fixed Cartesian coordinates into
+		/// geodetic coordinates (lat, lon, h). Fast evaluates Vermeille's
+		/// closed form in double; Accurate refines it with two fixed-point
+		/// steps in Double. Defined for spheroids and points outside the
+		/// evolute of the meridian ellipse (farther than e^2 a from the
+		/// center); triaxial surfaces raise FE_INVALID and yield NaN.
+		template <typename P = Precision::Accurate>
+		LLH to_LLH(const E3& p) const noexcept;
+
+		/// Converts a span of geodetic coordinates; `out` must be as long as `in`
+		template <typename P = Precision::Accurate>
+		void to_E3(std::span<const LLH> in, std::span<E3> out) const noexcept;
+
+		/// Converts a span of Cartesian points; `out` must be as long as `in`
+		template <typename P = Precision::Accurate>
+		void to_LLH(std::span<const E3> in, std::span<LLH> out) const noexcept;
 	};
 
+	template <typename P>
+	inline E3 Ellipsoid::to_E3(const LLH& g) const noexcept
+	{
+		if constexpr (std::is_same_v<P, Precision::Fast>)
+		{
+			if (!is_spheroid())
+			{
+				std::feraiseexcept(FE_INVALID);
+				const double nan = std::numeric_limits<double>::quiet_NaN();
+				return E3{ nan, nan, nan };
+			}
+			const double e2 = static_cast<double>(ecc2);
+			const double sin_lat = std::sin(g.lat), cos_lat = std::cos(g.lat);
+			const double n = a / std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+			const double r = (n + g.h) * cos_lat;
+			return E3{
+				r * std::cos(g.lon),
+				r * std::sin(g.lon),
+				(n * (1.0 - e2) + g.h) * sin_lat
+			};
+		}
+		else
+		{
+			static_assert(std::is_same_v<P, Precision::Accurate>, "unknown precision policy");
+			return geodetic_E3(g);
+		}
+	}
+
+	template <typename P>
+	inline LLH Ellipsoid::to_LLH(const E3& p) const noexcept
+	{
+		if constexpr (std::is_same_v<P, Precision::Fast>)
+		{
+			// Vermeille, H. (2002). Direct transformation from geocentric
+			// coordinates to geodetic coordinates. Journal of Geodesy, 76(8),
+			// 451-454. https://doi.org/10.1007/s00190-002-0273-6
+			if (!is_spheroid())
+			{
+				std::feraiseexcept(FE_INVALID);
+				const double nan = std::numeric_limits<double>::quiet_NaN();
+				return LLH{ nan, nan, nan };
+			}
+			const double e2 = static_cast<double>(ecc2);
+			const double e4 = e2 * e2;
+			const double rho2 = p.x * p.x + p.y * p.y;
+			const double rho = std::sqrt(rho2);
+			const double pp = rho2 / (a * a);
+			const double q = (1.0 - e2) / (a * a) * p.z * p.z;
+			const double r = (pp + q - e4) / 6.0;
+			const double s = e4 * pp * q / (4.0 * r * r * r);
+			const double t = std::cbrt(1.0 + s + std::sqrt(s * (2.0 + s)));
+			const double u = r * (1.0 + t + 1.0 / t);
+			const double v = std::sqrt(u * u + e4 * q);
+			const double w = e2 * (u + v - q) / (2.0 * v);
+			const double k = std::sqrt(u + v + w * w) - w;
+			const double d = k * rho / (k + e2);
+			const double dz = std::sqrt(d * d + p.z * p.z);
+			return LLH{
+				2.0 * std::atan2(p.z, d + dz),
+				std::atan2(p.y, p.x),
+				(k + e2 - 1.0) / k * dz
+			};
+		}
+		else
+		{
+			static_assert(std::is_same_v<P, Precision::Accurate>, "unknown precision policy");
+			return geodetic_LLH(p);
+		}
+	}
+
+	template <typename P>
+	inline void Ellipsoid::to_E3(std::span<const LLH> in, std::span<E3> out) const noexcept
+	{
+		assert(in.size() == out.size());
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = to_E3<P>(in[i]);
+		}
+	}
+
+	template <typename P>
+	inline void Ellipsoid::to_LLH(std::span<const E3> in, std::span<LLH> out) const noexcept
+	{
+		assert(in.size() == out.size());
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = to_LLH<P>(in[i]);
+		}
+	}
+
 	/// Unit sphere (r = 1.0)
 	inline const Ellipsoid UnitSphere{1.0};
 
@@ -174,6 +333,12 @@ namespace S2LL
 		{
 		}
 
+		/// True for the identity transformation (no shear)
+		inline bool is_identity() const noexcept
+		{
+			return kx.iszero() && kz.iszero();
+		}
+
 		/// Applies the transformation to a point
 		inline E3 operator()(const E3& p) const noexcept
 		{
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/PointIndex.hpp>
+#include <S2LL/Core/Topology.hpp>
+#include <unordered_map>
+
+namespace S2LL
+{
+	namespace
+	{
+		constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+		/// Neighbours of a vertex appearance, smaller index first
+		struct Pair
+		{
+			uint32_t lo = none, hi = none;
+
+			bool operator==(const Pair&) const = default;
+		};
+
+		inline uint64_t mix(uint64_t h, uint64_t x) noexcept
+		{
+			// splitmix64 finalizer over the running hash
+			h ^= x + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+			h ^= h >> 30;
+			h *= 0xBF58476D1CE4E5B9ull;
+			h ^= h >> 27;
+			h *= 0x94D049BB133111EBull;
+			return h ^ (h >> 31);
+		}
+
+		/// Arcs cut from one ring, in ring order, each in canonical
+		/// direction: the lexicographically smaller of its two vertex orders
+		struct Cuts
+		{
+			std::vector<uint32_t> vertices;
+			std::vector<size_t> offsets{ 0 };
+			std::vector<uint64_t> hashes;
+			std::vector<bool> reversed;
+
+			void push(std::span<const uint32_t> arc)
+			{
+				const bool backwards = std::lexicographical_compare(arc.rbegin(), arc.rend(), arc.begin(), arc.end());
+				uint64_t h = arc.size();
+				if (backwards)
+				{
+					for (auto it = arc.rbegin(); it != arc.rend(); ++it)
+					{
+						vertices.push_back(*it);
+						h = mix(h, *it);
+					}
+				}
+				else
+				{
+					for (const uint32_t v : arc)
+					{
+						vertices.push_back(v);
+						h = mix(h, v);
+					}
+				}
+				offsets.push_back(vertices.size());
+				hashes.push_back(h);
+				reversed.push_back(backwards);
+			}
+		};
+
+		/// Representative of every input vertex: the first vertex of the
+		/// input equal to it, or within the snap angle of it
+		std::vector<uint32_t> representatives(const std::vector<E3>& v, double snap, unsigned threads)
+		{
+			const size_t n = v.size();
+			std::vector<uint32_t> rep(n, none);
+			if (snap > 0.0)
+			{
+				const PointIndex index(v, threads);
+				const NeighborLists near = index.within(v, snap, threads);
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (rep[i] != none)
+					{
+						continue;
+					}
+					rep[i] = static_cast<uint32_t>(i);
+					for (size_t k = near.offsets[i]; k < near.offsets[i + 1]; ++k)
+					{
+						uint32_t& r = rep[near.neighbors[k].index];
+						r = r == none ? static_cast<uint32_t>(i) : r;
+					}
+				}
+				return rep;
+			}
+
+			std::vector<uint32_t> order(n);
+			std::iota(order.begin(), order.end(), 0u);
+			std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+				if (v[a].x != v[b].x)
+				{
+					return v[a].x < v[b].x;
+				}
+				if (v[a].y != v[b].y)
+				{
+					return v[a].y < v[b].y;
+				}
+				return v[a].z != v[b].z ? v[a].z < v[b].z : a < b;
+			});
+			for (size_t k = 0; k < n; ++k)
+			{
+				const uint32_t i = order[k], first = k == 0 ? none : rep[order[k - 1]];
+				const bool same = k > 0 && v[i].x == v[first].x && v[i].y == v[first].y && v[i].z == v[first].z;
+				rep[i] = same ? first : i;
+			}
+			return rep;
+		}
+	}
+
+	std::vector<E3> Topology::ring_vertices(size_t r) const
+	{
+		std::vector<E3> out;
+		for (const ArcUse& use : ring(r))
+		{
+			const std::span<const uint32_t> a = arc(use.arc);
+			// The last vertex of an arc is the first of the next one
+			for (size_t k = 0; k + 1 < a.size(); ++k)
+			{
+				out.push_back(vertices[a[use.reversed ? a.size() - 1 - k : k]]);
+			}
+		}
+		return out;
+	}
+
+	Compound<GP<>> Topology::compound(size_t c) const
+	{
+		Compound<GP<>> out;
+		out.polygons.resize(part_offsets[c + 1] - part_offsets[c]);
+		for (size_t i = 0; i < out.polygons.size(); ++i)
+		{
+			out.polygons[i].boundary.vertices = ring_vertices(part_offsets[c] + i);
+		}
+		return out;
+	}
+
+	std::vector<Compound<GP<>>> Topology::to() const
+	{
+		std::vector<Compound<GP<>>> nested;
+		nested.reserve(size());
+		for (size_t c = 0; c < size(); ++c)
+		{
+			nested.push_back(compound(c));
+		}
+		return nested;
+	}
+
+	size_t Topology::memory_usage() const noexcept
+	{
+		return vertices.capacity() * sizeof(E3) + arc_vertices.capacity() * sizeof(uint32_t)
+			+ arc_uses.capacity() * sizeof(ArcUse)
+			+ (arc_offsets.capacity() + ring_offsets.capacity() + part_offsets.capacity()) * sizeof(size_t);
+	}
+
+	Topology topology(const FlatCompoundSet<E3>& regions, double snap, unsigned threads)
+	{
+		assert(regions.vertices.size() < none);
+		Topology t;
+
+		// Vertex ids, numbered in order of first appearance
+		const std::vector<uint32_t> rep = representatives(regions.vertices, snap, threads);
+		std::vector<uint32_t> id(regions.vertices.size());
+		for (size_t i = 0; i < id.size(); ++i)
+		{
+			if (rep[i] == i)
+			{
+				id[i] = static_cast<uint32_t>(t.vertices.size());
+				t.vertices.push_back(regions.vertices[i]);
+			}
+			else
+			{
+				id[i] = id[rep[i]];
+			}
+		}
+
+		// Rings as vertex ids, with repeats (from the input or from
+		// snapping) dropped
+		const size_t rings = regions.ring_count();
+		std::vector<std::vector<uint32_t>> cycles(rings);
+		parallel_for(rings, [&](size_t begin, size_t end) {
+			for (size_t r = begin; r < end; ++r)
+			{
+				std::vector<uint32_t>& cycle = cycles[r];
+				for (size_t i = regions.ring_offsets[r]; i < regions.ring_offsets[r + 1]; ++i)
+				{
+					if (cycle.empty() || cycle.back() != id[i])
+					{
+						cycle.push_back(id[i]);
+					}
+				}
+				while (cycle.size() > 1 && cycle.front() == cycle.back())
+				{
+					cycle.pop_back();
+				}
+				if (cycle.size() < 3)
+				{
+					cycle.clear();
+				}
+			}
+		}, threads, 64);
+
+		// Nodes: vertices met with two different pairs of neighbours
+		std::vector<Pair> seen(t.vertices.size());
+		std::vector<bool> node(t.vertices.size(), false);
+		for (const std::vector<uint32_t>& cycle : cycles)
+		{
+			const size_t n = cycle.size();
+			for (size_t i = 0; i < n; ++i)
+			{
+				const uint32_t a = cycle[(i + n - 1) % n], b = cycle[(i + 1) % n];
+				const Pair pair{ std::min(a, b), std::max(a, b) };
+				Pair& first = seen[cycle[i]];
+				if (first.lo == none)
+				{
+					first = pair;
+				}
+				else if (first != pair)
+				{
+					node[cycle[i]] = true;
+				}
+			}
+		}
+
+		// Arcs between consecutive nodes of every ring; a ring with no node
+		// is one closed arc from its smallest vertex id
+		std::vector<Cuts> cuts(rings);
+		parallel_for(rings, [&](size_t begin, size_t end) {
+			std::vector<uint32_t> arc;
+			for (size_t r = begin; r < end; ++r)
+			{
+				const std::vector<uint32_t>& cycle = cycles[r];
+				const size_t n = cycle.size();
+				std::vector<size_t> stops;
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (node[cycle[i]])
+					{
+						stops.push_back(i);
+					}
+				}
+				if (stops.empty() && n > 0)
+				{
+					stops.push_back(static_cast<size_t>(std::min_element(cycle.begin(), cycle.end()) - cycle.begin()));
+				}
+				for (size_t s = 0; s < stops.size(); ++s)
+				{
+					const size_t from = stops[s], to = stops[(s + 1) % stops.size()];
+					const size_t length = (to + n - from - 1) % n + 1;
+					arc.clear();
+					for (size_t k = 0; k <= length; ++k)
+					{
+						arc.push_back(cycle[(from + k) % n]);
+					}
+					cuts[r].push(arc);
+				}
+			}
+		}, threads, 64);
+
+		// Equal arcs merge, numbered in order of first appearance
+		std::unordered_multimap<uint64_t, uint32_t> arcs;
+		t.ring_offsets.reserve(rings + 1);
+		t.part_offsets.reserve(regions.size() + 1);
+		for (size_t c = 0; c < regions.size(); ++c)
+		{
+			for (size_t r = regions.part_offsets[c]; r < regions.part_offsets[c + 1]; ++r)
+			{
+				const Cuts& ring = cuts[r];
+				if (ring.hashes.empty())
+				{
+					continue;
+				}
+				for (size_t k = 0; k < ring.hashes.size(); ++k)
+				{
+					const std::span<const uint32_t> arc = std::span<const uint32_t>(ring.vertices).subspan(ring.offsets[k], ring.offsets[k + 1] - ring.offsets[k]);
+					uint32_t index = none;
+					const auto [lo, hi] = arcs.equal_range(ring.hashes[k]);
+					for (auto it = lo; it != hi && index == none; ++it)
+					{
+						const std::span<const uint32_t> known = t.arc(it->second);
+						index = std::equal(arc.begin(), arc.end(), known.begin(), known.end()) ? it->second : none;
+					}
+					if (index == none)
+					{
+						index = static_cast<uint32_t>(t.arc_count());
+						t.arc_vertices.insert(t.arc_vertices.end(), arc.begin(), arc.end());
+						t.arc_offsets.push_back(t.arc_vertices.size());
+						arcs.emplace(ring.hashes[k], index);
+					}
+					t.arc_uses.push_back(ArcUse{ index, ring.reversed[k] });
+				}
+				t.ring_offsets.push_back(t.arc_uses.size());
+			}
+			t.part_offsets.push_back(t.ring_count());
+		}
+		return t;
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+// References:
+// Peucker, T. K., & Chrisman, N. (1975). Cartographic data structures. The American Cartographer, 2(1), 55-69. https://doi.org/10.1559/152304075784447289
+// TopoJSON format specification: arcs and arc indexes. https://github.com/topojson/topojson-specification
+
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Arc of a ring in a Topology: its index, and whether the ring runs it
+	/// from its last vertex to its first
+	struct ArcUse
+	{
+		uint32_t arc;
+		bool reversed;
+
+		auto operator<=>(const ArcUse&) const = default;
+	};
+
+	/// Arc-node topology of a set of Compound regions: every boundary chain
+	/// is stored once, as an arc, and rings are lists of arc uses, so the
+	/// boundary between two neighbours is one arc used forwards by one of
+	/// them and backwards by the other. Arcs end at nodes, the vertices
+	/// where rings meet, part or branch; a ring sharing no vertex where
+	/// boundaries branch is one closed arc.
+	///
+	/// Storage is flat (CSR), as in FlatCompoundSet: arc a runs through the
+	/// vertices indexed by arc_vertices[arc_offsets[a]] to
+	/// arc_vertices[arc_offsets[a + 1] - 1], endpoints included; ring r is
+	/// arc_uses[ring_offsets[r]] to arc_uses[ring_offsets[r + 1] - 1], and
+	/// part c holds the rings [part_offsets[c], part_offsets[c + 1]).
+	struct Topology
+	{
+		/// Distinct vertices, in order of first appearance in the input
+		std::vector<E3> vertices;
+
+		/// Vertex indices of the arcs, arc after arc
+		std::vector<uint32_t> arc_vertices;
+
+		/// Index in arc_vertices at which each arc starts, plus their count
+		std::vector<size_t> arc_offsets{ 0 };
+
+		/// Arc uses of the rings, ring after ring
+		std::vector<ArcUse> arc_uses;
+
+		/// Index in arc_uses at which each ring starts, plus their count
+		std::vector<size_t> ring_offsets{ 0 };
+
+		/// Ring index at which each part starts, plus the total ring count
+		std::vector<size_t> part_offsets{ 0 };
+
+		/// Number of parts (input regions)
+		inline size_t size() const noexcept { return part_offsets.size() - 1; }
+
+		inline size_t arc_count() const noexcept { return arc_offsets.size() - 1; }
+
+		inline size_t ring_count() const noexcept { return ring_offsets.size() - 1; }
+
+		/// Vertex indices of arc a, first to last
+		inline std::span<const uint32_t> arc(size_t a) const noexcept
+		{
+			return std::span<const uint32_t>(arc_vertices).subspan(arc_offsets[a], arc_offsets[a + 1] - arc_offsets[a]);
+		}
+
+		/// Arc uses of ring r, in ring order
+		inline std::span<const ArcUse> ring(size_t r) const noexcept
+		{
+			return std::span<const ArcUse>(arc_uses).subspan(ring_offsets[r], ring_offsets[r + 1] - ring_offsets[r]);
+		}
+
+		/// Vertices of ring r, walked along its arcs from the start of the
+		/// first one
+		std::vector<E3> ring_vertices(size_t r) const;
+
+		/// Rebuilds the c-th part as a Compound region
+		Compound<GP<>> compound(size_t c) const;
+
+		/// Rebuilds every part
+		std::vector<Compound<GP<>>> to() const;
+
+		/// Heap bytes held by the topology
+		size_t memory_usage() const noexcept;
+	};
+
+	/// Builds the topology of a set of regions. Vertices are merged when
+	/// their coordinates are equal (snap = 0) or, with a positive snap
+	/// angle in radians, when they lie within it of a vertex met earlier
+	/// in the input, which they are moved to; merging is greedy in input
+	/// order, so chains of near vertices do not collapse further than the
+	/// snap. Repeated vertices are then dropped from the rings, and rings
+	/// left with fewer than three vertices are dropped.
+	///
+	/// A vertex is a node unless all its appearances have the same two
+	/// neighbours, so rings are cut at the same vertices along every shared
+	/// chain, and equal chains (in either direction) become one arc, found
+	/// by hashing. Snapping queries, ring cleanup and cutting are split
+	/// among up to `threads` threads (0: one per hardware thread); the
+	/// result does not depend on the thread count.
+	Topology topology(const FlatCompoundSet<E3>& regions, double snap = 0.0, unsigned threads = 1);
+
+	/// Topology of nested Compound regions
+	template <size_t N>
+	inline Topology topology(const std::vector<Compound<GP<N>>>& regions, double snap = 0.0, unsigned threads = 1)
+	{
+		return topology(FlatCompoundSet<E3>::from(regions), snap, threads);
+	}
+}
@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <set>
+#include <S2LL/Core/Densify.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Triangulate.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+		/// Monotone decomposition and triangulation of rings of unit vectors
+		/// in a hemisphere. The sweep runs from top to bottom along the
+		/// gnomonic y axis; "left" is the gnomonic -x side, so that orient()
+		/// is the planar counterclockwise test.
+		class Sweep
+		{
+			const std::vector<E3>& u;
+			const std::vector<uint32_t>& next;
+			const std::vector<uint32_t>& prev;
+			// orient(a, b, n) < 0 exactly when a is below b
+			E3 n;
+
+			/// Strict order of the edges in the sweep status, left to right;
+			/// edge e runs down from vertex e to next[e]. Probes are vertices,
+			/// ordered against the edges they lie right or left of.
+			struct Probe
+			{
+				uint32_t v;
+			};
+			struct EdgeLess
+			{
+				using is_transparent = void;
+				const Sweep* s;
+
+				bool operator()(uint32_t e, uint32_t f) const
+				{
+					const E3& a = s->u[e];
+					const E3& b = s->u[s->next[e]];
+					const E3& c = s->u[f];
+					const E3& d = s->u[s->next[f]];
+					if (s->above(e, f))
+					{
+						const int side = orient(a, b, c);
+						return (side != 0 ? side : orient(a, b, d)) > 0;
+					}
+					const int side = orient(c, d, a);
+					return (side != 0 ? side : orient(c, d, b)) < 0;
+				}
+
+				bool operator()(uint32_t e, Probe p) const
+				{
+					return orient(s->u[e], s->u[s->next[e]], s->u[p.v]) > 0;
+				}
+
+				bool operator()(Probe p, uint32_t e) const
+				{
+					return orient(s->u[e], s->u[s->next[e]], s->u[p.v]) < 0;
+				}
+			};
+			using Status = std::set<uint32_t, EdgeLess>;
+
+			std::vector<std::pair<uint32_t, uint32_t>> diagonals;
+
+		public:
+			Sweep(const std::vector<E3>& unit_vertices, const std::vector<uint32_t>& next_vertex,
+				const std::vector<uint32_t>& prev_vertex, const E3& center)
+				: u(unit_vertices), next(next_vertex), prev(prev_vertex), n(plain_cross(unit(ref_dir(center)), center))
+			{
+			}
+
+			/// True if vertex i comes before vertex j in the sweep
+			bool above(uint32_t i, uint32_t j) const noexcept
+			{
+				const int s = orient(u[j], u[i], n);
+				return s != 0 ? s < 0 : i < j;
+			}
+
+			/// Diagonals splitting the rings into monotone pieces
+			void decompose()
+			{
+				const uint32_t count = static_cast<uint32_t>(u.size());
+				std::vector<uint32_t> order(count);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					order[i] = i;
+				}
+				std::sort(order.begin(), order.end(), [&](uint32_t i, uint32_t j) {
+					return above(i, j);
+				});
+
+				Status status(EdgeLess{ this });
+				std::vector<Status::iterator> where(count, status.end());
+				std::vector<uint32_t> helper(count, none);
+				std::vector<bool> merge(count, false);
+				const auto fix_up = [&](uint32_t v, uint32_t e) {
+					if (e != none && helper[e] != none && merge[helper[e]])
+					{
+						diagonals.emplace_back(v, helper[e]);
+					}
+				};
+				const auto insert = [&](uint32_t v) {
+					where[v] = status.insert(v).first;
+					helper[v] = v;
+				};
+				const auto remove = [&](uint32_t e) {
+					if (where[e] != status.end())
+					{
+						status.erase(where[e]);
+						where[e] = status.end();
+					}
+				};
+				// Edge directly left of v; none only for misoriented rings
+				const auto left_of = [&](uint32_t v) {
+					const Status::iterator it = status.lower_bound(Probe{ v });
+					return it == status.begin() ? none : *std::prev(it);
+				};
+				const auto set_helper = [&](uint32_t e, uint32_t v) {
+					if (e != none)
+					{
+						helper[e] = v;
+					}
+				};
+				for (const uint32_t v : order)
+				{
+					const uint32_t a = prev[v], b = next[v];
+					const bool a_below = above(v, a), b_below = above(v, b);
+					if (a_below && b_below)
+					{
+						if (orient(u[a], u[v], u[b]) > 0)
+						{
+							// Start vertex
+							insert(v);
+						}
+						else
+						{
+							// Split vertex: joined to the helper left of it
+							const uint32_t e = left_of(v);
+							if (e != none)
+							{
+								diagonals.emplace_back(v, helper[e]);
+							}
+							set_helper(e, v);
+							insert(v);
+						}
+					}
+					else if (!a_below && !b_below)
+					{
+						fix_up(v, a);
+						remove(a);
+						if (orient(u[a], u[v], u[b]) < 0)
+						{
+							// Merge vertex: left for the next vertex below
+							merge[v] = true;
+							const uint32_t e = left_of(v);
+							fix_up(v, e);
+							set_helper(e, v);
+						}
+					}
+					else if (!a_below)
+					{
+						// Regular vertex with the region to its right
+						fix_up(v, a);
+						remove(a);
+						insert(v);
+					}
+					else
+					{
+						const uint32_t e = left_of(v);
+						fix_up(v, e);
+						set_helper(e, v);
+					}
+				}
+			}
+
+			/// Triangles of the monotone pieces, appended to out
+			void triangulate(std::vector<uint32_t>& out) const
+			{
+				// Half-edges: ring edge v leaves v; diagonal k gives the pair
+				// count + 2k, count + 2k + 1
+				const uint32_t count = static_cast<uint32_t>(u.size());
+				const uint32_t total = count + 2 * static_cast<uint32_t>(diagonals.size());
+				std::vector<uint32_t> from(total), to(total);
+				std::vector<uint32_t> offsets(count + 1, 0);
+				for (uint32_t v = 0; v < count; ++v)
+				{
+					from[v] = v;
+					to[v] = next[v];
+				}
+				for (uint32_t k = 0; k < diagonals.size(); ++k)
+				{
+					const auto [a, b] = diagonals[k];
+					from[count + 2 * k] = to[count + 2 * k + 1] = a;
+					to[count + 2 * k] = from[count + 2 * k + 1] = b;
+				}
+				for (uint32_t h = 0; h < total; ++h)
+				{
+					++offsets[from[h] + 1];
+				}
+				for (uint32_t v = 0; v < count; ++v)
+				{
+					offsets[v + 1] += offsets[v];
+				}
+				std::vector<uint32_t> leaving(total), fill(offsets.begin(), offsets.end() - 1);
+				for (uint32_t h = 0; h < total; ++h)
+				{
+					leaving[fill[from[h]]++] = h;
+				}
+
+				// The half-edge after h around its piece leaves the end of h:
+				// the first clockwise from the way back
+				const auto follow = [&](uint32_t h) {
+					const uint32_t v = to[h], back = from[h];
+					if (offsets[v + 1] - offsets[v] == 1)
+					{
+						return leaving[offsets[v]];
+					}
+					uint32_t best = none;
+					int best_side = 0;
+					for (uint32_t k = offsets[v]; k < offsets[v + 1]; ++k)
+					{
+						const uint32_t g = leaving[k];
+						if (to[g] == back)
+						{
+							continue;
+						}
+						const int side = orient(u[v], u[back], u[to[g]]) < 0 ? 0 : 1;
+						if (best == none || side < best_side
+							|| (side == best_side && orient(u[v], u[to[g]], u[to[best]]) < 0))
+						{
+							best = g;
+							best_side = side;
+						}
+					}
+					return best;
+				};
+
+				std::vector<bool> done(total, false);
+				std::vector<uint32_t> piece;
+				for (uint32_t h0 = 0; h0 < total; ++h0)
+				{
+					if (done[h0])
+					{
+						continue;
+					}
+					piece.clear();
+					uint32_t h = h0;
+					do
+					{
+						done[h] = true;
+						piece.push_back(from[h]);
+						h = follow(h);
+					} while (h != h0 && piece.size() <= total);
+					monotone(piece, out);
+				}
+			}
+
+		private:
+			void emit(uint32_t a, uint32_t b, uint32_t c, std::vector<uint32_t>& out) const
+			{
+				if (orient(u[a], u[b], u[c]) < 0)
+				{
+					std::swap(b, c);
+				}
+				out.insert(out.end(), { a, b, c });
+			}
+
+			/// Stack triangulation of a monotone piece, counterclockwise
+			void monotone(const std::vector<uint32_t>& piece, std::vector<uint32_t>& out) const
+			{
+				const size_t k = piece.size();
+				if (k < 3)
+				{
+					return;
+				}
+				size_t top = 0, bottom = 0;
+				for (size_t i = 1; i < k; ++i)
+				{
+					top = above(piece[i], piece[top]) ? i : top;
+					bottom = above(piece[bottom], piece[i]) ? i : bottom;
+				}
+
+				// Both chains from the top, merged downwards; the left chain
+				// follows the piece counterclockwise
+				struct Entry
+				{
+					uint32_t v;
+					bool left;
+				};
+				std::vector<Entry> seq;
+				seq.reserve(k);
+				seq.push_back({ piece[top], true });
+				size_t l = (top + 1) % k, r = (top + k - 1) % k;
+				while (l != bottom || r != bottom)
+				{
+					if (r == bottom || (l != bottom && above(piece[l], piece[r])))
+					{
+						seq.push_back({ piece[l], true });
+						l = (l + 1) % k;
+					}
+					else
+					{
+						seq.push_back({ piece[r], false });
+						r = (r + k - 1) % k;
+					}
+				}
+				seq.push_back({ piece[bottom], true });
+
+				std::vector<Entry> stack{ seq[0], seq[1] };
+				for (size_t j = 2; j + 1 < k; ++j)
+				{
+					const Entry w = seq[j];
+					if (w.left != stack.back().left)
+					{
+						while (stack.size() > 1)
+						{
+							const uint32_t a = stack.back().v;
+							stack.pop_back();
+							emit(w.v, a, stack.back().v, out);
+						}
+						stack.assign({ seq[j - 1], w });
+					}
+					else
+					{
+						Entry last = stack.back();
+						stack.pop_back();
+						while (!stack.empty())
+						{
+							const int side = orient(u[stack.back().v], u[w.v], u[last.v]);
+							if (w.left ? side >= 0 : side <= 0)
+							{
+								break;
+							}
+							emit(w.v, last.v, stack.back().v, out);
+							last = stack.back();
+							stack.pop_back();
+						}
+						stack.push_back(last);
+						stack.push_back(w);
+					}
+				}
+				while (stack.size() > 1)
+				{
+					const uint32_t a = stack.back().v;
+					stack.pop_back();
+					emit(seq[k - 1].v, a, stack.back().v, out);
+				}
+			}
+		};
+	}
+
+	TriangleMesh triangulate(std::span<const LoopView<E3>> rings, double tolerance,
+		const Ellipsoid& e, const LinearTransformation& T)
+	{
+		TriangleMesh mesh;
+
+		// Ring vertices without consecutive duplicates, densified, each ring
+		// linked by next
+		std::vector<E3> u, ring_u;
+		std::vector<uint32_t> next, prev;
+		DensifyOptions options;
+		options.max_chord_error = tolerance;
+		for (const LoopView<E3> ring : rings)
+		{
+			ring_u.clear();
+			for (const E3& p : ring)
+			{
+				const E3 q = unit(p);
+				if (ring_u.empty() || !same(q, ring_u.back()))
+				{
+					ring_u.push_back(q);
+				}
+			}
+			while (ring_u.size() > 1 && same(ring_u.back(), ring_u.front()))
+			{
+				ring_u.pop_back();
+			}
+			if (ring_u.size() < 3)
+			{
+				continue;
+			}
+			const size_t first = u.size();
+			if (tolerance > 0.0)
+			{
+				u.resize(first + densified_size(LoopView<E3>(ring_u), options, e, T));
+				densify(LoopView<E3>(ring_u), std::span<E3>(u).subspan(first), options, e, T);
+			}
+			else
+			{
+				u.insert(u.end(), ring_u.begin(), ring_u.end());
+			}
+			for (size_t i = first; i < u.size(); ++i)
+			{
+				next.push_back(static_cast<uint32_t>(i + 1 < u.size() ? i + 1 : first));
+			}
+		}
+		if (u.size() < 3)
+		{
+			return mesh;
+		}
+		prev.resize(u.size());
+		for (uint32_t v = 0; v < u.size(); ++v)
+		{
+			prev[next[v]] = v;
+		}
+
+		const std::optional<E3> h = hemisphere(u);
+		if (!h)
+		{
+			return mesh;
+		}
+		Sweep sweep(u, next, prev, *h);
+		sweep.decompose();
+		sweep.triangulate(mesh.indices);
+
+		if (e.major() == 1.0 && T.is_identity())
+		{
+			mesh.vertices = std::move(u);
+		}
+		else
+		{
+			mesh.vertices.reserve(u.size());
+			for (const E3& p : u)
+			{
+				mesh.vertices.push_back(T(E3{ p.x * e.major(), p.y * e.major(), p.z * e.major() }));
+			}
+		}
+		return mesh;
+	}
+}
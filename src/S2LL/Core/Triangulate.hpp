@@ -0,0 +1,77 @@
+#pragma once
+
+// References:
+// Garey, M. R., Johnson, D. S., Preparata, F. P., & Tarjan, R. E. (1978). Triangulating a simple polygon. Information Processing Letters, 7(4), 175-179. https://doi.org/10.1016/0020-0190(78)90062-5
+// de Berg, M., Cheong, O., van Kreveld, M., & Overmars, M. (2008). Computational Geometry: Algorithms and Applications (3rd ed.), chapter 3. Springer. https://doi.org/10.1007/978-3-540-77974-2
+
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Indexed triangle mesh: every three indices name the vertices of one
+	/// triangle, counterclockwise seen from outside the surface
+	struct TriangleMesh
+	{
+		std::vector<E3> vertices;
+		std::vector<uint32_t> indices;
+
+		/// Number of triangles
+		size_t size() const noexcept { return indices.size() / 3; }
+	};
+
+	/// Triangulates the region bounded by rings of great-circle arcs through
+	/// the given directions: outer rings counterclockwise, holes clockwise,
+	/// no two rings crossing (see validate()). The region must lie in an open
+	/// hemisphere; the mesh is empty otherwise, or for fewer than three
+	/// vertices. Consecutive duplicate vertices are dropped.
+	///
+	/// With a positive tolerance, the rings are first densified (see
+	/// densify()) until every boundary chord stays within that distance of
+	/// its arc; the inner edges of the mesh are chords. The vertex buffer
+	/// holds the kept ring vertices and the added points in ring order, ring
+	/// after ring, all on the sphere of radius e.major() sheared by T (the
+	/// unit sphere by default).
+	///
+	/// In the gnomonic projection about the hemisphere center, arcs become
+	/// segments, so the planar sweep applies: diagonals split the region into
+	/// pieces monotone along a fixed direction, which are triangulated in
+	/// linear time. Every decision is an exact orient() sign, taken on the
+	/// directions themselves; the whole runs in O(n log n).
+	TriangleMesh triangulate(std::span<const LoopView<E3>> rings, double tolerance = 0.0,
+		const Ellipsoid& e = UnitSphere, const LinearTransformation& T = LinearTransformation{});
+
+	/// Triangulates one geodesic polygon, read as a spherical polygon
+	template <size_t N>
+	inline TriangleMesh triangulate(const GP<N>& poly, double tolerance = 0.0)
+	{
+		const LoopView<E3> ring(poly.boundary);
+		return triangulate(std::span<const LoopView<E3>>(&ring, 1), tolerance);
+	}
+
+	/// Triangulates one great elliptic polygon on the (sheared) surface
+	template <size_t N>
+	inline TriangleMesh triangulate(const GEP<N>& poly, double tolerance,
+		const Ellipsoid& e, const LinearTransformation& T = LinearTransformation{})
+	{
+		const LoopView<E3> ring(poly.boundary);
+		return triangulate(std::span<const LoopView<E3>>(&ring, 1), tolerance, e, T);
+	}
+
+	/// Triangulates the rings of a Compound region, holes included
+	template <typename P, typename... Args>
+	TriangleMesh triangulate(const Compound<P>& region, double tolerance = 0.0, const Args&... args)
+	{
+		std::vector<LoopView<E3>> rings;
+		rings.reserve(region.polygons.size());
+		for (const P& poly : region.polygons)
+		{
+			rings.emplace_back(poly.boundary);
+		}
+		return triangulate(std::span<const LoopView<E3>>(rings), tolerance, args...);
+	}
+}
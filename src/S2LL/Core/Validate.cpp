@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <S2LL/Core/Area.hpp>
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Validate.hpp>
+#include <S2LL/Core/Vectors.hpp>
+
+namespace S2LL
+{
+	namespace
+	{
+		using namespace Internal;
+
+		/// Rings up to this many edges are checked pairwise with the batch
+		/// crossing kernel instead of through an EdgeBVH
+		constexpr size_t brute_force_edges = 64;
+
+		inline bool opposite(const E3& a, const E3& b) noexcept
+		{
+			return a.x == -b.x && a.y == -b.y && a.z == -b.z;
+		}
+
+		/// True if det(a, b, c) vanishes within its rounding error: the
+		/// directions lie on one great circle as far as doubles can tell
+		inline bool coplanar(const E3& a, const E3& b, const E3& c) noexcept
+		{
+			const double det = a.x * (b.y * c.z - b.z * c.y) + a.y * (b.z * c.x - b.x * c.z) + a.z * (b.x * c.y - b.y * c.x);
+			const double scale = std::sqrt(plain_dot(a, a) * plain_dot(b, b) * plain_dot(c, c));
+			return std::abs(det) <= 8.0 * std::numeric_limits<double>::epsilon() * scale;
+		}
+
+		inline bool before(const E3& a, const E3& b) noexcept
+		{
+			return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+		}
+
+		/// Cap around the unit directions that encloses their minor arcs,
+		/// or the full cap when they spread beyond a hemisphere
+		Cap bounding_cap(const std::vector<E3>& u) noexcept
+		{
+			E3 sum{ 0.0, 0.0, 0.0 };
+			for (const E3& p : u)
+			{
+				sum = E3{ sum.x + p.x, sum.y + p.y, sum.z + p.z };
+			}
+			const E3 axis = unit(sum);
+			if (plain_dot(axis, axis) == 0.0)
+			{
+				return Cap::full();
+			}
+			double cos_radius = 1.0;
+			for (const E3& p : u)
+			{
+				cos_radius = std::min(cos_radius, plain_dot(axis, p));
+			}
+			// Caps up to a hemisphere are convex, so they hold the arcs too
+			const Cap cap = padded_cap(axis, cos_radius);
+			return cap.cos_radius > 0.0 ? cap : Cap::full();
+		}
+
+		/// One ring under validation, with what the checks between rings need
+		struct Ring
+		{
+			LoopView<E3> vertices;
+			std::vector<E3> u;
+			Cap cap = Cap::full();
+			double area = 0.0;
+			bool degenerate = false;
+			std::optional<EdgeBVH> bvh;
+
+			Ring(LoopView<E3> ring, bool closed)
+			{
+				if (closed && ring.size() > 1 && same(unit(ring.front()), unit(ring.back())))
+				{
+					ring = ring.first(ring.size() - 1);
+				}
+				vertices = ring;
+				u.resize(ring.size());
+				std::transform(ring.begin(), ring.end(), u.begin(), unit);
+			}
+
+			size_t size() const noexcept { return u.size(); }
+
+			const E3& operator[](size_t i) const noexcept { return vertices[i % vertices.size()]; }
+
+			/// Edges properly crossing the minor arc ab, in ascending order
+			void crossing_edges(const E3& a, const E3& b, std::vector<signed char>& signs, std::vector<size_t>& out)
+			{
+				out.clear();
+				if (size() <= brute_force_edges)
+				{
+					signs.resize(size());
+					crossing_signs(a, b, vertices, signs);
+					for (size_t j = 0; j < size(); ++j)
+					{
+						if (signs[j] > 0)
+						{
+							out.push_back(j);
+						}
+					}
+					return;
+				}
+				if (!bvh)
+				{
+					bvh.emplace(vertices);
+				}
+				out = bvh->crossing_edges(a, b);
+			}
+
+			/// True if p lies on the side of the ring of area at most a
+			/// hemisphere, whatever the ring orientation
+			bool encloses(const E3& p)
+			{
+				if (!cap.contains(p))
+				{
+					return false;
+				}
+				if (!bvh)
+				{
+					bvh.emplace(vertices);
+				}
+				return bvh->contains(p) != (area < 0.0);
+			}
+		};
+
+		/// Checks of one ring on its own
+		void check_ring(Ring& ring, size_t r, const ValidateOptions& options, std::vector<Diagnostic>& out)
+		{
+			const std::vector<E3>& u = ring.u;
+			const size_t n = u.size();
+			for (size_t i = 0; i < n && n > 1; ++i)
+			{
+				const E3& a = u[i];
+				const E3& b = u[(i + 1) % n];
+				if (same(a, b))
+				{
+					out.push_back({ .defect = Defect::DuplicateVertex, .ring = r, .index = i });
+				}
+				else if (opposite(a, b))
+				{
+					out.push_back({ .defect = Defect::AntipodalEdge, .ring = r, .index = i });
+				}
+			}
+
+			// Vertices sorted by direction: equal directions end up adjacent
+			std::vector<size_t> order(n);
+			std::iota(order.begin(), order.end(), size_t{ 0 });
+			std::sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+				return same(u[i], u[j]) ? i < j : before(u[i], u[j]);
+			});
+			size_t distinct = n > 0 ? 1 : 0;
+			for (size_t k = 1; k < n; ++k)
+			{
+				const size_t i = order[k - 1], j = order[k];
+				if (!same(u[i], u[j]))
+				{
+					++distinct;
+				}
+				else if (j != i + 1 && !(i == 0 && j == n - 1))
+				{
+					out.push_back({ .defect = Defect::RepeatedVertex, .ring = r, .index = i, .other_index = j });
+				}
+			}
+
+			// Degenerate when all vertices lie on the great circle through
+			// the first one and some other direction
+			ring.degenerate = distinct < 3;
+			if (!ring.degenerate)
+			{
+				size_t j = 1;
+				while (j < n && (same(u[j], u[0]) || opposite(u[j], u[0])))
+				{
+					++j;
+				}
+				ring.degenerate = true;
+				for (size_t k = j + 1; k < n && ring.degenerate; ++k)
+				{
+					ring.degenerate = coplanar(u[0], u[j], u[k]);
+				}
+			}
+			if (ring.degenerate)
+			{
+				out.push_back({ .defect = Defect::DegenerateRing, .ring = r });
+				return;
+			}
+
+			ring.cap = bounding_cap(u);
+			if (options.winding != Winding::Either)
+			{
+				ring.area = spherical_area(ring.vertices);
+			}
+			if (!options.crossings)
+			{
+				return;
+			}
+			std::vector<signed char> signs;
+			std::vector<size_t> edges;
+			for (size_t i = 0; i < n; ++i)
+			{
+				ring.crossing_edges(ring[i], ring[i + 1], signs, edges);
+				for (const size_t j : edges)
+				{
+					if (j > i)
+					{
+						out.push_back({ .defect = Defect::SelfIntersection, .ring = r, .index = i, .other_index = j });
+					}
+				}
+			}
+		}
+
+		/// Crossings between two valid rings of a region
+		void check_pair(std::vector<Ring>& rings, size_t r, size_t s, std::vector<Diagnostic>& out)
+		{
+			Ring& x = rings[r];
+			Ring& y = rings[s];
+			if (!x.cap.is_full() && !y.cap.is_full()
+				&& angle(x.cap.axis, y.cap.axis) > x.cap.radius() + y.cap.radius())
+			{
+				return;
+			}
+			// Edges of the shorter ring are looked up in the longer one
+			const bool swap = x.size() > y.size();
+			Ring& query = swap ? y : x;
+			Ring& target = swap ? x : y;
+			std::vector<signed char> signs;
+			std::vector<size_t> edges;
+			const size_t first = out.size();
+			for (size_t i = 0; i < query.size(); ++i)
+			{
+				target.crossing_edges(query[i], query[i + 1], signs, edges);
+				for (const size_t j : edges)
+				{
+					out.push_back({ .defect = Defect::RingCrossing, .ring = r, .index = swap ? j : i,
+						.other_ring = s, .other_index = swap ? i : j });
+				}
+			}
+			std::sort(out.begin() + first, out.end(), [](const Diagnostic& a, const Diagnostic& b) {
+				return a.index != b.index ? a.index < b.index : a.other_index < b.other_index;
+			});
+		}
+	}
+
+	std::vector<Diagnostic> validate(LoopView<E3> ring, const ValidateOptions& options)
+	{
+		return validate(std::span<const LoopView<E3>>(&ring, 1), options);
+	}
+
+	std::vector<Diagnostic> validate(std::span<const LoopView<E3>> views, const ValidateOptions& options)
+	{
+		std::vector<Diagnostic> out;
+		std::vector<Ring> rings;
+		rings.reserve(views.size());
+		for (size_t r = 0; r < views.size(); ++r)
+		{
+			rings.emplace_back(views[r], options.closed);
+			check_ring(rings[r], r, options, out);
+		}
+
+		if (options.crossings)
+		{
+			for (size_t r = 0; r < rings.size(); ++r)
+			{
+				for (size_t s = r + 1; s < rings.size(); ++s)
+				{
+					if (!rings[r].degenerate && !rings[s].degenerate)
+					{
+						check_pair(rings, r, s, out);
+					}
+				}
+			}
+		}
+
+		if (options.winding != Winding::Either)
+		{
+			const double outer = options.winding == Winding::CounterClockwise ? 1.0 : -1.0;
+			for (size_t r = 0; r < rings.size(); ++r)
+			{
+				const Ring& ring = rings[r];
+				if (ring.degenerate || ring.cap.is_full() || ring.area == 0.0)
+				{
+					continue;
+				}
+				// A point of the ring away from its vertices: the midpoint of
+				// its first edge of distinct, not antipodal endpoints
+				size_t i = 0;
+				while (same(ring.u[i], ring.u[(i + 1) % ring.size()]) || opposite(ring.u[i], ring.u[(i + 1) % ring.size()]))
+				{
+					++i;
+				}
+				const E3& a = ring.u[i];
+				const E3& b = ring.u[(i + 1) % ring.size()];
+				const E3 mid{ a.x + b.x, a.y + b.y, a.z + b.z };
+				bool hole = false;
+				for (size_t s = 0; s < rings.size(); ++s)
+				{
+					if (s != r && !rings[s].degenerate && rings[s].encloses(mid))
+					{
+						hole = !hole;
+					}
+				}
+				if (ring.area * (hole ? -outer : outer) < 0.0)
+				{
+					out.push_back({ .defect = Defect::Orientation, .ring = r });
+				}
+			}
+		}
+
+		std::stable_sort(out.begin(), out.end(), [](const Diagnostic& a, const Diagnostic& b) {
+			return a.ring < b.ring;
+		});
+		return out;
+	}
+}
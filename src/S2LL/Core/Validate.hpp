@@ -0,0 +1,147 @@
+#pragma once
+
+// References:
+// Bentley, J. L., & Ottmann, T. A. (1979). Algorithms for reporting and counting geometric intersections. IEEE Transactions on Computers, C-28(9), 643-647. https://doi.org/10.1109/TC.1979.1675432
+// Open Geospatial Consortium (2011). OpenGIS implementation standard for geographic information - Simple feature access - Part 1: Common architecture (1.2.1), 6.1.11. https://www.ogc.org/standard/sfa/
+
+#include <S2LL/Core/Parallel.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace S2LL
+{
+	/// Kind of defect found by validate()
+	enum class Defect
+	{
+		/// Vertex index and index + 1 have the same direction
+		DuplicateVertex,
+
+		/// Vertex index and index + 1 are antipodal: the edge between them
+		/// is no minor arc
+		AntipodalEdge,
+
+		/// Fewer than three distinct vertices, or all of them on one great
+		/// circle up to rounding: the ring bounds no area
+		DegenerateRing,
+
+		/// Edges index and other_index of the ring cross properly
+		SelfIntersection,
+
+		/// Vertices index and other_index, not consecutive, have the same
+		/// direction: the ring touches itself
+		RepeatedVertex,
+
+		/// Edge index of the ring crosses edge other_index of other_ring
+		RingCrossing,
+
+		/// The ring runs the wrong way for its nesting depth
+		Orientation
+	};
+
+	/// One defect, located in its region, ring and vertex or edge (edge i
+	/// runs from vertex i to vertex i + 1). Fields that do not apply are npos.
+	struct Diagnostic
+	{
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+		Defect defect = Defect::DuplicateVertex;
+		size_t region = npos;
+		size_t ring = npos;
+		size_t index = npos;
+		size_t other_ring = npos;
+		size_t other_index = npos;
+	};
+
+	/// Expected turning of the outer rings of a region; holes (rings inside
+	/// an odd number of the other rings) turn the other way
+	enum class Winding
+	{
+		/// Seen from outside the sphere, as area() and overlay() expect
+		CounterClockwise,
+
+		/// As in Shapefiles
+		Clockwise,
+
+		/// Orientation is not checked
+		Either
+	};
+
+	/// Validation parameters
+	struct ValidateOptions
+	{
+		Winding winding = Winding::CounterClockwise;
+
+		/// Accepts a last vertex repeating the first, as Shapefile rings
+		/// have; the ring is checked without it
+		bool closed = false;
+
+		/// Looks for proper edge crossings within and between rings, the
+		/// costly part of the validation
+		bool crossings = true;
+	};
+
+	/// Checks one ring of great-circle edges for duplicate and antipodal
+	/// consecutive vertices, degeneracy, repeated vertices and proper
+	/// self-intersections. Crossings are decided by the exact predicates;
+	/// long rings find candidate edges through an EdgeBVH, so the cost
+	/// follows n log n plus the number of crossings. Diagnostics carry
+	/// ring 0 and no region.
+	std::vector<Diagnostic> validate(LoopView<E3> ring, const ValidateOptions& options = {});
+
+	/// Checks the rings of one region: every ring as above, then crossings
+	/// between rings and ring orientation against the nesting depth of each
+	/// ring. Rings that do not fit in a hemisphere have an ambiguous inside
+	/// and are not checked for orientation. Diagnostics come ordered by ring
+	/// and carry no region.
+	std::vector<Diagnostic> validate(std::span<const LoopView<E3>> rings, const ValidateOptions& options = {});
+
+	/// Checks one geodesic polygon, read as a spherical polygon
+	template <size_t N>
+	inline std::vector<Diagnostic> validate(const GP<N>& poly, const ValidateOptions& options = {})
+	{
+		return validate(LoopView<E3>(poly.boundary), options);
+	}
+
+	/// Checks the rings of a Compound region
+	template <size_t N>
+	std::vector<Diagnostic> validate(const Compound<GP<N>>& region, const ValidateOptions& options = {})
+	{
+		std::vector<LoopView<E3>> rings;
+		rings.reserve(region.polygons.size());
+		for (const GP<N>& poly : region.polygons)
+		{
+			rings.emplace_back(poly.boundary);
+		}
+		return validate(std::span<const LoopView<E3>>(rings), options);
+	}
+
+	/// Checks every region, split among up to `threads` threads (0: one per
+	/// hardware thread). Diagnostics come ordered by region, each tagged with
+	/// its index in `regions`, whatever the number of threads.
+	inline std::vector<Diagnostic> validate(std::span<const Compound<GP<>>> regions,
+		const ValidateOptions& options = {}, unsigned threads = 1)
+	{
+		std::vector<std::vector<Diagnostic>> found(regions.size());
+		parallel_for(regions.size(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				found[i] = validate(regions[i], options);
+				for (Diagnostic& d : found[i])
+				{
+					d.region = i;
+				}
+			}
+		}, threads, 16);
+
+		std::vector<Diagnostic> all;
+		for (const std::vector<Diagnostic>& f : found)
+		{
+			all.insert(all.end(), f.begin(), f.end());
+		}
+		return all;
+	}
+}
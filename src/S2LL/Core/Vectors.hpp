@@ -0,0 +1,138 @@
+#pragma once
+
+#include <S2LL/Core/Coordinates.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace S2LL
+{
+	// Plain double vector helpers shared by the translation units of the
+	// library. They are not part of its interface: sources pull them in with
+	// `using namespace Internal;` inside their anonymous namespace.
+	namespace Internal
+	{
+		inline double plain_dot(const E3& a, const E3& b) noexcept
+		{
+			return a.x * b.x + a.y * b.y + a.z * b.z;
+		}
+
+		inline E3 plain_cross(const E3& a, const E3& b) noexcept
+		{
+			return E3{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+		}
+
+		/// v scaled to unit length; the zero vector is returned as is
+		inline E3 unit(const E3& v) noexcept
+		{
+			const double m = std::sqrt(plain_dot(v, v));
+			return m > 0.0 ? E3{ v.x / m, v.y / m, v.z / m } : v;
+		}
+
+		/// Angle between two directions, accurate at both ends of [0, pi]
+		inline double angle(const E3& x, const E3& y) noexcept
+		{
+			const E3 c = plain_cross(x, y);
+			return std::atan2(std::sqrt(plain_dot(c, c)), plain_dot(x, y));
+		}
+
+		/// Angular distance from q to the minor arc ab, all unit: to the great
+		/// circle when the foot falls within the arc, else to an endpoint
+		inline double arc_distance(const E3& q, const E3& a, const E3& b) noexcept
+		{
+			const E3 n = plain_cross(a, b);
+			const double nn = std::sqrt(plain_dot(n, n));
+			if (nn > 0.0)
+			{
+				const double h = plain_dot(q, n) / nn;
+				const E3 foot{ q.x - h * n.x / nn, q.y - h * n.y / nn, q.z - h * n.z / nn };
+				const double f = std::sqrt(plain_dot(foot, foot));
+				if (f > 0.0 && plain_dot(plain_cross(a, foot), n) >= 0.0 && plain_dot(plain_cross(foot, b), n) >= 0.0)
+				{
+					return std::atan2(std::abs(h), f);
+				}
+			}
+			return std::min(angle(q, a), angle(q, b));
+		}
+
+		/// Slack of bounding caps, in cosine: a few ulps of 1, above the
+		/// rounding of the dot products that measured the cap and of
+		/// Cap::contains. Padding the angle instead vanishes through the
+		/// cosine once it rounds to 1, for radii under about 1e-8.
+		constexpr double cap_slack = 1e-15;
+
+		/// Cap around the unit axis holding every direction whose computed
+		/// cosine to the axis is at least cos_radius
+		inline Cap padded_cap(const E3& axis, double cos_radius) noexcept
+		{
+			return Cap{ axis, cos_radius - cap_slack };
+		}
+
+		/// True if the coordinates are equal
+		inline bool same(const E3& a, const E3& b) noexcept
+		{
+			return a.x == b.x && a.y == b.y && a.z == b.z;
+		}
+
+		/// 10-bit Morton interleave of a coordinate in [-1, 1]
+		inline uint64_t spread10(double x) noexcept
+		{
+			uint64_t v = static_cast<uint64_t>(std::clamp((x + 1.0) * 512.0, 0.0, 1023.0));
+			v = (v | (v << 16)) & 0x030000FFull;
+			v = (v | (v << 8)) & 0x0300F00Full;
+			v = (v | (v << 4)) & 0x030C30C3ull;
+			v = (v | (v << 2)) & 0x09249249ull;
+			return v;
+		}
+
+		/// 21-bit Morton interleave of a coordinate in [-1, 1]
+		inline uint64_t spread21(double x) noexcept
+		{
+			uint64_t v = static_cast<uint64_t>(std::clamp((x + 1.0) * 1048576.0, 0.0, 2097151.0));
+			v = (v | (v << 32)) & 0x1F00000000FFFFull;
+			v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+			v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+			v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+			v = (v | (v << 2)) & 0x1249249249249249ull;
+			return v;
+		}
+
+		/// Center of an open hemisphere holding every direction, by
+		/// perceptron updates from their sum
+		inline std::optional<E3> hemisphere(const std::vector<E3>& u) noexcept
+		{
+			// Passes over the points allowed, and the least cosine between the
+			// center and a point, far above the rounding of the dot products
+			constexpr int max_passes = 32;
+			constexpr double margin = 1e-12;
+
+			E3 h{ 0.0, 0.0, 0.0 };
+			for (const E3& p : u)
+			{
+				h = E3{ h.x + p.x, h.y + p.y, h.z + p.z };
+			}
+			for (int pass = 0; pass < max_passes; ++pass)
+			{
+				bool moved = false;
+				for (const E3& p : u)
+				{
+					const double m = std::sqrt(plain_dot(h, h));
+					if (!(plain_dot(h, p) > margin * m))
+					{
+						h = E3{ h.x + p.x, h.y + p.y, h.z + p.z };
+						moved = true;
+					}
+				}
+				if (!moved)
+				{
+					return unit(h);
+				}
+			}
+			return std::nullopt;
+		}
+	}
+}
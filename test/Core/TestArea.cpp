@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Area.hpp>
+
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("Spherical polygon area", "[core][area]") {
+	using Catch::Matchers::WithinAbs;
+	using Catch::Matchers::WithinRel;
+	constexpr double pi = std::numbers::pi;
+	const S2LL::GP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+	const S2LL::GP<3> reversed{ { 0, 0, 1 }, { 0, 1, 0 }, { 1, 0, 0 } };
+
+	SECTION("Sign follows the orientation") {
+		REQUIRE_THAT(S2LL::area(octant), WithinAbs(pi / 2, 1e-15));
+		REQUIRE_THAT(S2LL::area(reversed), WithinAbs(-pi / 2, 1e-15));
+		REQUIRE_THAT(S2LL::area(octant, S2LL::Ellipsoid(2.0)), WithinAbs(2 * pi, 1e-14));
+	}
+
+	SECTION("Squares of all sizes match the closed form") {
+		// Gnomonic square of half-side h: 4 asin(h^2 / (1 + h^2))
+		for (const double h : { 1e-6, 1e-3, 0.1, 0.5, 2.0 })
+		{
+			const S2LL::GP<4> square{ { 1, -h, -h }, { 1, h, -h }, { 1, h, h }, { 1, -h, h } };
+			const double expected = 4.0 * std::asin(h * h / (1.0 + h * h));
+			REQUIRE_THAT(S2LL::area(square), WithinRel(expected, 1e-12));
+		}
+	}
+
+	SECTION("Rings enclosing more than a hemisphere") {
+		// A ring just south of the equator, run eastward: its left side is
+		// the larger northern part, so the signed area is minus the south cap
+		std::vector<S2LL::E3> ring;
+		for (int i = 0; i < 360; ++i)
+		{
+			ring.push_back(dir(-10, i));
+		}
+		const double cap = S2LL::spherical_area(ring);
+		REQUIRE(cap < 0.0);
+		REQUIRE_THAT(cap, WithinRel(-2 * pi * (1 - std::sin(10 * pi / 180)), 1e-3));
+	}
+
+	SECTION("Compound regions sum outer rings and holes") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons = {
+			{ dir(0, 0), dir(0, 30), dir(30, 30), dir(30, 0) },
+			{ dir(10, 10), dir(20, 10), dir(20, 20), dir(10, 20) },
+		};
+		const double outer = S2LL::area(region.polygons[0]);
+		const double hole = S2LL::area(region.polygons[1]);
+		REQUIRE(hole < 0.0);
+		REQUIRE_THAT(S2LL::area(region), WithinAbs(outer + hole, 1e-15));
+	}
+}
+
+TEST_CASE("Ellipsoidal polygon area", "[core][area]") {
+	using Catch::Matchers::WithinAbs;
+	using Catch::Matchers::WithinRel;
+	const S2LL::Ellipsoid& wgs84 = S2LL::wgs84;
+
+	SECTION("Octant of WGS 84 is an eighth of the surface") {
+		const S2LL::GP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		REQUIRE_THAT(8.0 * S2LL::area(octant, wgs84), WithinRel(510065621724088.5, 1e-13));
+	}
+
+	SECTION("Densified geodesic edges converge") {
+		const S2LL::GP<3> tri{ dir(10, 10), dir(40, 60), dir(-20, 80) };
+		std::vector<S2LL::E3> dense;
+		S2LL::sample_boundary(tri, 400, std::back_inserter(dense), wgs84);
+		REQUIRE_THAT(S2LL::area(tri, wgs84), WithinRel(S2LL::geodesic_area(dense, wgs84), 1e-9));
+	}
+
+	SECTION("Batch areas are reproducible") {
+		std::vector<S2LL::Compound<S2LL::GP<>>> regions;
+		for (int i = 0; i < 200; ++i)
+		{
+			const double lat = -60 + 0.6 * i, lon = -170 + 1.7 * i;
+			regions.push_back({ { { dir(lat, lon), dir(lat, lon + 1.5), dir(lat + 0.4, lon + 0.7) } } });
+		}
+		std::vector<double> serial(regions.size()), threaded(regions.size()), flat(regions.size());
+		S2LL::area(regions, serial, wgs84);
+		S2LL::area(regions, threaded, wgs84, 3);
+		S2LL::area(S2LL::FlatCompoundSet<S2LL::E3>::from(regions), flat, wgs84, 2);
+		for (size_t i = 0; i < regions.size(); ++i)
+		{
+			REQUIRE(serial[i] > 0.0);
+			REQUIRE(threaded[i] == serial[i]);
+			REQUIRE(flat[i] == serial[i]);
+			REQUIRE(serial[i] == S2LL::area(regions[i], wgs84));
+		}
+	}
+}
+
+TEST_CASE("Great elliptic polygon area under shear", "[core][area]") {
+	using Catch::Matchers::WithinAbs;
+	using Catch::Matchers::WithinRel;
+	const S2LL::Ellipsoid sphere(3.0);
+	const S2LL::LinearTransformation T(-0.7, 2.6, 1.3);
+
+	SECTION("Without shear the sphere formula applies") {
+		const S2LL::GEP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		REQUIRE_THAT(S2LL::area(octant, sphere), WithinAbs(9 * std::numbers::pi / 2, 1e-14));
+	}
+
+	SECTION("Octants match a fine flat mesh of their image") {
+		// Split the octant at edge midpoints, push the vertices through the
+		// shear and sum the flat triangles: the mesh converges quadratically
+		std::vector<std::array<S2LL::E3, 3>> mesh{ { S2LL::E3{ 1, 0, 0 }, S2LL::E3{ 0, 1, 0 }, S2LL::E3{ 0, 0, 1 } } };
+		for (int level = 0; level < 7; ++level)
+		{
+			std::vector<std::array<S2LL::E3, 3>> next;
+			for (const auto& [a, b, c] : mesh)
+			{
+				const S2LL::E3 ab = (a + b).normalized(), bc = (b + c).normalized(), ca = (c + a).normalized();
+				next.push_back({ a, ab, ca });
+				next.push_back({ ab, b, bc });
+				next.push_back({ ca, bc, c });
+				next.push_back({ ab, bc, ca });
+			}
+			mesh = std::move(next);
+		}
+		double flat = 0.0;
+		for (const auto& [a, b, c] : mesh)
+		{
+			const S2LL::E3 ta = T(a * 3.0), tb = T(b * 3.0), tc = T(c * 3.0);
+			flat += 0.5 * (tb - ta).cross(tc - ta).mag();
+		}
+		const S2LL::GEP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		REQUIRE_THAT(S2LL::area(octant, sphere, T), WithinRel(flat, 1e-4));
+	}
+
+	SECTION("Octants partition the sheared surface") {
+		double sum = 0.0;
+		for (int sx : { 1, -1 })
+		{
+			for (int sy : { 1, -1 })
+			{
+				for (int sz : { 1, -1 })
+				{
+					const S2LL::E3 x{ double(sx), 0, 0 }, y{ 0, double(sy), 0 }, z{ 0, 0, double(sz) };
+					const S2LL::GEP<3> tri = sx * sy * sz > 0 ? S2LL::GEP<3>{ x, y, z } : S2LL::GEP<3>{ y, x, z };
+					const S2LL::GEP<3> rev = sx * sy * sz > 0 ? S2LL::GEP<3>{ z, y, x } : S2LL::GEP<3>{ z, x, y };
+					const double part = S2LL::area(tri, sphere, T);
+					REQUIRE(part > 0.0);
+					REQUIRE_THAT(S2LL::area(rev, sphere, T), WithinRel(-part, 1e-11));
+					sum += part;
+				}
+			}
+		}
+		// Larger than the sphere: the shear stretches it
+		REQUIRE(sum > 4 * std::numbers::pi * 9);
+	}
+}
@@ -0,0 +1,241 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/BoundaryIndex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Star-shaped ring around (lat, lon) with radii alternating between r0
+	/// and r1 degrees, counterclockwise (clockwise when reversed)
+	std::vector<S2LL::E3> star(double lat, double lon, double r0, double r1, size_t n, bool reversed = false)
+	{
+		std::vector<S2LL::E3> ring;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double t = 2.0 * std::numbers::pi * static_cast<double>(reversed ? n - i : i) / static_cast<double>(n);
+			const double r = i % 2 == 0 ? r0 : r1;
+			ring.push_back(dir(lat + r * std::sin(t), lon + r * std::cos(t) / std::cos(lat * std::numbers::pi / 180.0)));
+		}
+		return ring;
+	}
+
+	double angle(const S2LL::E3& a, const S2LL::E3& b)
+	{
+		return std::atan2(a.cross(b).mag(), a.dot(b));
+	}
+
+	/// Angle from the unit direction q to the minor arc ab
+	double arc_distance(const S2LL::E3& q, const S2LL::E3& a, const S2LL::E3& b)
+	{
+		const S2LL::E3 u = a.normalized(), v = b.normalized();
+		const S2LL::E3 n = u.cross(v);
+		const S2LL::E3 foot = q - n * (q.dot(n) / n.dot(n));
+		if (foot.mag() > 0.0 && u.cross(foot).dot(n) >= 0.0 && foot.cross(v).dot(n) >= 0.0)
+		{
+			return angle(q, foot);
+		}
+		return std::min(angle(q, u), angle(q, v));
+	}
+
+	/// Disjoint starry regions scattered over the sphere, every third with
+	/// a hole
+	std::vector<S2LL::Compound<S2LL::GP<>>> regions()
+	{
+		std::vector<S2LL::Compound<S2LL::GP<>>> out;
+		for (int lat = -60; lat <= 60; lat += 30)
+		{
+			for (int lon = -180; lon < 180; lon += 40)
+			{
+				const size_t c = out.size();
+				const double la = lat + 3.0 * std::sin(1.7 * static_cast<double>(c)), lo = lon + 5.0 * std::cos(2.9 * static_cast<double>(c));
+				S2LL::Compound<S2LL::GP<>> region;
+				region.polygons.resize(c % 3 == 0 ? 2 : 1);
+				region.polygons[0].boundary.vertices = star(la, lo, 9.0 + static_cast<double>(c % 4), 6.0, 24 + 2 * (c % 5));
+				if (c % 3 == 0)
+				{
+					region.polygons[1].boundary.vertices = star(la, lo, 3.0, 2.0, 10, true);
+				}
+				out.push_back(region);
+			}
+		}
+		return out;
+	}
+
+	std::vector<S2LL::E3> probe_points()
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 400; ++i)
+		{
+			pts.push_back(S2LL::E3{ std::sin(1.1 * i + 0.3), std::cos(2.3 * i), std::sin(0.7 * i - 1.9) }.normalized());
+		}
+		return pts;
+	}
+}
+
+TEST_CASE("Boundary distances agree with edge scans", "[core][boundary]") {
+	using Catch::Matchers::WithinAbs;
+	using Catch::Matchers::WithinRel;
+	const auto set = regions();
+	const S2LL::BoundaryIndex index(set, 2);
+	REQUIRE(index.size() == set.size());
+	REQUIRE(index.memory_usage() > 0);
+	const auto pts = probe_points();
+
+	SECTION("Great-circle distance") {
+		const auto flat = S2LL::FlatCompoundSet<S2LL::E3>::from(set);
+		for (const S2LL::E3& q : pts)
+		{
+			const S2LL::BoundaryHit hit = index.nearest(q);
+			double closest = 10.0;
+			for (const auto& region : set)
+			{
+				for (const S2LL::GP<>& poly : region.polygons)
+				{
+					for (size_t i = 0; i < poly.size(); ++i)
+					{
+						closest = std::min(closest, arc_distance(q, poly[i], poly[i + 1]));
+					}
+				}
+			}
+			REQUIRE_THAT(hit.distance, WithinAbs(closest, 1e-12));
+			REQUIRE_THAT(angle(q, hit.point), WithinAbs(hit.distance, 1e-12));
+			// The hit names the region, ring and edge it lies on
+			REQUIRE(flat.part_offsets[hit.region] <= hit.ring);
+			REQUIRE(hit.ring < flat.part_offsets[hit.region + 1]);
+			const S2LL::LoopView<S2LL::E3> ring = flat.ring(hit.ring);
+			REQUIRE_THAT(arc_distance(q, ring[hit.edge], ring[(hit.edge + 1) % ring.size()]), WithinAbs(hit.distance, 1e-12));
+		}
+	}
+
+	SECTION("Ellipsoidal distance") {
+		const S2LL::Ellipsoid& e = S2LL::wgs84;
+		for (size_t k = 0; k < 60; ++k)
+		{
+			const S2LL::E3& q = pts[k];
+			const S2LL::BoundaryHit hit = index.nearest(q, e);
+			double closest = std::numeric_limits<double>::infinity();
+			for (const auto& region : set)
+			{
+				for (const S2LL::GP<>& poly : region.polygons)
+				{
+					for (size_t i = 0; i < poly.size(); ++i)
+					{
+						closest = std::min(closest, S2LL::GeodesicArc{ poly[i], poly[i + 1], e }.distance(q));
+					}
+				}
+			}
+			REQUIRE_THAT(hit.distance, WithinRel(closest, 1e-9));
+		}
+
+		// A sphere scales the angles
+		const S2LL::Ellipsoid sphere(2.0);
+		const S2LL::BoundaryHit hit = index.nearest(pts[0], sphere);
+		REQUIRE_THAT(hit.distance, WithinAbs(2.0 * index.nearest(pts[0]).distance, 1e-12));
+		REQUIRE_THAT(hit.point.mag(), WithinAbs(2.0, 1e-12));
+	}
+
+	SECTION("Nearest regions") {
+		const S2LL::RegionIndex inside(set);
+		for (size_t k = 0; k < 100; ++k)
+		{
+			const S2LL::E3& q = pts[k];
+			// Distance to every region, zero inside it
+			std::vector<std::pair<double, size_t>> expected;
+			for (size_t r = 0; r < set.size(); ++r)
+			{
+				double d = 10.0;
+				for (const S2LL::GP<>& poly : set[r].polygons)
+				{
+					for (size_t i = 0; i < poly.size(); ++i)
+					{
+						d = std::min(d, arc_distance(q, poly[i], poly[i + 1]));
+					}
+				}
+				expected.emplace_back(inside.contains(r, q) ? 0.0 : d, r);
+			}
+			std::sort(expected.begin(), expected.end());
+
+			const std::vector<S2LL::BoundaryHit> near = index.nearest_regions(q, 5);
+			REQUIRE(near.size() == 5);
+			for (size_t j = 0; j < near.size(); ++j)
+			{
+				REQUIRE_THAT(near[j].distance, WithinAbs(expected[j].first, 1e-12));
+				const auto it = std::find_if(expected.begin(), expected.end(), [&](const auto& x) { return x.second == near[j].region; });
+				REQUIRE_THAT(it->first, WithinAbs(near[j].distance, 1e-12));
+				REQUIRE((near[j].distance == 0.0) == (near[j].ring == S2LL::BoundaryHit::npos));
+			}
+		}
+		REQUIRE(index.nearest_regions(pts[0], 1000).size() == set.size());
+		REQUIRE(index.nearest_regions(pts[0], 0).empty());
+
+		// On the spheroid, ordered by surface distance
+		const std::vector<S2LL::BoundaryHit> near = index.nearest_regions(pts[1], 4, S2LL::wgs84);
+		REQUIRE(near.size() == 4);
+		for (size_t j = 1; j < near.size(); ++j)
+		{
+			REQUIRE(near[j - 1].distance <= near[j].distance);
+		}
+		if (near[0].ring != S2LL::BoundaryHit::npos)
+		{
+			REQUIRE_THAT(near[0].distance, WithinRel(index.nearest(pts[1], S2LL::wgs84).distance, 1e-12));
+		}
+	}
+
+	SECTION("Batch and multi-threaded queries match single queries") {
+		std::vector<S2LL::BoundaryHit> one(pts.size()), four(pts.size());
+		index.nearest(pts, one, 1);
+		index.nearest(pts, four, 4);
+		for (size_t i = 0; i < pts.size(); ++i)
+		{
+			const S2LL::BoundaryHit hit = index.nearest(pts[i]);
+			REQUIRE(one[i].region == hit.region);
+			REQUIRE(one[i].ring == hit.ring);
+			REQUIRE(one[i].edge == hit.edge);
+			REQUIRE(one[i].distance == hit.distance);
+			REQUIRE(four[i].distance == hit.distance);
+		}
+
+		std::vector<S2LL::BoundaryHit> ellipsoidal(50);
+		index.nearest(std::span<const S2LL::E3>(pts.data(), 50), ellipsoidal, S2LL::wgs84, 4);
+		for (size_t i = 0; i < ellipsoidal.size(); ++i)
+		{
+			REQUIRE(ellipsoidal[i].distance == index.nearest(pts[i], S2LL::wgs84).distance);
+		}
+	}
+}
+
+TEST_CASE("Boundary distances along long geodesic edges", "[core][boundary]") {
+	using Catch::Matchers::WithinAbs;
+	// A 176 degree edge, whose geodesic strays some 0.045 rad from its great
+	// circle, and a small triangle on the far side of the geodesic from the
+	// great circle, nearer to the great circle than the geodesic is
+	const S2LL::Ellipsoid& e = S2LL::wgs84;
+	const S2LL::E3 a = dir(40, 0), b = dir(-38, 176);
+	const S2LL::E3 m = S2LL::GeodesicArc{ a, b, e }.interpolate(0.5).normalized();
+	const double s = arc_distance(m, a, b);
+	REQUIRE(s > 0.04);
+	S2LL::E3 n = a.cross(b).normalized();
+	n = m.dot(n) > 0.0 ? n : n * -1.0;
+	const S2LL::E3 c = (m + n * (0.5 * s)).normalized();
+	const S2LL::E3 t = c.cross(n).normalized();
+	const S2LL::GP<> triangle{ (c + t * (0.05 * s)).normalized(), (c + n * (0.05 * s)).normalized(), (c - t * (0.05 * s)).normalized() };
+	const std::vector<S2LL::Compound<S2LL::GP<>>> set{ { { S2LL::GP<>{ a, b, dir(80, 90) } } }, { { triangle } } };
+	const S2LL::BoundaryIndex index(set);
+
+	// By great-circle angle the triangle is nearer, on the surface the edge
+	REQUIRE(index.nearest(m).region == 1);
+	const S2LL::BoundaryHit hit = index.nearest(m, e);
+	REQUIRE(hit.region == 0);
+	REQUIRE(hit.edge == 0);
+	REQUIRE_THAT(hit.distance, WithinAbs(S2LL::GeodesicArc{ a, b, e }.distance(m), 1e-6));
+	const std::vector<S2LL::BoundaryHit> near = index.nearest_regions(m, 2, e);
+	REQUIRE(near.size() == 2);
+	REQUIRE(near[0].region == 0);
+	REQUIRE(near[1].region == 1);
+}
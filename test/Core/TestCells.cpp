@@ -0,0 +1,243 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Cells.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Star-shaped ring around (lat, lon), counterclockwise
+	S2LL::GP<> star(double lat, double lon, double r0, double r1, size_t n)
+	{
+		S2LL::GP<> ring;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double t = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(n);
+			const double r = i % 2 == 0 ? r0 : r1;
+			ring.boundary.vertices.push_back(dir(lat + r * std::sin(t), lon + r * std::cos(t) / std::cos(lat * deg)));
+		}
+		return ring;
+	}
+
+	std::vector<S2LL::E3> probe_points()
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 20000; ++i)
+		{
+			pts.push_back(S2LL::E3{ std::sin(1.1 * i + 0.3), std::cos(2.3 * i), std::sin(0.7 * i - 1.9) }.normalized());
+		}
+		return pts;
+	}
+
+	/// True if p lies strictly inside the cell, as its corner arcs bound it
+	bool in_cell(S2LL::CellId c, const S2LL::E3& p)
+	{
+		for (int k = 0; k < 4; ++k)
+		{
+			if (S2LL::orient(c.vertex(k), c.vertex((k + 1) % 4), p) < 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Exterior coverings hold every point of the region, and interior
+	/// coverings only points of it
+	void check_coverings(const S2LL::Compound<S2LL::GP<>>& region, const S2LL::CoveringOptions& options)
+	{
+		const S2LL::RegionIndex index(std::vector<S2LL::Compound<S2LL::GP<>>>{ region });
+		const S2LL::CellUnion outer = S2LL::covering(region, options);
+		const S2LL::CellUnion inner = S2LL::interior_covering(region, options);
+		REQUIRE(!outer.empty());
+		REQUIRE(outer.size() <= options.max_cells);
+		REQUIRE(inner.size() <= options.max_cells);
+		for (const S2LL::CellId c : outer)
+		{
+			REQUIRE(c.level() <= options.max_level);
+		}
+		size_t inside = 0, covered = 0;
+		for (const S2LL::E3& p : probe_points())
+		{
+			const bool in_region = index.contains(0, p);
+			if (in_region)
+			{
+				++inside;
+				REQUIRE(outer.contains(p));
+			}
+			if (inner.contains(p))
+			{
+				++covered;
+				REQUIRE(in_region);
+			}
+		}
+		REQUIRE(inside > 0);
+		REQUIRE(outer.leaf_count() >= inner.leaf_count());
+		REQUIRE(inner.leaf_count() > 0);
+		REQUIRE(covered <= inside);
+	}
+}
+
+TEST_CASE("Cell ids", "[core][cells]") {
+	SECTION("Faces, parents and children") {
+		for (int face = 0; face < 6; ++face)
+		{
+			const S2LL::CellId f = S2LL::CellId::from_face(face);
+			REQUIRE(f.is_valid());
+			REQUIRE(f.face() == face);
+			REQUIRE(f.level() == 0);
+			for (int k = 0; k < 4; ++k)
+			{
+				const S2LL::CellId c = f.child(k);
+				REQUIRE(c.is_valid());
+				REQUIRE(c.level() == 1);
+				REQUIRE(c.parent() == f);
+				REQUIRE(f.contains(c));
+				REQUIRE_FALSE(c.contains(f));
+				REQUIRE(c.intersects(f));
+				if (k > 0)
+				{
+					REQUIRE(f.child(k - 1) < c);
+					REQUIRE_FALSE(f.child(k - 1).intersects(c));
+				}
+			}
+			REQUIRE(f.child(0).range_min() == f.range_min());
+			REQUIRE(f.child(3).range_max() == f.range_max());
+		}
+		REQUIRE_FALSE(S2LL::CellId{}.is_valid());
+		REQUIRE_FALSE(S2LL::CellId{ 2 }.is_valid());
+	}
+
+	SECTION("Points round trip through their leaves") {
+		for (const S2LL::E3& p : probe_points())
+		{
+			const S2LL::CellId leaf = S2LL::CellId::from_point(p);
+			REQUIRE(leaf.is_valid());
+			REQUIRE(leaf.level() == S2LL::CellId::max_level);
+			REQUIRE(leaf.center().cross(p).mag() < 1e-8);
+			for (const int level : { 0, 3, 12, 29 })
+			{
+				const S2LL::CellId c = S2LL::CellId::from_point(p, level);
+				REQUIRE(c.level() == level);
+				REQUIRE(leaf.parent(level) == c);
+				REQUIRE(c.contains(leaf));
+				REQUIRE(c.cap().contains(p));
+				if (level > 0)
+				{
+					REQUIRE(in_cell(c, p));
+				}
+			}
+		}
+	}
+
+	SECTION("Face coordinates") {
+		const S2LL::CellId c = S2LL::CellId::from_face_ij(2, 5, 9, 4);
+		REQUIRE(c.face() == 2);
+		REQUIRE(c.level() == 4);
+		REQUIRE(S2LL::CellId::from_point(c.center(), 4) == c);
+		REQUIRE(c.parent(2) == S2LL::CellId::from_face_ij(2, 1, 2, 2));
+		// The corners of a cell on +z run counterclockwise seen from outside
+		REQUIRE(S2LL::orient(c.vertex(0), c.vertex(1), c.vertex(2)) > 0);
+		REQUIRE(S2LL::orient(c.vertex(1), c.vertex(2), c.vertex(3)) > 0);
+	}
+}
+
+TEST_CASE("Cell unions", "[core][cells]") {
+	const S2LL::CellId f = S2LL::CellId::from_face(1);
+	const S2LL::CellId a = f.child(2).child(1);
+
+	SECTION("Normalization") {
+		// Descendants drop, duplicates merge, four siblings become the parent
+		const S2LL::CellUnion u({ a.child(3), f.child(0).child(0), a, f.child(0).child(1), a,
+			f.child(0).child(2), f.child(0).child(3), f.child(3).child(2).child(0) });
+		REQUIRE(u.size() == 3);
+		REQUIRE(u[0] == f.child(0));
+		REQUIRE(u[1] == a);
+		REQUIRE(u[2] == f.child(3).child(2).child(0));
+
+		std::vector<S2LL::CellId> all;
+		for (int k = 0; k < 4; ++k)
+		{
+			for (int m = 0; m < 4; ++m)
+			{
+				all.push_back(f.child(k).child(m));
+			}
+		}
+		const S2LL::CellUnion whole(all);
+		REQUIRE(whole.size() == 1);
+		REQUIRE(whole[0] == f);
+		REQUIRE(whole.leaf_count(2) == 16);
+	}
+
+	SECTION("Lookups") {
+		const S2LL::CellUnion u({ f.child(0), a, S2LL::CellId::from_face(4).child(2).child(2).child(2) });
+		REQUIRE(u.contains(f.child(0)));
+		REQUIRE(u.contains(f.child(0).child(3).child(1)));
+		REQUIRE(u.contains(a.child(0)));
+		REQUIRE_FALSE(u.contains(f));
+		REQUIRE_FALSE(u.contains(f.child(2)));
+		REQUIRE_FALSE(u.contains(f.child(1).child(0)));
+		REQUIRE(u.intersects(f));
+		REQUIRE(u.intersects(f.child(2)));
+		REQUIRE_FALSE(u.intersects(f.child(1)));
+		REQUIRE_FALSE(u.intersects(S2LL::CellId::from_face(0)));
+		REQUIRE(u.contains(a.center()));
+		REQUIRE_FALSE(u.contains(f.child(1).center()));
+
+		REQUIRE(u.intersects(S2LL::CellUnion({ f.child(2).child(1).child(3) })));
+		REQUIRE_FALSE(u.intersects(S2LL::CellUnion({ f.child(2).child(0), S2LL::CellId::from_face(5) })));
+		REQUIRE(u.leaf_count(3) == 16 + 4 + 1);
+	}
+}
+
+TEST_CASE("Region coverings", "[core][cells]") {
+	SECTION("A star") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back(star(35, -20, 18, 9, 24));
+		check_coverings(region, S2LL::CoveringOptions{});
+		check_coverings(region, S2LL::CoveringOptions{ 0, 30, 40 });
+		check_coverings(region, S2LL::CoveringOptions{ 2, 6, 200 });
+	}
+
+	SECTION("A region with a hole across faces") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back(star(40, 45, 30, 24, 40));
+		S2LL::GP<> hole = star(40, 45, 8, 8, 12);
+		std::reverse(hole.boundary.vertices.begin(), hole.boundary.vertices.end());
+		region.polygons.push_back(hole);
+		check_coverings(region, S2LL::CoveringOptions{ 0, 30, 20 });
+		// The hole center is left out once cells are fine enough
+		const S2LL::CellUnion outer = S2LL::covering(region, S2LL::CoveringOptions{ 0, 30, 200 });
+		REQUIRE_FALSE(outer.contains(dir(40, 45)));
+	}
+
+	SECTION("Finer budgets cover less") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back(star(-10, 120, 12, 7, 16));
+		uint64_t previous = S2LL::covering(region, S2LL::CoveringOptions{ 0, 30, 4 }).leaf_count();
+		for (const size_t cells : { 16, 64, 256 })
+		{
+			const uint64_t leaves = S2LL::covering(region, S2LL::CoveringOptions{ 0, 30, cells }).leaf_count();
+			REQUIRE(leaves <= previous);
+			previous = leaves;
+		}
+	}
+
+	SECTION("Min level and the empty region") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back(star(0, 0, 10, 10, 8));
+		const S2LL::CellUnion cells = S2LL::covering(region, S2LL::CoveringOptions{ 3, 3, 1 });
+		for (const S2LL::CellId c : cells)
+		{
+			REQUIRE(c.level() == 3);
+		}
+		REQUIRE(S2LL::covering(S2LL::Compound<S2LL::GP<>>{}).empty());
+		REQUIRE(S2LL::interior_covering(S2LL::Compound<S2LL::GP<>>{}).empty());
+	}
+}
@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Area.hpp>
+#include <S2LL/Core/Clip.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Quadrilateral with great-circle edges through the corners of a
+	/// latitude/longitude box, counterclockwise
+	S2LL::Compound<S2LL::GP<>> box(double lat0, double lat1, double lon0, double lon1)
+	{
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back({ dir(lat0, lon0), dir(lat0, lon1), dir(lat1, lon1), dir(lat1, lon0) });
+		return region;
+	}
+
+	/// Star-shaped ring around (lat, lon), counterclockwise
+	S2LL::GP<> star(double lat, double lon, double r0, double r1, size_t n)
+	{
+		S2LL::GP<> ring;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double t = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(n);
+			const double r = i % 2 == 0 ? r0 : r1;
+			ring.boundary.vertices.push_back(dir(lat + r * std::sin(t), lon + r * std::cos(t) / std::cos(lat * deg)));
+		}
+		return ring;
+	}
+
+	double angle(const S2LL::E3& a, const S2LL::E3& b)
+	{
+		return std::atan2(a.cross(b).mag(), a.dot(b));
+	}
+
+	std::vector<S2LL::E3> probe_points()
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 4000; ++i)
+		{
+			pts.push_back(S2LL::E3{ std::sin(1.1 * i + 0.3), std::cos(2.3 * i), std::sin(0.7 * i - 1.9) }.normalized());
+		}
+		return pts;
+	}
+
+	/// Points of the clipped region are the points of the region inside the
+	/// window, away from the window boundary by more than the tolerance
+	template <typename Inside>
+	void check_points(const S2LL::Compound<S2LL::GP<>>& region, const S2LL::Compound<S2LL::GP<>>& clipped,
+		Inside&& inside_window)
+	{
+		const S2LL::RegionIndex source(std::vector<S2LL::Compound<S2LL::GP<>>>{ region });
+		const S2LL::RegionIndex result(std::vector<S2LL::Compound<S2LL::GP<>>>{ clipped });
+		size_t hits = 0;
+		for (const S2LL::E3& p : probe_points())
+		{
+			const int side = inside_window(p);
+			if (side == 0)
+			{
+				continue;
+			}
+			const bool expected = side > 0 && source.contains(0, p);
+			REQUIRE(result.contains(0, p) == expected);
+			hits += expected;
+		}
+		REQUIRE(hits > 0);
+	}
+}
+
+TEST_CASE("Clipping against a cap", "[core][clip]") {
+	using Catch::Matchers::WithinAbs;
+	using Catch::Matchers::WithinRel;
+	const double tolerance = 1e-4;
+	const S2LL::Cap cap{ dir(20, 30), std::cos(25 * deg) };
+	const S2LL::ClipWindow window(cap, tolerance);
+	REQUIRE_FALSE(window.is_complement());
+	// +1 inside, -1 outside, 0 within the tolerance of the small circle
+	const auto side = [&](const S2LL::E3& p) {
+		const double t = angle(p, cap.axis) - 25 * deg;
+		return t < -tolerance ? 1 : t > tolerance ? -1 : 0;
+	};
+
+	SECTION("A region covering the cap leaves the window polygon") {
+		const auto region = box(-30, 70, -30, 90);
+		const auto clipped = window.clip(region);
+		REQUIRE_THAT(S2LL::area(clipped), WithinRel(S2LL::area(window.rings()), 1e-9));
+		const double cap_area = 2.0 * std::numbers::pi * (1.0 - std::cos(25 * deg));
+		REQUIRE(S2LL::area(clipped) <= cap_area);
+		REQUIRE_THAT(S2LL::area(clipped), WithinAbs(cap_area, 2.0 * std::numbers::pi * std::sin(25 * deg) * tolerance));
+		check_points(region, clipped, side);
+	}
+
+	SECTION("Partial overlap") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back(star(30, 55, 20, 12, 30));
+		check_points(region, window.clip(region), side);
+	}
+
+	SECTION("Regions away from the boundary skip the overlay") {
+		const auto far = box(-60, -50, -150, -140);
+		REQUIRE(window.clip(far).polygons.empty());
+		const auto near = box(15, 25, 25, 35);
+		const auto kept = S2LL::clip(near, window);
+		REQUIRE(kept.polygons.size() == 1);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			REQUIRE(kept.polygons[0][i].x == near.polygons[0][i].x);
+			REQUIRE(kept.polygons[0][i].y == near.polygons[0][i].y);
+			REQUIRE(kept.polygons[0][i].z == near.polygons[0][i].z);
+		}
+	}
+
+	SECTION("Caps beyond a hemisphere clip by their complement") {
+		const S2LL::Cap big{ dir(20, 30), std::cos(150 * deg) };
+		const S2LL::ClipWindow outside(big, tolerance);
+		REQUIRE(outside.is_complement());
+		const auto region = box(-80, 80, 150, 260);
+		check_points(region, outside.clip(region), [&](const S2LL::E3& p) {
+			const double t = angle(p, big.axis) - 150 * deg;
+			return t < -tolerance ? 1 : t > tolerance ? -1 : 0;
+		});
+		// Far from the small cap left out, a region is untouched
+		REQUIRE(outside.clip(box(15, 25, 25, 35)).polygons.size() == 1);
+	}
+
+	SECTION("Full and empty caps") {
+		const auto region = box(0, 10, 0, 10);
+		REQUIRE(S2LL::ClipWindow(S2LL::Cap::full(), tolerance).clip(region).polygons.size() == 1);
+		REQUIRE(S2LL::ClipWindow(S2LL::Cap{ dir(5, 5), 1.0 }, tolerance).clip(region).polygons.empty());
+	}
+}
+
+TEST_CASE("Clipping against a latitude/longitude rectangle", "[core][clip]") {
+	using Catch::Matchers::WithinAbs;
+	const double tolerance = 1e-5;
+	// +1 inside, -1 outside, 0 near a side (the parallels within tolerance)
+	const auto in_rect = [&](const S2LL::LLRect& rect) {
+		return [rect, tolerance](const S2LL::E3& p) {
+			const double lat = std::asin(p.z), lon = std::atan2(p.y, p.x);
+			double width = std::remainder(rect.hi.lon - rect.lo.lon, 2.0 * std::numbers::pi);
+			width = width <= 0.0 ? width + 2.0 * std::numbers::pi : width;
+			double east = std::remainder(lon - rect.lo.lon, 2.0 * std::numbers::pi);
+			east = east < 0.0 ? east + 2.0 * std::numbers::pi : east;
+			const double margin = 2.0 * tolerance + 1e-9;
+			const double d = std::min({ lat - rect.lo.lat, rect.hi.lat - lat,
+				width >= 2.0 * std::numbers::pi ? 10.0 : std::min(east, width - east) * std::cos(lat) });
+			return d > margin ? 1 : (d < -margin || east > width + margin) ? -1 : 0;
+		};
+	};
+
+	SECTION("Rectangle inside a region") {
+		const S2LL::LLRect rect{ { 10 * deg, -20 * deg }, { 40 * deg, 30 * deg } };
+		const S2LL::ClipWindow window(rect, tolerance);
+		const auto region = box(-10, 60, -50, 60);
+		const auto clipped = window.clip(region);
+		const double rect_area = 50 * deg * (std::sin(40 * deg) - std::sin(10 * deg));
+		REQUIRE_THAT(S2LL::area(clipped), WithinAbs(rect_area, 4.0 * 50 * deg * tolerance));
+		check_points(region, clipped, in_rect(rect));
+	}
+
+	SECTION("Across the antimeridian and a pole") {
+		const S2LL::LLRect rect{ { 30 * deg, 150 * deg }, { 90 * deg, -150 * deg } };
+		const S2LL::ClipWindow window(rect, tolerance);
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.push_back(star(60, 175, 25, 15, 40));
+		check_points(region, window.clip(region), in_rect(rect));
+	}
+
+	SECTION("Bands of every longitude") {
+		const auto region = box(-70, 70, 100, 200);
+		for (const S2LL::LLRect rect : {
+			S2LL::LLRect{ { 10 * deg, 0 }, { 50 * deg, 0 } },
+			S2LL::LLRect{ { -50 * deg, 0 }, { -10 * deg, 0 } },
+			S2LL::LLRect{ { -20 * deg, 0 }, { 30 * deg, 0 } } })
+		{
+			const S2LL::ClipWindow window(rect, tolerance);
+			REQUIRE(window.is_complement() == (rect.lo.lat < 0 && rect.hi.lat > 0));
+			check_points(region, window.clip(region), in_rect(rect));
+		}
+	}
+
+	SECTION("Sub-metre regions across a corner") {
+		// Some 7 cm across, centered just outside the southwestern corner:
+		// the bounding cap of the region must reach over the corner
+		const S2LL::LLRect rect{ { 10 * deg, 20 * deg }, { 30 * deg, 40 * deg } };
+		const S2LL::ClipWindow window(rect, tolerance);
+		const double a = 1e-7, h = 3e-7;
+		const auto region = box(10 - a - h, 10 - a + h, 20 - a - h, 20 - a + h);
+		const auto clipped = window.clip(region);
+		REQUIRE(clipped.polygons.size() == 1);
+		REQUIRE(S2LL::area(clipped) > 0.0);
+		REQUIRE(S2LL::area(clipped) < S2LL::area(region));
+	}
+}
+
+TEST_CASE("Streaming clip", "[core][clip]") {
+	std::vector<S2LL::Compound<S2LL::GP<>>> regions;
+	for (int lat = -60; lat <= 60; lat += 20)
+	{
+		for (int lon = -180; lon < 180; lon += 30)
+		{
+			regions.push_back(box(lat - 8, lat + 8, lon - 10, lon + 10));
+		}
+	}
+	const S2LL::ClipWindow window(S2LL::LLRect{ { -25 * deg, -40 * deg }, { 35 * deg, 70 * deg } }, 1e-4);
+
+	std::vector<S2LL::ClippedRegion> one, three;
+	S2LL::clip(regions.begin(), regions.end(), window, std::back_inserter(one));
+	S2LL::clip(regions.begin(), regions.end(), window, std::back_inserter(three), 3);
+	REQUIRE(!one.empty());
+	REQUIRE(one.size() < regions.size());
+	REQUIRE(one.size() == three.size());
+	for (size_t i = 0; i < one.size(); ++i)
+	{
+		REQUIRE(one[i].index == three[i].index);
+		REQUIRE((i == 0 || one[i - 1].index < one[i].index));
+		const auto single = window.clip(regions[one[i].index]);
+		REQUIRE(S2LL::area(one[i].region) == S2LL::area(single));
+		REQUIRE(S2LL::area(three[i].region) == S2LL::area(single));
+	}
+}
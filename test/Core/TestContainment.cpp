@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include <S2LL/Core/Containment.hpp>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	/// Deterministic pseudo-random directions, with small integer coordinates
+	/// mixed in so that points fall exactly on edges and vertices
+	std::vector<S2LL::E3> probe_points()
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 2000; ++i)
+		{
+			pts.push_back({ std::sin(1.1 * i + 0.3), std::cos(2.3 * i), std::sin(0.7 * i - 1.9) });
+		}
+		for (int x = -2; x <= 2; ++x)
+		{
+			for (int y = -2; y <= 2; ++y)
+			{
+				for (int z = -2; z <= 2; ++z)
+				{
+					if (x != 0 || y != 0 || z != 0)
+					{
+						pts.push_back({ double(x), double(y), double(z) });
+					}
+				}
+			}
+		}
+		return pts;
+	}
+}
+
+TEST_CASE("Spherical polygon containment", "[core][containment]") {
+	const S2LL::GP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+	SECTION("Interior lies to the left of the edges") {
+		REQUIRE(S2LL::contains(octant, { 1, 1, 1 }));
+		REQUIRE_FALSE(S2LL::contains(octant, { -1, -1, -1 }));
+		REQUIRE_FALSE(S2LL::contains(octant, { 1, 1, -0.001 }));
+
+		const S2LL::GP<3> complement{ { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } };
+		REQUIRE_FALSE(S2LL::contains(complement, { 1, 1, 1 }));
+		REQUIRE(S2LL::contains(complement, { -1, -1, -1 }));
+	}
+
+	SECTION("Octants partition the sphere, boundaries included") {
+		std::vector<S2LL::PreparedPolygon> octants;
+		for (int sx : { 1, -1 })
+		{
+			for (int sy : { 1, -1 })
+			{
+				for (int sz : { 1, -1 })
+				{
+					const S2LL::E3 x{ double(sx), 0, 0 }, y{ 0, double(sy), 0 }, z{ 0, 0, double(sz) };
+					const S2LL::GP<3> tri = sx * sy * sz > 0
+						? S2LL::GP<3>{ x, y, z } : S2LL::GP<3>{ y, x, z };
+					octants.emplace_back(tri);
+				}
+			}
+		}
+		for (const auto& p : probe_points())
+		{
+			int count = 0;
+			for (const auto& o : octants)
+			{
+				count += o.contains(p);
+			}
+			REQUIRE(count == 1);
+		}
+	}
+
+	SECTION("Batch queries match single queries") {
+		const S2LL::GP<> poly{ { 1, 0.1, 0.2 }, { 0.3, 1, -0.1 }, { -0.4, 0.2, 1 }, { 0.2, 0.2, 0.4 }, { 0.5, -0.6, 0.7 } };
+		const S2LL::PreparedPolygon prepared(poly);
+		const auto pts = probe_points();
+		auto out = std::make_unique<bool[]>(pts.size());
+		prepared.contains(pts, std::span<bool>(out.get(), pts.size()));
+		size_t inside = 0;
+		for (size_t i = 0; i < pts.size(); ++i)
+		{
+			REQUIRE(out[i] == S2LL::contains(poly, pts[i]));
+			inside += out[i];
+		}
+		REQUIRE(inside > 0);
+		REQUIRE(inside < pts.size());
+	}
+
+	SECTION("Bounding cap does not change the answers") {
+		// A small square around (1, 0, 0) and its complement
+		const double h = 1e-3;
+		const S2LL::GP<4> square{ { 1, -h, -h }, { 1, h, -h }, { 1, h, h }, { 1, -h, h } };
+		const S2LL::GP<4> rest{ { 1, -h, h }, { 1, h, h }, { 1, h, -h }, { 1, -h, -h } };
+		const S2LL::PreparedPolygon a(square), b(rest);
+		auto pts = probe_points();
+		pts.push_back({ 1, 0, 0 });
+		pts.push_back({ 1, h, 0 });
+		pts.push_back({ 1, 2 * h, 0 });
+		pts.push_back({ -1, 0, 0 });
+		for (const auto& p : pts)
+		{
+			REQUIRE(a.contains(p) != b.contains(p));
+		}
+		REQUIRE(a.contains({ 1, 0, 0 }));
+		REQUIRE_FALSE(a.contains({ -1, 0, 0 }));
+	}
+
+	SECTION("Sub-metre polygons keep their vertices inside the bounding cap") {
+		// A square some 6 cm across on the Earth, whose bounding cap radius
+		// rounds away in its cosine unless the cap is padded there
+		const S2LL::E3 c = S2LL::E3{ 0.3, -0.5, 0.8 }.normalized();
+		const S2LL::E3 u = c.cross({ 0, 0, 1 }).normalized();
+		const S2LL::E3 w = c.cross(u);
+		const double h = 5e-9;
+		auto at = [&](double s, double t) { return c + u * (s * h) + w * (t * h); };
+		const S2LL::GP<4> square{ at(-1, -1), at(1, -1), at(1, 1), at(-1, 1) };
+		const S2LL::PreparedPolygon prepared(square);
+		REQUIRE_FALSE(prepared.cap().is_full());
+		for (double s : { -1.0, 1.0 })
+		{
+			for (double t : { -1.0, 1.0 })
+			{
+				REQUIRE(prepared.contains(at(0.99 * s, 0.99 * t)));
+				REQUIRE(prepared.contains(at(0.99 * s, 0.0)));
+				REQUIRE_FALSE(prepared.contains(at(1.01 * s, 1.01 * t)));
+				REQUIRE(prepared.contains(at(s, t)) == S2LL::contains(square, at(s, t)));
+			}
+		}
+		REQUIRE(prepared.contains(c));
+	}
+}
+
+TEST_CASE("Great elliptic polygon containment under shear", "[core][containment]") {
+	// Demo 1 polygon on the sphere of radius 3, sheared as in Demo 1c
+	const S2LL::GEP<4> poly{ { 0, 0, 3 }, { 3, 0, 0 }, { 2, 2, 1 }, { 0, 3, 0 } };
+	const S2LL::GP<4> base{ { 0, 0, 3 }, { 3, 0, 0 }, { 2, 2, 1 }, { 0, 3, 0 } };
+	const S2LL::LinearTransformation T(-0.7, 2.6, 1.3);
+	const S2LL::PreparedPolygon world(poly, T);
+	// Only generic points: the shear rounds, which may move boundary points
+	const auto pts = probe_points();
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		const S2LL::E3& q = pts[i];
+		REQUIRE(world.contains(T(q)) == S2LL::contains(base, q));
+	}
+	REQUIRE(S2LL::contains(poly, T({ 1, 1, 1 }), T));
+	REQUIRE_FALSE(S2LL::contains(poly, T({ -1, -1, -1 }), T));
+}
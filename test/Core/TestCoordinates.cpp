@@ -2,6 +2,9 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <S2LL/Core/Coordinates.hpp>
 
+#include <cmath>
+#include <vector>
+
 TEST_CASE("E2 coordinates", "[core][coordinates]") {
 	SECTION("Default initialization") {
 		S2LL::E2 c{};
@@ -83,3 +86,50 @@ TEST_CASE("LL coordinates", "[core][coordinates]") {
 		REQUIRE(s2.a == ll.lon);
 	}
 }
+
+TEST_CASE("E3 to S2 and LL conversion policies", "[core][coordinates]") {
+	using Catch::Matchers::WithinAbs;
+	using S2LL::Precision::Fast;
+
+	SECTION("Axis directions convert exactly under both policies") {
+		const S2LL::E3 north{ 0.0, 0.0, 2.0 };
+		REQUIRE(north.s2().p == 0.0);
+		REQUIRE(north.s2<Fast>().p == 0.0);
+
+		const S2LL::E3 east{ 0.0, 3.0, 0.0 };
+		REQUIRE(east.s2().p == 0.5 * std::numbers::pi);
+		REQUIRE(east.s2().a == 0.5 * std::numbers::pi);
+		REQUIRE(east.ll<Fast>().lat == 0.0);
+		REQUIRE(east.ll<Fast>().lon == 0.5 * std::numbers::pi);
+	}
+
+	SECTION("Polar angles near the poles keep full precision") {
+		// tan(p) = 1e-9, so p = 1e-9 - 1e-27/3 to double precision
+		const S2LL::E3 nearPole{ 1e-9, 0.0, 1.0 };
+		REQUIRE(nearPole.s2().p == 1e-9);
+		REQUIRE(nearPole.s2<Fast>().p == 1e-9);
+	}
+
+	SECTION("Fast conversion stays within 1e-15 rad of the accurate path") {
+		std::vector<S2LL::E3> points;
+		for (int i = 0; i < 1000; ++i)
+		{
+			const double t = 0.37 * i;
+			const double scale = std::pow(10.0, (i % 13) - 6);
+			points.push_back(S2LL::E3{ scale * std::cos(t), scale * std::sin(1.7 * t), scale * std::cos(0.3 * t) });
+		}
+		std::vector<S2LL::S2> fast(points.size());
+		std::vector<S2LL::S2> accurate(points.size());
+		std::vector<S2LL::LL> fastLL(points.size());
+		S2LL::to_S2<Fast>(points, fast);
+		S2LL::to_S2(points, accurate);
+		S2LL::to_LL<Fast>(points, fastLL);
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			REQUIRE_THAT(fast[i].p, WithinAbs(accurate[i].p, 1e-15));
+			REQUIRE_THAT(fast[i].a, WithinAbs(accurate[i].a, 1e-15));
+			REQUIRE_THAT(fastLL[i].lat, WithinAbs(accurate[i].ll().lat, 1e-15));
+			REQUIRE(fastLL[i].lon == fast[i].a);
+		}
+	}
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Delaunay.hpp>
+#include <S2LL/Core/Predicates.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Deterministic pseudo-random directions, uniform in area between the
+	/// given latitudes
+	std::vector<S2LL::E3> scatter(size_t n, double lat0, double lat1)
+	{
+		const double z0 = std::sin(lat0 * std::numbers::pi / 180.0), z1 = std::sin(lat1 * std::numbers::pi / 180.0);
+		std::vector<S2LL::E3> pts;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double s = 0.5 + 0.5 * std::sin(12.9898 * i + 0.7), t = 0.5 + 0.5 * std::sin(78.233 * i + 1.3);
+			pts.push_back(dir(std::asin(z0 + (z1 - z0) * s) * 180.0 / std::numbers::pi, 360.0 * t - 180.0));
+		}
+		return pts;
+	}
+
+	/// Twin half-edges run between the same sites the other way, and every
+	/// site edge starts at its site
+	void check_halfedges(const S2LL::Delaunay& d)
+	{
+		for (uint32_t h = 0; h < d.halfedges.size(); ++h)
+		{
+			const uint32_t g = d.halfedges[h];
+			if (g != S2LL::Delaunay::none)
+			{
+				REQUIRE(d.halfedges[g] == h);
+				REQUIRE(d.triangles[g] == d.triangles[S2LL::Delaunay::next(h)]);
+				REQUIRE(d.triangles[h] == d.triangles[S2LL::Delaunay::next(g)]);
+			}
+		}
+		for (uint32_t s = 0; s < d.site_edges.size(); ++s)
+		{
+			if (d.site_edges[s] != S2LL::Delaunay::none)
+			{
+				REQUIRE(d.triangles[d.site_edges[s]] == s);
+			}
+		}
+	}
+
+	/// No site inside the circumcircle of a triangle
+	void check_empty_circles(const S2LL::Delaunay& d, const std::vector<S2LL::E3>& pts)
+	{
+		for (size_t t = 0; t < d.size(); ++t)
+		{
+			const S2LL::E3& a = pts[d.triangles[3 * t]];
+			const S2LL::E3& b = pts[d.triangles[3 * t + 1]];
+			const S2LL::E3& c = pts[d.triangles[3 * t + 2]];
+			REQUIRE(S2LL::orient(a, b, c) == 1);
+			for (const S2LL::E3& p : pts)
+			{
+				REQUIRE(S2LL::orient3d(a, b, c, p) <= 0);
+			}
+		}
+	}
+}
+
+TEST_CASE("Spherical Delaunay triangulation", "[core][delaunay]") {
+	SECTION("Octahedron") {
+		const std::vector<S2LL::E3> pts{ { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+		const S2LL::Delaunay d = S2LL::delaunay(pts);
+		REQUIRE(d.size() == 8);
+		for (const uint32_t h : d.halfedges)
+		{
+			REQUIRE(h != S2LL::Delaunay::none);
+		}
+		check_halfedges(d);
+		check_empty_circles(d, pts);
+	}
+
+	SECTION("Sites over the whole sphere") {
+		const std::vector<S2LL::E3> pts = scatter(500, -90, 90);
+		const S2LL::Delaunay d = S2LL::delaunay(pts);
+		REQUIRE(d.size() == 2 * pts.size() - 4);
+		check_halfedges(d);
+		check_empty_circles(d, pts);
+	}
+
+	SECTION("Sites within a hemisphere") {
+		const std::vector<S2LL::E3> pts = scatter(400, 10, 80);
+		const S2LL::Delaunay d = S2LL::delaunay(pts);
+		check_halfedges(d);
+		check_empty_circles(d, pts);
+		size_t boundary = 0;
+		for (const uint32_t h : d.halfedges)
+		{
+			boundary += h == S2LL::Delaunay::none;
+		}
+		// Euler: a triangulated disk with b boundary sites has 2n - b - 2
+		// triangles
+		REQUIRE(boundary >= 3);
+		REQUIRE(d.size() == 2 * pts.size() - boundary - 2);
+	}
+
+	SECTION("Duplicates and scaled copies are left out") {
+		std::vector<S2LL::E3> pts = scatter(100, -90, 90);
+		pts.push_back(pts[7]);
+		pts.push_back({ 3 * pts[20].x, 3 * pts[20].y, 3 * pts[20].z });
+		const S2LL::Delaunay d = S2LL::delaunay(pts);
+		REQUIRE(d.size() == 2 * 100 - 4);
+		REQUIRE(d.site_edges.size() == 102);
+		REQUIRE((d.site_edges[7] == S2LL::Delaunay::none) != (d.site_edges[100] == S2LL::Delaunay::none));
+		REQUIRE((d.site_edges[20] == S2LL::Delaunay::none) != (d.site_edges[101] == S2LL::Delaunay::none));
+		check_halfedges(d);
+	}
+
+	SECTION("Sites on one circle have no triangulation") {
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 12; ++i)
+		{
+			pts.push_back({ std::cos(i * 0.5), std::sin(i * 0.5), 0.0 });
+		}
+		REQUIRE(S2LL::delaunay(pts).size() == 0);
+		REQUIRE(S2LL::delaunay(std::vector<S2LL::E3>(pts.begin(), pts.begin() + 3)).size() == 0);
+	}
+}
+
+TEST_CASE("Spherical Voronoi diagram", "[core][delaunay]") {
+	SECTION("Vertices are equidistant from the sites of their cells") {
+		const std::vector<S2LL::E3> pts = scatter(300, -90, 90);
+		const S2LL::Delaunay d = S2LL::delaunay(pts);
+		const S2LL::Voronoi v = S2LL::voronoi(d, pts, 4);
+		REQUIRE(v.vertices.size() == d.size());
+		REQUIRE(v.offsets.size() == pts.size() + 1);
+		REQUIRE(v.cells.size() == 3 * d.size());
+		for (uint32_t s = 0; s < pts.size(); ++s)
+		{
+			REQUIRE(v.offsets[s + 1] - v.offsets[s] >= 3);
+			for (uint32_t k = v.offsets[s]; k < v.offsets[s + 1]; ++k)
+			{
+				const S2LL::E3& c = v.vertices[v.cells[k]];
+				const double r = c.x * pts[s].x + c.y * pts[s].y + c.z * pts[s].z;
+				for (int i = 0; i < 3; ++i)
+				{
+					const S2LL::E3& q = pts[d.triangles[3 * v.cells[k] + i]];
+					REQUIRE_THAT(c.x * q.x + c.y * q.y + c.z * q.z, Catch::Matchers::WithinAbs(r, 1e-12));
+				}
+				// Consecutive vertices turn counterclockwise around the site
+				const S2LL::E3& next = v.vertices[v.cells[k + 1 < v.offsets[s + 1] ? k + 1 : v.offsets[s]]];
+				REQUIRE(S2LL::orient(pts[s], c, next) == 1);
+			}
+		}
+	}
+
+	SECTION("Cells on the boundary of a hemisphere are open") {
+		const std::vector<S2LL::E3> pts = scatter(200, 20, 70);
+		const S2LL::Delaunay d = S2LL::delaunay(pts);
+		const S2LL::Voronoi v = S2LL::voronoi(d, pts);
+		REQUIRE(v.cells.size() == 3 * d.size());
+	}
+}
+
+TEST_CASE("Nearest site by walking", "[core][delaunay]") {
+	const std::vector<S2LL::E3> pts = scatter(1000, -90, 90);
+	const S2LL::Delaunay d = S2LL::delaunay(pts);
+	const std::vector<S2LL::E3> queries = scatter(200, -89, 89);
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		const S2LL::E3& p = queries[(i * 37) % queries.size()];
+		size_t best = 0;
+		for (size_t s = 1; s < pts.size(); ++s)
+		{
+			if (pts[s].x * p.x + pts[s].y * p.y + pts[s].z * p.z > pts[best].x * p.x + pts[best].y * p.y + pts[best].z * p.z)
+			{
+				best = s;
+			}
+		}
+		REQUIRE(S2LL::nearest_site(d, pts, p, static_cast<uint32_t>(i % pts.size())) == best);
+	}
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Area.hpp>
+#include <S2LL/Core/Densify.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	double angle(const S2LL::E3& a, const S2LL::E3& b)
+	{
+		const S2LL::E3 c{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+		return std::atan2(std::sqrt(c.x * c.x + c.y * c.y + c.z * c.z), a.x * b.x + a.y * b.y + a.z * b.z);
+	}
+
+	bool same(const S2LL::E3& a, const S2LL::E3& b)
+	{
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+}
+
+TEST_CASE("Densification of rings", "[core][densify]") {
+	const S2LL::GP<4> quad{ dir(0, 0), dir(0, 10), dir(10, 10), dir(10, 0) };
+
+	SECTION("Bounded step angle") {
+		S2LL::DensifyOptions options;
+		options.max_angle = 0.25 * std::numbers::pi / 180.0;
+		const S2LL::GP<> dense = S2LL::densify(quad, options);
+		REQUIRE(dense.size() == S2LL::densified_size(S2LL::LoopView<S2LL::E3>(quad.boundary), options));
+		REQUIRE(dense.size() > 4 * 39);
+		size_t corner = 0;
+		for (size_t i = 0; i < dense.size(); ++i)
+		{
+			if (corner < 4 && same(dense[i], quad[corner]))
+			{
+				++corner;
+			}
+			REQUIRE(angle(dense[i], dense[i + 1]) <= options.max_angle * (1.0 + 1e-12));
+			REQUIRE_THAT(dense[i].mag(), Catch::Matchers::WithinAbs(1.0, 1e-13));
+		}
+		REQUIRE(corner == 4);
+		REQUIRE_THAT(S2LL::area(dense), Catch::Matchers::WithinRel(S2LL::area(quad), 1e-12));
+	}
+
+	SECTION("Bounded chord error, with as few steps as meet it") {
+		S2LL::DensifyOptions options;
+		options.max_chord_error = 1e-5;
+		const std::vector<S2LL::E3> ring{ dir(0, 0), dir(0, 60), dir(50, 30), dir(20, 5) };
+		const std::vector<S2LL::E3> dense = S2LL::densify(S2LL::LoopView<S2LL::E3>(ring), options);
+		size_t at = 0;
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			REQUIRE(same(dense[at], ring[i]));
+			const double theta = angle(ring[i], ring[(i + 1) % ring.size()]);
+			size_t k = 1;
+			while (at + k < dense.size() && !same(dense[at + k], ring[(i + 1) % ring.size()]))
+			{
+				++k;
+			}
+			REQUIRE(1.0 - std::cos(theta / (2.0 * static_cast<double>(k))) <= options.max_chord_error);
+			REQUIRE(1.0 - std::cos(theta / (2.0 * static_cast<double>(k - 1))) > options.max_chord_error);
+			at += k;
+		}
+		REQUIRE(at == dense.size());
+	}
+
+	SECTION("Points keep the length of their edge's first vertex") {
+		const S2LL::GEP<4> poly{ { 0, 0, 3 }, { 3, 0, 0 }, { 2, 2, 1 }, { 0, 3, 0 } };
+		const S2LL::Ellipsoid sphere(3);
+		const S2LL::LinearTransformation T(-1.0, 2.0, 0.5);
+		S2LL::DensifyOptions options;
+		options.max_chord_error = 0.01;
+		const S2LL::GEP<> dense = S2LL::densify(poly, options, sphere, T);
+		size_t expected = 0;
+		for (size_t i = 0; i < poly.size(); ++i)
+		{
+			expected += static_cast<size_t>(poly.edge(static_cast<ptrdiff_t>(i), sphere, T).segments(options.max_chord_error));
+		}
+		REQUIRE(dense.size() == expected);
+		for (size_t i = 0; i < dense.size(); ++i)
+		{
+			REQUIRE_THAT(dense[i].mag(), Catch::Matchers::WithinAbs(3.0, 1e-12));
+		}
+		REQUIRE_THAT(S2LL::area(dense, sphere, T), Catch::Matchers::WithinRel(S2LL::area(poly, sphere, T), 1e-9));
+	}
+
+	SECTION("No bounds leave the ring unchanged") {
+		const S2LL::GP<> dense = S2LL::densify(quad, S2LL::DensifyOptions{});
+		REQUIRE(dense.size() == 4);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			REQUIRE(same(dense[i], quad[i]));
+		}
+	}
+}
+
+TEST_CASE("Densification of region collections", "[core][densify]") {
+	std::vector<S2LL::Compound<S2LL::GP<>>> regions(40);
+	for (size_t c = 0; c < regions.size(); ++c)
+	{
+		const double lat = -60.0 + 3.0 * static_cast<double>(c), lon = 9.0 * static_cast<double>(c);
+		regions[c].polygons.resize(1 + c % 3);
+		for (size_t r = 0; r < regions[c].polygons.size(); ++r)
+		{
+			const double s = 8.0 - 3.0 * static_cast<double>(r);
+			auto& v = regions[c].polygons[r].boundary.vertices;
+			v = { dir(lat - s, lon - s), dir(lat - s, lon + s), dir(lat + s, lon + s), dir(lat + s, lon - s) };
+			if (r % 2 == 1)
+			{
+				std::reverse(v.begin(), v.end());
+			}
+		}
+	}
+	S2LL::DensifyOptions options;
+	options.max_angle = 0.01;
+
+	const S2LL::FlatCompoundSet<S2LL::E3> one = S2LL::densify(regions, options, 1);
+	const S2LL::FlatCompoundSet<S2LL::E3> four = S2LL::densify(regions, options, 4);
+	REQUIRE(one.size() == regions.size());
+	REQUIRE(one.vertices.size() == one.ring_offsets.back());
+	REQUIRE(one.ring_offsets == four.ring_offsets);
+	REQUIRE(one.part_offsets == four.part_offsets);
+	for (size_t i = 0; i < one.vertices.size(); ++i)
+	{
+		REQUIRE(same(one.vertices[i], four.vertices[i]));
+	}
+
+	// Ring by ring, as the single-ring overload writes it
+	size_t r = 0;
+	for (size_t c = 0; c < regions.size(); ++c)
+	{
+		REQUIRE(one[c].size() == regions[c].polygons.size());
+		for (const S2LL::GP<>& poly : regions[c].polygons)
+		{
+			const std::vector<S2LL::E3> dense = S2LL::densify(S2LL::LoopView<S2LL::E3>(poly.boundary), options);
+			const S2LL::LoopView<S2LL::E3> ring = one.ring(r++);
+			REQUIRE(ring.size() == dense.size());
+			for (size_t i = 0; i < dense.size(); ++i)
+			{
+				REQUIRE(same(ring[i], dense[i]));
+			}
+		}
+	}
+
+	// From a flat set, the same again
+	const S2LL::FlatCompoundSet<S2LL::E3> flat = S2LL::densify(S2LL::FlatCompoundSet<S2LL::E3>::from(regions), options, 4);
+	REQUIRE(flat.ring_offsets == one.ring_offsets);
+	for (size_t i = 0; i < one.vertices.size(); ++i)
+	{
+		REQUIRE(same(flat.vertices[i], one.vertices[i]));
+	}
+}
@@ -0,0 +1,210 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <S2LL/Core/Containment.hpp>
+#include <S2LL/Core/EdgeBVH.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace
+{
+	/// Star-shaped ring of n vertices around (1, 1, 1), with a wiggly radius
+	std::vector<S2LL::E3> wiggly_ring(int n)
+	{
+		const S2LL::E3 c = S2LL::E3{ 1, 1, 1 }.normalized();
+		const S2LL::E3 u = S2LL::E3{ 1, -1, 0 }.normalized();
+		const S2LL::E3 w = c.cross(u);
+		std::vector<S2LL::E3> ring;
+		for (int i = 0; i < n; ++i)
+		{
+			const double t = 2.0 * std::numbers::pi * i / n;
+			const double r = 0.5 + 0.2 * std::sin(7.0 * t) + 0.05 * std::sin(53.0 * t);
+			ring.push_back(c * std::cos(r) + (u * std::cos(t) + w * std::sin(t)) * std::sin(r));
+		}
+		return ring;
+	}
+
+	std::vector<S2LL::E3> probe_points(const std::vector<S2LL::E3>& ring)
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 1500; ++i)
+		{
+			pts.push_back({ std::sin(1.1 * i + 0.3) + 0.6, std::cos(2.3 * i) + 0.6, std::sin(0.7 * i - 1.9) + 0.6 });
+		}
+		// Vertices themselves and edge midpoints sit on the boundary
+		for (size_t i = 0; i < ring.size(); i += 37)
+		{
+			pts.push_back(ring[i]);
+			pts.push_back(ring[i] + ring[(i + 1) % ring.size()]);
+		}
+		return pts;
+	}
+
+	double angle(const S2LL::E3& x, const S2LL::E3& y)
+	{
+		return std::atan2(x.cross(y).mag(), x.dot(y));
+	}
+}
+
+TEST_CASE("Edge BVH queries agree with edge scans", "[core][bvh]") {
+	using Catch::Matchers::WithinAbs;
+	const auto ring = wiggly_ring(3000);
+	const size_t n = ring.size();
+	const S2LL::EdgeBVH bvh(S2LL::LoopView<S2LL::E3>(ring), 2);
+	REQUIRE(bvh.size() == n);
+	REQUIRE(bvh.node_count() < n);
+	REQUIRE(bvh.memory_usage() >= n * sizeof(S2LL::E3));
+	const auto pts = probe_points(ring);
+
+	SECTION("Containment matches PreparedPolygon") {
+		const S2LL::PreparedPolygon prepared{ S2LL::LoopView<S2LL::E3>(ring) };
+		size_t inside = 0;
+		for (const auto& p : pts)
+		{
+			REQUIRE(bvh.contains(p) == prepared.contains(p));
+			inside += prepared.contains(p);
+		}
+		REQUIRE(inside > 0);
+		REQUIRE(inside < pts.size());
+	}
+
+	SECTION("Crossings and raycasts match brute force") {
+		for (size_t k = 0; k + 1 < 400; ++k)
+		{
+			const S2LL::E3& a = pts[k];
+			const S2LL::E3& b = pts[k + 1];
+			std::vector<size_t> expected;
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (S2LL::crossing_sign(a, b, ring[i], ring[(i + 1) % n]) > 0)
+				{
+					expected.push_back(i);
+				}
+			}
+			REQUIRE(bvh.crossing_edges(a, b) == expected);
+			REQUIRE(bvh.crosses(a, b) == !expected.empty());
+
+			const auto hit = bvh.raycast(a, b);
+			REQUIRE(hit.has_value() == !expected.empty());
+			if (hit)
+			{
+				double first = 10.0;
+				for (const size_t i : expected)
+				{
+					const S2LL::E3 x = a.cross(b).cross(ring[i].cross(ring[(i + 1) % n])).normalized();
+					const S2LL::E3 y = x.dot(a.normalized() + b.normalized()) < 0.0 ? x * -1.0 : x;
+					first = std::min(first, angle(a, y));
+				}
+				REQUIRE_THAT(hit->angle, WithinAbs(first, 1e-12));
+			}
+		}
+	}
+
+	SECTION("Nearest edge matches brute force") {
+		for (size_t k = 0; k < 300; ++k)
+		{
+			const S2LL::E3 q = pts[k].normalized();
+			const S2LL::EdgeHit hit = bvh.nearest(q);
+			const double d = angle(q, hit.point);
+			REQUIRE_THAT(d, WithinAbs(hit.angle, 1e-12));
+			// No vertex and no edge midpoint is nearer
+			double closest = 10.0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const S2LL::E3 mid = (ring[i] + ring[(i + 1) % n]).normalized();
+				closest = std::min({ closest, angle(q, ring[i]), angle(q, mid) });
+			}
+			REQUIRE(closest >= hit.angle - 1e-12);
+		}
+	}
+}
+
+TEST_CASE("Edge BVH on small rings", "[core][bvh]") {
+	using Catch::Matchers::WithinAbs;
+	const S2LL::GP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+	const S2LL::EdgeBVH bvh(octant);
+	REQUIRE(bvh.contains({ 1, 1, 1 }));
+	REQUIRE_FALSE(bvh.contains({ -1, -1, -1 }));
+	REQUIRE(bvh.crosses({ 1, 1, 1 }, { 1, 1, -1 }));
+	REQUIRE(bvh.crossing_edges({ 1, 1, 1 }, { 1, 1, -1 }) == std::vector<size_t>{ 0 });
+
+	const auto hit = bvh.raycast({ 1, 1, 1 }, { 1, 1, -1 });
+	REQUIRE(hit.has_value());
+	REQUIRE(hit->edge == 0);
+	REQUIRE_THAT(hit->point.z, WithinAbs(0.0, 1e-15));
+
+	const S2LL::EdgeHit near = bvh.nearest({ 1, 1, -1 });
+	REQUIRE(near.edge == 0);
+	REQUIRE_THAT(near.angle, WithinAbs(std::atan(1.0 / std::sqrt(2.0)), 1e-15));
+}
+
+TEST_CASE("Edge BVH over several rings", "[core][bvh]") {
+	using Catch::Matchers::WithinAbs;
+	// An outer ring, a hole inside it and a separate island
+	const auto outer = wiggly_ring(800);
+	std::vector<S2LL::E3> hole, island;
+	const S2LL::E3 c = S2LL::E3{ 1, 1, 1 }.normalized();
+	for (const S2LL::E3& v : outer)
+	{
+		hole.push_back((c * 3.0 + v).normalized());
+		island.push_back(S2LL::E3{ -v.x, -v.y, -v.z });
+	}
+	// Reflected through the center, a ring turns clockwise
+	std::reverse(hole.begin(), hole.end());
+	std::reverse(island.begin(), island.end());
+	const std::vector<S2LL::LoopView<S2LL::E3>> rings{ outer, hole, island };
+	const S2LL::EdgeBVH bvh{ std::span<const S2LL::LoopView<S2LL::E3>>(rings) };
+	REQUIRE(bvh.size() == 3 * outer.size());
+	REQUIRE(bvh.ring_count() == 3);
+	REQUIRE(bvh.ring_of(0) == 0);
+	REQUIRE(bvh.ring_of(outer.size() - 1) == 0);
+	REQUIRE(bvh.ring_of(outer.size()) == 1);
+	REQUIRE(bvh.ring_of(3 * outer.size() - 1) == 2);
+
+	// Edges close within their own ring
+	const auto [a, b] = bvh.edge(2 * outer.size() - 1);
+	REQUIRE((a.x == hole.back().x && a.y == hole.back().y && a.z == hole.back().z));
+	REQUIRE((b.x == hole.front().x && b.y == hole.front().y && b.z == hole.front().z));
+
+	const S2LL::PreparedPolygon p0{ S2LL::LoopView<S2LL::E3>(outer) };
+	const S2LL::PreparedPolygon p1{ S2LL::LoopView<S2LL::E3>(hole) };
+	const S2LL::PreparedPolygon p2{ S2LL::LoopView<S2LL::E3>(island) };
+	auto pts = probe_points(outer);
+	pts.push_back(c);
+	pts.push_back(c * -1.0);
+	size_t inside = 0;
+	for (const auto& p : pts)
+	{
+		const bool expected = p0.contains(p) != p1.contains(p) != p2.contains(p);
+		REQUIRE(bvh.contains(p) == expected);
+		inside += expected;
+	}
+	REQUIRE(inside > 0);
+
+	for (size_t k = 0; k < 100; ++k)
+	{
+		const S2LL::E3 q = pts[k].normalized();
+		const S2LL::EdgeHit near = bvh.nearest(q);
+		const double radius = near.angle + 0.05;
+		const std::vector<S2LL::EdgeHit> hits = bvh.within(q, radius);
+		REQUIRE(!hits.empty());
+		REQUIRE(hits.front().edge == near.edge);
+		REQUIRE_THAT(hits.front().angle, WithinAbs(near.angle, 1e-15));
+		for (size_t h = 1; h < hits.size(); ++h)
+		{
+			REQUIRE(hits[h - 1].angle <= hits[h].angle);
+		}
+		// Every edge with an endpoint well inside the radius is reported
+		for (size_t i = 0; i < bvh.size(); ++i)
+		{
+			const auto [u, v] = bvh.edge(i);
+			if (std::min(angle(q, u), angle(q, v)) < radius - 1e-12)
+			{
+				REQUIRE(std::any_of(hits.begin(), hits.end(), [&](const S2LL::EdgeHit& h) { return h.edge == i; }));
+			}
+		}
+	}
+}
@@ -0,0 +1,241 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <S2LL/Core/Geodesics.hpp>
+#include <S2LL/Core/Regions.hpp>
+
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <optional>
+#include <vector>
+
+using namespace S2LL::Literals;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Geodesic inverse problem", "[core][geodesic]") {
+	const S2LL::GeodesicSolver g(S2LL::wgs84);
+
+	SECTION("Quarter meridian of WGS 84") {
+		const auto r = g.inverse({ 90_deg, 0.0 }, { 0.0, 0.0 });
+		REQUIRE_THAT(r.s12, WithinAbs(10001965.7293127, 1e-6));
+		REQUIRE_THAT(std::abs(r.azi1), WithinAbs(180_deg, 1e-15));
+		REQUIRE_THAT(std::abs(r.azi2), WithinAbs(180_deg, 1e-15));
+	}
+
+	SECTION("Equatorial antipodes are joined over the pole") {
+		const auto r = g.inverse({ 0.0, 0.0 }, { 0.0, 180_deg });
+		REQUIRE_THAT(r.s12, WithinAbs(2.0 * 10001965.7293127, 2e-6));
+	}
+
+	SECTION("Short equatorial arc runs along the equator") {
+		const auto r = g.inverse({ 0.0, 0.0 }, { 0.0, 1_deg });
+		REQUIRE_THAT(r.s12, WithinAbs(6378137.0 * 1_deg, 1e-8));
+		REQUIRE_THAT(r.azi1, WithinAbs(90_deg, 1e-15));
+		REQUIRE_THAT(r.azi2, WithinAbs(90_deg, 1e-15));
+	}
+
+	SECTION("The sphere reduces to great-circle distance") {
+		const S2LL::GeodesicSolver unit(S2LL::UnitSphere);
+		const S2LL::LL p{ 0.3, -1.2 }, q{ -0.8, 2.0 };
+		const double central = std::acos(std::sin(p.lat) * std::sin(q.lat)
+			+ std::cos(p.lat) * std::cos(q.lat) * std::cos(q.lon - p.lon));
+		REQUIRE_THAT(unit.distance(p, q), WithinAbs(central, 1e-15));
+	}
+
+	SECTION("Swapping the endpoints reverses the azimuths") {
+		const S2LL::LL p{ 0.6, 0.1 }, q{ -0.2, 2.9 };
+		const auto pq = g.inverse(p, q);
+		const auto qp = g.inverse(q, p);
+		REQUIRE(pq.s12 == qp.s12);
+		REQUIRE_THAT(std::remainder(pq.azi1 - (qp.azi2 + 180_deg), 2.0 * std::numbers::pi), WithinAbs(0.0, 1e-14));
+	}
+
+	SECTION("Triaxial surfaces have no solver") {
+		const S2LL::GeodesicSolver t(S2LL::Ellipsoid(3.0, 2.0, 1.0));
+		REQUIRE(std::isnan(t.distance({ 0.1, 0.2 }, { 0.3, 0.4 })));
+	}
+}
+
+TEST_CASE("Geodesic direct problem", "[core][geodesic]") {
+	const S2LL::GeodesicSolver g(S2LL::wgs84);
+
+	SECTION("Direct and inverse solutions agree") {
+		// Includes nearly antipodal end points, where Newton's method starts
+		// from the astroid estimate
+		for (int i = 0; i < 200; ++i)
+		{
+			const S2LL::LL p{ std::asin(std::sin(0.37 * i)), std::remainder(1.3 * i, 2.0 * std::numbers::pi) };
+			const double azi = std::remainder(2.1 * i + 0.4, 2.0 * std::numbers::pi);
+			const double s = 19.9e6 * (i % 20 + 0.5) / 20.0;
+			const auto d = g.direct(p, azi, s);
+
+			const auto r = g.inverse(p, d.ll2);
+			REQUIRE(r.s12 <= s + 1e-8);
+			const auto back = g.direct(p, r.azi1, r.s12);
+			const S2LL::E3 a = S2LL::wgs84.to_E3(S2LL::LLH{ d.ll2.lat, d.ll2.lon, 0.0 });
+			const S2LL::E3 b = S2LL::wgs84.to_E3(S2LL::LLH{ back.ll2.lat, back.ll2.lon, 0.0 });
+			REQUIRE(std::hypot(a.x - b.x, a.y - b.y, a.z - b.z) < 1e-7);
+			if (s < 9e6)
+			{
+				REQUIRE_THAT(r.s12, WithinAbs(s, 1e-8));
+				REQUIRE_THAT(std::remainder(r.azi1 - azi, 2.0 * std::numbers::pi), WithinAbs(0.0, 1e-14));
+			}
+		}
+	}
+
+	SECTION("Lines reuse their coefficients") {
+		const S2LL::LL p{ -0.4, 1.0 };
+		const auto line = g.line(p, 0.25);
+		for (double s = -5e6; s <= 5e6; s += 1.25e6)
+		{
+			const auto a = line.position(s);
+			const auto b = g.direct(p, 0.25, s);
+			REQUIRE(a.ll2.lat == b.ll2.lat);
+			REQUIRE(a.ll2.lon == b.ll2.lon);
+			REQUIRE(a.azi2 == b.azi2);
+		}
+	}
+}
+
+TEST_CASE("Batched geodesic problems", "[core][geodesic]") {
+	const S2LL::GeodesicSolver g(S2LL::wgs84);
+	std::vector<S2LL::LL> sites;
+	for (int i = 0; i < 40; ++i)
+	{
+		sites.push_back(S2LL::LL{ std::asin(std::sin(0.71 * i)), std::remainder(2.3 * i, 2.0 * std::numbers::pi) });
+	}
+
+	SECTION("Pairwise solutions match single calls") {
+		std::vector<S2LL::LL> to(sites.rbegin(), sites.rend());
+		std::vector<S2LL::GeodesicInverse> out(sites.size());
+		g.inverse(sites, to, out);
+		for (size_t i = 0; i < sites.size(); ++i)
+		{
+			const auto r = g.inverse(sites[i], to[i]);
+			REQUIRE(out[i].s12 == r.s12);
+			REQUIRE(out[i].azi1 == r.azi1);
+			REQUIRE(out[i].azi2 == r.azi2);
+		}
+	}
+
+	SECTION("Distance matrices") {
+		const size_t n = sites.size();
+		std::vector<double> square(n * n);
+		g.distances(sites, sites, square);
+
+		// A copy of the sites is not the same range, so every entry is solved
+		const std::vector<S2LL::LL> copy = sites;
+		std::vector<double> full(n * n);
+		g.distances(sites, copy, full);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			REQUIRE(square[i * n + i] == 0.0);
+			for (size_t j = 0; j < n; ++j)
+			{
+				REQUIRE(square[i * n + j] == square[j * n + i]);
+				REQUIRE_THAT(full[i * n + j], WithinAbs(square[i * n + j], 1e-8));
+			}
+		}
+		REQUIRE(full[3 * n + 7] == g.distance(sites[3], sites[7]));
+	}
+}
+
+TEST_CASE("Geodesic arcs on the sphere", "[core][geodesic]") {
+	const S2LL::Ellipsoid sphere(2.0);
+	const S2LL::GeodesicArc arc{ { 1, 0, 0 }, { 0, 5, 0 }, sphere };
+	const auto frame = arc.frame();
+
+	SECTION("Length and slerp") {
+		REQUIRE_THAT(frame.length(), WithinAbs(std::numbers::pi, 1e-15));
+		const S2LL::E3 mid = arc.interpolate(0.5);
+		REQUIRE_THAT(mid.x, WithinAbs(std::sqrt(2.0), 1e-15));
+		REQUIRE_THAT(mid.y, WithinAbs(std::sqrt(2.0), 1e-15));
+
+		std::array<S2LL::E3, 9> points;
+		frame.sample(8, points.begin());
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			const S2LL::E3 p = frame.interpolate(static_cast<double>(i) / 8);
+			REQUIRE((points[i] - p).mag() < 1e-15);
+		}
+		REQUIRE(points.back().y == 2.0);
+	}
+
+	SECTION("Closest points") {
+		const auto inner = arc.closest({ 1, 1, 1 });
+		REQUIRE_THAT(inner.point.x, WithinAbs(std::sqrt(2.0), 1e-15));
+		REQUIRE_THAT(inner.s, WithinAbs(0.5 * std::numbers::pi, 1e-15));
+		REQUIRE_THAT(inner.distance, WithinAbs(2.0 * std::acos(2.0 / std::sqrt(6.0)), 1e-15));
+
+		const auto outer = arc.closest({ -1, -0.1, 0 });
+		REQUIRE(outer.s == frame.length());
+		REQUIRE(outer.point.y == 2.0);
+		REQUIRE_THAT(arc.distance({ 0, 0, -3 }), WithinAbs(std::numbers::pi, 1e-15));
+	}
+}
+
+TEST_CASE("Geodesic arcs on WGS 84", "[core][geodesic]") {
+	const S2LL::GeodesicSolver g(S2LL::wgs84);
+	const S2LL::LL A{ 0.7, -1.9 }, B{ -0.2, 0.4 };
+	const auto surface = [](const S2LL::LL& p) {
+		return S2LL::wgs84.to_E3(S2LL::LLH{ p.lat, p.lon, 0.0 });
+	};
+	const auto inv = g.inverse(A, B);
+	const S2LL::GeodesicArc arc{ surface(A), surface(B), S2LL::wgs84 };
+	const auto frame = arc.frame(g);
+
+	SECTION("Length and samples follow the solver") {
+		REQUIRE_THAT(frame.length(), WithinAbs(inv.s12, 1e-8));
+		std::vector<S2LL::E3> points;
+		frame.sample(16, std::back_inserter(points));
+		REQUIRE(points.size() == 17);
+		REQUIRE((points.front() - surface(A)).mag() < 1e-8);
+		REQUIRE((points.back() - surface(B)).mag() < 1e-8);
+
+		const auto line = g.line(A, inv.azi1);
+		const auto x = line.position(inv.s12 * 5 / 16);
+		REQUIRE((points[5] - surface(x.ll2)).mag() < 1e-8);
+	}
+
+	SECTION("Closest point is the foot of the perpendicular geodesic") {
+		const auto x = g.line(A, inv.azi1).position(0.4 * inv.s12);
+		const auto p = g.direct(x.ll2, x.azi2 + 90_deg, 1.0e4);
+		const auto foot = frame.closest(surface(p.ll2) * 1.5);
+		REQUIRE_THAT(foot.s, WithinAbs(0.4 * inv.s12, 1e-6));
+		REQUIRE_THAT(foot.distance, WithinAbs(1.0e4, 1e-6));
+		REQUIRE((foot.point - surface(x.ll2)).mag() < 1e-6);
+
+		const auto beyond = frame.closest(surface(g.line(A, inv.azi1).position(-1.0e5).ll2));
+		REQUIRE(beyond.s == 0.0);
+		REQUIRE_THAT(beyond.distance, WithinAbs(1.0e5, 1e-6));
+	}
+
+	SECTION("Frames refer to a given solver and share an owned one") {
+		std::optional<S2LL::GeodesicArcFrame> owner(arc.frame());
+		const S2LL::GeodesicArcFrame copy = *owner;
+		owner.reset();
+		const auto x = g.line(A, inv.azi1).position(0.25 * inv.s12);
+		REQUIRE_THAT(copy.closest(surface(x.ll2)).s, WithinAbs(0.25 * inv.s12, 1e-6));
+		REQUIRE_THAT(copy.length(), WithinAbs(frame.length(), 1e-8));
+	}
+}
+
+TEST_CASE("Geodesic polygons sample into one ring", "[core][geodesic]") {
+	const S2LL::GP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+	std::vector<S2LL::E3> ring;
+	S2LL::sample_boundary(octant, 4, std::back_inserter(ring));
+	REQUIRE(ring.size() == 12);
+	for (const auto& p : ring)
+	{
+		REQUIRE_THAT(p.mag(), WithinAbs(1.0, 1e-15));
+	}
+	REQUIRE(ring[4].y == 1.0);
+	REQUIRE(ring[8].z == 1.0);
+
+	std::vector<S2LL::E3> wgs(12);
+	S2LL::sample_boundary(octant, 4, wgs.begin(), S2LL::wgs84);
+	REQUIRE_THAT(wgs[4].y, WithinAbs(S2LL::wgs84.major(), 1e-8));
+	REQUIRE_THAT(wgs[8].z, WithinAbs(S2LL::wgs84.minor(), 1e-8));
+}
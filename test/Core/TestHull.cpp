@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Hull.hpp>
+#include <S2LL/Core/Predicates.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Deterministic pseudo-random directions within the given latitudes
+	std::vector<S2LL::E3> scatter(size_t n, double lat0, double lat1, double lon0, double lon1)
+	{
+		std::vector<S2LL::E3> pts;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double s = 0.5 + 0.5 * std::sin(12.9898 * i + 0.7), t = 0.5 + 0.5 * std::sin(78.233 * i + 1.3);
+			pts.push_back(dir(lat0 + (lat1 - lat0) * s, lon0 + (lon1 - lon0) * t));
+		}
+		return pts;
+	}
+
+	/// Every point on or to the left of every edge, with strict left turns
+	void check_hull(const S2LL::GP<>& hull, const std::vector<S2LL::E3>& pts)
+	{
+		const size_t m = hull.size();
+		REQUIRE(m >= 3);
+		for (size_t i = 0; i < m; ++i)
+		{
+			const S2LL::E3& a = hull.boundary.vertices[i];
+			const S2LL::E3& b = hull.boundary.vertices[(i + 1) % m];
+			REQUIRE(S2LL::orient(a, b, hull.boundary.vertices[(i + 2) % m]) == 1);
+			for (const S2LL::E3& p : pts)
+			{
+				REQUIRE(S2LL::orient(a, b, p) >= 0);
+			}
+		}
+	}
+}
+
+TEST_CASE("Spherical convex hull", "[core][hull]") {
+	SECTION("Corners of a box with interior points") {
+		std::vector<S2LL::E3> pts = scatter(200, 1, 9, 1, 9);
+		const std::vector<S2LL::E3> corners{ dir(0, 0), dir(0, 10), dir(10, 10), dir(10, 0) };
+		pts.insert(pts.begin() + 50, corners.begin(), corners.end());
+		pts.push_back(corners[2]);
+		const S2LL::GP<> hull = S2LL::convex_hull(pts);
+		REQUIRE(hull.size() == 4);
+		for (const S2LL::E3& c : corners)
+		{
+			REQUIRE(std::count_if(hull.boundary.vertices.begin(), hull.boundary.vertices.end(), [&](const S2LL::E3& v) {
+				return v.x == c.x && v.y == c.y && v.z == c.z;
+			}) == 1);
+		}
+		check_hull(hull, pts);
+	}
+
+	SECTION("Chunked hulls match the single pass") {
+		// Around a pole, where longitudes wrap
+		const std::vector<S2LL::E3> pts = scatter(20000, 50, 89, -180, 180);
+		const S2LL::GP<> one = S2LL::convex_hull(pts, 1);
+		const S2LL::GP<> four = S2LL::convex_hull(pts, 4);
+		check_hull(one, pts);
+		REQUIRE(one.size() == four.size());
+		for (size_t i = 0; i < one.size(); ++i)
+		{
+			REQUIRE(one.boundary.vertices[i].x == four.boundary.vertices[i].x);
+			REQUIRE(one.boundary.vertices[i].y == four.boundary.vertices[i].y);
+			REQUIRE(one.boundary.vertices[i].z == four.boundary.vertices[i].z);
+		}
+	}
+
+	SECTION("Points beyond a hemisphere have no hull") {
+		REQUIRE(S2LL::convex_hull(scatter(100, -80, 80, -180, 180)).size() == 0);
+		REQUIRE(S2LL::convex_hull(std::vector<S2LL::E3>{ dir(0, 0), dir(0, 180) }).size() == 0);
+		REQUIRE(S2LL::convex_hull(std::vector<S2LL::E3>{}).size() == 0);
+	}
+}
+
+TEST_CASE("Convex hull in E3", "[core][hull]") {
+	SECTION("Points on the sphere are all vertices") {
+		const std::vector<S2LL::E3> pts = scatter(400, -90, 90, -180, 180);
+		const auto triangles = S2LL::convex_hull_3d(pts);
+		REQUIRE(triangles.size() == 2 * pts.size() - 4);
+		std::vector<int> used(pts.size(), 0);
+		for (const auto& t : triangles)
+		{
+			for (const uint32_t v : t)
+			{
+				used[v] = 1;
+			}
+			// Counterclockwise from outside, with no point beyond the face
+			REQUIRE(S2LL::orient(pts[t[0]], pts[t[1]], pts[t[2]]) == 1);
+			for (const S2LL::E3& p : pts)
+			{
+				REQUIRE(S2LL::orient3d(pts[t[0]], pts[t[1]], pts[t[2]], p) <= 0);
+			}
+		}
+		REQUIRE(std::count(used.begin(), used.end(), 1) == static_cast<long>(pts.size()));
+	}
+
+	SECTION("Coplanar faces and interior points") {
+		std::vector<S2LL::E3> cube;
+		for (const int x : { -1, 1 })
+		{
+			for (const int y : { -1, 1 })
+			{
+				for (const int z : { -1, 1 })
+				{
+					cube.push_back({ double(x), double(y), double(z) });
+				}
+			}
+		}
+		cube.push_back({ 0.5, 0.0, 0.25 });
+		cube.push_back({ 1.0, 0.0, 0.0 });
+		cube.push_back({ 1.0, 1.0, 1.0 });
+		const auto triangles = S2LL::convex_hull_3d(cube);
+		REQUIRE(triangles.size() == 12);
+		for (const auto& t : triangles)
+		{
+			for (const uint32_t v : t)
+			{
+				REQUIRE(v < 8);
+			}
+		}
+	}
+
+	SECTION("Degenerate inputs") {
+		REQUIRE(S2LL::convex_hull_3d(std::vector<S2LL::E3>{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }).empty());
+		REQUIRE(S2LL::convex_hull_3d(std::vector<S2LL::E3>{ { 1, 0, 0 }, { 0, 1, 0 }, { -1, 0, 0 }, { 0, -1, 0 }, { 0.6, 0.8, 0 } }).empty());
+	}
+}
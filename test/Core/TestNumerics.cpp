@@ -92,3 +92,32 @@ TEST_CASE("Double Inverse Trigonometric Functions", "[core][numerics]") {
 		REQUIRE(static_cast<double>(S2LL::Atan2(S2LL::Double::Zero, S2LL::Double::One)) == 0.0);
 	}
 }
+
+TEST_CASE("Double addition renormalizes on cancellation", "[core][numerics]") {
+	// The high components cancel exactly; the low ones must move up rather
+	// than leave a { 0, lo } pair that Quick-Two-Sum in Mul would reject
+	const double tiny = std::ldexp(1.0, -60), tinier = std::ldexp(1.0, -70);
+	const S2LL::Double a{ 1.0, tiny };
+
+	SECTION("Add and Sub") {
+		const S2LL::Double sum = S2LL::Add(a, S2LL::Double{ -1.0, tinier });
+		REQUIRE(sum.hi == tiny + tinier);
+		REQUIRE(sum.lo == 0.0);
+
+		const S2LL::Double difference = S2LL::Sub(a, S2LL::Double{ 1.0, tinier });
+		REQUIRE(difference.hi == tiny - tinier);
+		REQUIRE(difference.lo == 0.0);
+	}
+
+	SECTION("The result feeds Mul") {
+		const S2LL::Double product = S2LL::Mul(S2LL::Sub(a, S2LL::Double::One), S2LL::Double{ 3.0, 0.0 });
+		REQUIRE(product.hi == 3.0 * tiny);
+		REQUIRE(product.lo == 0.0);
+	}
+
+	SECTION("Normalized sums are unchanged") {
+		const S2LL::Double sum = S2LL::Add(a, S2LL::Double{ std::ldexp(1.0, -30), 0.0 });
+		REQUIRE(sum.hi == 1.0 + std::ldexp(1.0, -30));
+		REQUIRE(sum.lo == tiny);
+	}
+}
@@ -0,0 +1,215 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Area.hpp>
+#include <S2LL/Core/Overlay.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/// Counterclockwise ring through the corners of a latitude/longitude box
+	S2LL::GP<> box(double lat0, double lon0, double lat1, double lon1)
+	{
+		return S2LL::GP<>{ dir(lat0, lon0), dir(lat0, lon1), dir(lat1, lon1), dir(lat1, lon0) };
+	}
+
+	S2LL::GP<> reversed(const S2LL::GP<>& poly)
+	{
+		S2LL::GP<> r;
+		r.boundary.vertices.assign(poly.boundary.vertices.rbegin(), poly.boundary.vertices.rend());
+		return r;
+	}
+
+	/// Checks the result against the operation applied to both operands on a
+	/// grid of probe points, none of them on a boundary
+	void check_pointwise(const S2LL::Compound<S2LL::GP<>>& a, const S2LL::Compound<S2LL::GP<>>& b, S2LL::BooleanOp op)
+	{
+		const S2LL::Compound<S2LL::GP<>> result = S2LL::overlay(a, b, op);
+		const S2LL::RegionIndex index(std::vector<S2LL::Compound<S2LL::GP<>>>{ a, b, result });
+		for (double lat = -29.87; lat < 40.0; lat += 0.73)
+		{
+			for (double lon = -29.91; lon < 40.0; lon += 0.71)
+			{
+				const S2LL::E3 p = dir(lat, lon);
+				const bool in_a = index.contains(0, p), in_b = index.contains(1, p);
+				const bool expected = op == S2LL::BooleanOp::Union ? in_a || in_b
+					: op == S2LL::BooleanOp::Intersection ? in_a && in_b
+					: in_a && !in_b;
+				REQUIRE(index.contains(2, p) == expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("Overlay of crossing polygons", "[core][overlay]") {
+	using Catch::Matchers::WithinAbs;
+	const S2LL::Compound<S2LL::GP<>> a{ { box(0, 0, 10, 10) } };
+	const S2LL::Compound<S2LL::GP<>> b{ { box(5, 5, 15, 15) } };
+	const double area_a = S2LL::area(a), area_b = S2LL::area(b);
+
+	const auto both = S2LL::intersect(a, b);
+	const auto either = S2LL::unite(a, b);
+	const auto only_a = S2LL::subtract(a, b);
+	REQUIRE(both.polygons.size() == 1);
+	REQUIRE(both.polygons[0].size() == 4);
+	REQUIRE(either.polygons.size() == 1);
+	REQUIRE(either.polygons[0].size() == 8);
+	REQUIRE(only_a.polygons.size() == 1);
+	REQUIRE(only_a.polygons[0].size() == 6);
+
+	REQUIRE(S2LL::area(both) > 0.0);
+	REQUIRE_THAT(S2LL::area(either) + S2LL::area(both), WithinAbs(area_a + area_b, 1e-15));
+	REQUIRE_THAT(S2LL::area(only_a) + S2LL::area(both), WithinAbs(area_a, 1e-15));
+
+	for (const auto op : { S2LL::BooleanOp::Union, S2LL::BooleanOp::Intersection, S2LL::BooleanOp::Difference })
+	{
+		check_pointwise(a, b, op);
+		check_pointwise(b, a, op);
+	}
+
+	SECTION("Ring orientation does not matter") {
+		const S2LL::Compound<S2LL::GP<>> cw{ { reversed(b.polygons[0]) } };
+		REQUIRE_THAT(S2LL::area(S2LL::intersect(a, cw)), WithinAbs(S2LL::area(both), 1e-15));
+	}
+}
+
+TEST_CASE("Overlay of sub-metre polygons", "[core][overlay]") {
+	using Catch::Matchers::WithinRel;
+	// Boxes some 45 cm and 4.5 cm across (7e-8 and 7e-9 rad); below about
+	// 1e-8 rad the cosines of their cap radii round to 1 unless padded
+	for (const double s : { 4e-6, 4e-7 })
+	{
+		const S2LL::Compound<S2LL::GP<>> a{ { box(45, 10, 45 + s, 10 + s) } };
+		const S2LL::Compound<S2LL::GP<>> b{ { box(45 + 0.5 * s, 10 + 0.5 * s, 45 + 1.5 * s, 10 + 1.5 * s) } };
+		const auto both = S2LL::intersect(a, b);
+		const auto either = S2LL::unite(a, b);
+		const auto only_a = S2LL::subtract(a, b);
+		REQUIRE(both.polygons.size() == 1);
+		REQUIRE(both.polygons[0].size() == 4);
+		REQUIRE(either.polygons.size() == 1);
+		REQUIRE(either.polygons[0].size() == 8);
+		REQUIRE(only_a.polygons.size() == 1);
+		REQUIRE(only_a.polygons[0].size() == 6);
+		REQUIRE_THAT(S2LL::area(either) + S2LL::area(both), WithinRel(S2LL::area(a) + S2LL::area(b), 1e-6));
+
+		const S2LL::RegionIndex index(std::vector<S2LL::Compound<S2LL::GP<>>>{ a, b, both, either, only_a });
+		for (double i = -0.13; i < 2.0; i += 0.17)
+		{
+			for (double j = -0.11; j < 2.0; j += 0.19)
+			{
+				const S2LL::E3 p = dir(45 + i * s, 10 + j * s);
+				const bool in_a = index.contains(0, p), in_b = index.contains(1, p);
+				REQUIRE(index.contains(2, p) == (in_a && in_b));
+				REQUIRE(index.contains(3, p) == (in_a || in_b));
+				REQUIRE(index.contains(4, p) == (in_a && !in_b));
+			}
+		}
+	}
+}
+
+TEST_CASE("Overlay with holes and disjoint parts", "[core][overlay]") {
+	using Catch::Matchers::WithinAbs;
+	// A frame (a box with a hole) and two boxes: one across the hole and the
+	// frame, one far away
+	const S2LL::Compound<S2LL::GP<>> frame{ { box(-20, -20, 20, 20), reversed(box(-10, -10, 10, 10)) } };
+	const S2LL::Compound<S2LL::GP<>> boxes{ { box(-5, -5, 5, 30), box(-25, 25, -22, 35) } };
+	for (const auto op : { S2LL::BooleanOp::Union, S2LL::BooleanOp::Intersection, S2LL::BooleanOp::Difference })
+	{
+		check_pointwise(frame, boxes, op);
+		check_pointwise(boxes, frame, op);
+	}
+
+	const double both = S2LL::area(S2LL::intersect(frame, boxes));
+	const double either = S2LL::area(S2LL::unite(frame, boxes));
+	REQUIRE_THAT(either + both, WithinAbs(S2LL::area(frame) + S2LL::area(boxes), 1e-14));
+	REQUIRE_THAT(S2LL::area(S2LL::subtract(frame, boxes)) + both, WithinAbs(S2LL::area(frame), 1e-14));
+}
+
+TEST_CASE("Overlay of polygons sharing boundaries", "[core][overlay]") {
+	using Catch::Matchers::WithinAbs;
+	const S2LL::Compound<S2LL::GP<>> west{ { box(0, 0, 10, 10) } };
+	const S2LL::Compound<S2LL::GP<>> east{ { box(0, 10, 10, 20) } };
+
+	SECTION("Neighbours merge along their common edge") {
+		const auto merged = S2LL::unite(west, east);
+		REQUIRE(merged.polygons.size() == 1);
+		REQUIRE(merged.polygons[0].size() == 6);
+		REQUIRE_THAT(S2LL::area(merged), WithinAbs(S2LL::area(west) + S2LL::area(east), 1e-15));
+		REQUIRE(S2LL::intersect(west, east).polygons.empty());
+		const auto rest = S2LL::subtract(west, east);
+		REQUIRE(rest.polygons.size() == 1);
+		REQUIRE_THAT(S2LL::area(rest), WithinAbs(S2LL::area(west), 1e-15));
+	}
+
+	SECTION("Neighbours with different vertices along the common edge") {
+		// The common meridian is traced through (1, 2) by one neighbour only,
+		// then through different extra vertices by both
+		const S2LL::Compound<S2LL::GP<>> left{ { box(0, 0, 2, 2) } };
+		const S2LL::Compound<S2LL::GP<>> right{ { S2LL::GP<>{ dir(0, 2), dir(0, 4), dir(2, 4), dir(2, 2), dir(1, 2) } } };
+		const S2LL::Compound<S2LL::GP<>> left3{ { S2LL::GP<>{ dir(0, 0), dir(0, 2), dir(0.5, 2), dir(2, 2), dir(2, 0) } } };
+		const S2LL::Compound<S2LL::GP<>> right3{ { S2LL::GP<>{ dir(0, 2), dir(0, 4), dir(2, 4), dir(2, 2), dir(1.5, 2) } } };
+		for (const auto& [l, r] : { std::pair{ left, right }, std::pair{ right, left }, std::pair{ left3, right3 } })
+		{
+			REQUIRE(S2LL::intersect(l, r).polygons.empty());
+			const auto merged = S2LL::unite(l, r);
+			REQUIRE(merged.polygons.size() == 1);
+			REQUIRE(merged.polygons[0].size() == 6);
+			REQUIRE_THAT(S2LL::area(merged), WithinAbs(S2LL::area(l) + S2LL::area(r), 1e-15));
+			const auto rest = S2LL::subtract(l, r);
+			REQUIRE(rest.polygons.size() == 1);
+			REQUIRE_THAT(S2LL::area(rest), WithinAbs(S2LL::area(l), 1e-15));
+			for (const auto op : { S2LL::BooleanOp::Union, S2LL::BooleanOp::Intersection, S2LL::BooleanOp::Difference })
+			{
+				check_pointwise(l, r, op);
+			}
+		}
+	}
+
+	SECTION("Edges overlapping in part") {
+		const S2LL::Compound<S2LL::GP<>> low{ { box(0, 0, 2, 2) } };
+		const S2LL::Compound<S2LL::GP<>> high{ { box(1, 2, 3, 4) } };
+		REQUIRE(S2LL::intersect(low, high).polygons.empty());
+		REQUIRE(S2LL::intersect(high, low).polygons.empty());
+		const auto merged = S2LL::unite(low, high);
+		REQUIRE(merged.polygons.size() == 1);
+		REQUIRE(merged.polygons[0].size() == 8);
+		REQUIRE_THAT(S2LL::area(merged), WithinAbs(S2LL::area(low) + S2LL::area(high), 1e-15));
+		REQUIRE_THAT(S2LL::area(S2LL::subtract(low, high)), WithinAbs(S2LL::area(low), 1e-15));
+	}
+
+	SECTION("A polygon with itself") {
+		REQUIRE_THAT(S2LL::area(S2LL::unite(west, west)), WithinAbs(S2LL::area(west), 1e-15));
+		REQUIRE_THAT(S2LL::area(S2LL::intersect(west, west)), WithinAbs(S2LL::area(west), 1e-15));
+		REQUIRE(S2LL::subtract(west, west).polygons.empty());
+	}
+
+	SECTION("Corners touching give separate rings") {
+		const S2LL::Compound<S2LL::GP<>> north_east{ { box(10, 10, 20, 20) } };
+		const auto pair = S2LL::unite(west, north_east);
+		REQUIRE(pair.polygons.size() == 2);
+		REQUIRE(pair.polygons[0].size() == 4);
+		REQUIRE(pair.polygons[1].size() == 4);
+	}
+}
+
+TEST_CASE("Batch overlay of independent pairs", "[core][overlay]") {
+	std::vector<S2LL::Compound<S2LL::GP<>>> a, b;
+	for (int i = 0; i < 40; ++i)
+	{
+		const double lon = -170.0 + 8.0 * i, lat = -40.0 + 2.0 * i;
+		a.push_back({ { box(lat, lon, lat + 5, lon + 5) } });
+		b.push_back({ { box(lat + 2, lon + 1, lat + 8, lon + 3) } });
+	}
+	std::vector<S2LL::Compound<S2LL::GP<>>> out(a.size());
+	S2LL::overlay(a, b, S2LL::BooleanOp::Difference, out, 3);
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		REQUIRE(S2LL::area(out[i]) == S2LL::area(S2LL::subtract(a[i], b[i])));
+		REQUIRE(S2LL::area(out[i]) < S2LL::area(a[i]));
+	}
+}
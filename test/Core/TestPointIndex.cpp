@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/PointIndex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/// Scattered points, a lattice with many equal distances, duplicates and
+	/// a few points off the unit sphere
+	std::vector<S2LL::E3> cloud()
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 3000; ++i)
+		{
+			pts.push_back(S2LL::E3{ std::sin(1.1 * i + 0.3), std::cos(2.3 * i), std::sin(0.7 * i - 1.9) }.normalized());
+		}
+		for (int lat = -80; lat <= 80; lat += 10)
+		{
+			for (int lon = -180; lon < 180; lon += 10)
+			{
+				pts.push_back(dir(lat, lon));
+			}
+		}
+		for (int i = 0; i < 50; ++i)
+		{
+			pts.push_back(pts[static_cast<size_t>(7 * i)]);
+			pts.push_back(pts[static_cast<size_t>(11 * i)] * 3.0);
+		}
+		return pts;
+	}
+
+	/// Direction as the index normalizes it, so that scaled copies tie
+	S2LL::E3 unit(const S2LL::E3& v)
+	{
+		const double m = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+		return { v.x / m, v.y / m, v.z / m };
+	}
+
+	/// Squared chords to every point, ordered by chord and then index
+	std::vector<std::pair<double, size_t>> ranked(const std::vector<S2LL::E3>& pts, const S2LL::E3& p)
+	{
+		const S2LL::E3 q = unit(p);
+		std::vector<std::pair<double, size_t>> out;
+		for (size_t i = 0; i < pts.size(); ++i)
+		{
+			const S2LL::E3 u = unit(pts[i]);
+			const double dx = u.x - q.x, dy = u.y - q.y, dz = u.z - q.z;
+			out.emplace_back(dx * dx + dy * dy + dz * dz, i);
+		}
+		std::sort(out.begin(), out.end());
+		return out;
+	}
+}
+
+TEST_CASE("Point index queries agree with brute force", "[core][points]") {
+	using Catch::Matchers::WithinAbs;
+	const auto pts = cloud();
+	const S2LL::PointIndex index(pts, 2);
+	REQUIRE(index.size() == pts.size());
+	REQUIRE(index.node_count() < pts.size());
+	REQUIRE(index.memory_usage() >= pts.size() * sizeof(S2LL::E3));
+
+	// Queries on lattice points and duplicates meet exact ties
+	std::vector<S2LL::E3> queries;
+	for (int i = 0; i < 200; ++i)
+	{
+		queries.push_back({ std::sin(0.9 * i - 0.4), std::cos(1.7 * i + 0.2), std::sin(2.9 * i) });
+	}
+	for (int lat = -80; lat <= 80; lat += 40)
+	{
+		queries.push_back(dir(lat, 30));
+	}
+	queries.push_back(dir(90, 0));
+	queries.push_back(pts[14]);
+
+	SECTION("k nearest") {
+		for (const S2LL::E3& q : queries)
+		{
+			const auto expected = ranked(pts, q);
+			const std::vector<S2LL::Neighbor> near = index.nearest(q, 12);
+			REQUIRE(near.size() == 12);
+			for (size_t j = 0; j < near.size(); ++j)
+			{
+				REQUIRE(near[j].index == expected[j].second);
+				REQUIRE_THAT(near[j].angle, WithinAbs(2.0 * std::asin(0.5 * std::sqrt(expected[j].first)), 1e-15));
+			}
+		}
+		REQUIRE(index.nearest(queries[0], 0).empty());
+		REQUIRE(index.nearest(queries[0], pts.size() + 5).size() == pts.size());
+	}
+
+	SECTION("Radius") {
+		for (const double radius : { 0.0, 0.01, 0.1745329251994330, 0.5 })
+		{
+			for (const S2LL::E3& q : queries)
+			{
+				const double c = 2.0 * std::sin(0.5 * radius);
+				std::vector<size_t> expected;
+				for (const auto& [d2, i] : ranked(pts, q))
+				{
+					if (d2 <= c * c)
+					{
+						expected.push_back(i);
+					}
+				}
+				const std::vector<S2LL::Neighbor> found = index.within(q, radius);
+				REQUIRE(found.size() == expected.size());
+				for (size_t j = 0; j < found.size(); ++j)
+				{
+					REQUIRE(found[j].index == expected[j]);
+				}
+			}
+		}
+		REQUIRE(index.within(queries[0], 4.0).size() == pts.size());
+	}
+
+	SECTION("Batch and multi-threaded queries match single queries") {
+		const size_t k = 5;
+		std::vector<S2LL::Neighbor> one(queries.size() * k), four(queries.size() * k);
+		index.nearest(queries, k, one, 1);
+		index.nearest(queries, k, four, 4);
+		const S2LL::NeighborLists lists = index.within(queries, 0.05, 4);
+		REQUIRE(lists.offsets.size() == queries.size() + 1);
+		REQUIRE(lists.neighbors.size() == lists.offsets.back());
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			const auto near = index.nearest(queries[i], k);
+			for (size_t j = 0; j < k; ++j)
+			{
+				REQUIRE(one[i * k + j].index == near[j].index);
+				REQUIRE(four[i * k + j].index == near[j].index);
+				REQUIRE(four[i * k + j].angle == near[j].angle);
+			}
+			const auto found = index.within(queries[i], 0.05);
+			REQUIRE(lists.offsets[i + 1] - lists.offsets[i] == found.size());
+			for (size_t j = 0; j < found.size(); ++j)
+			{
+				REQUIRE(lists.neighbors[lists.offsets[i] + j].index == found[j].index);
+			}
+		}
+
+		// The tree does not depend on the thread count
+		const S2LL::PointIndex serial(pts, 1);
+		REQUIRE(serial.node_count() == index.node_count());
+	}
+}
+
+TEST_CASE("Point index on small inputs", "[core][points]") {
+	const S2LL::PointIndex empty(std::span<const S2LL::E3>{});
+	REQUIRE(empty.size() == 0);
+	REQUIRE(empty.nearest({ 1, 0, 0 }, 3).empty());
+	REQUIRE(empty.within({ 1, 0, 0 }, 1.0).empty());
+
+	const std::vector<S2LL::E3> two{ { 0, 0, 2 }, { 1, 0, 0 } };
+	const S2LL::PointIndex index(two);
+	std::vector<S2LL::Neighbor> out(3);
+	index.nearest(std::vector<S2LL::E3>{ { 1, 0, 1 } }, 3, out);
+	// Equidistant: the lower index first
+	REQUIRE(out[0].index == 0);
+	REQUIRE(out[1].index == 1);
+	REQUIRE(out[0].angle == out[1].angle);
+	REQUIRE(out[2].index == S2LL::Neighbor::npos);
+	REQUIRE(std::isinf(out[2].angle));
+}
@@ -1,7 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <S2LL/Core/Regions.hpp>
 
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <numbers>
 #include <type_traits>
+#include <vector>
 
 TEST_CASE("Compound Polygon container", "[core][polygon]") {
 	S2LL::Compound<S2LL::PlanePolygon<>> cPoly;
@@ -88,6 +94,151 @@ TEST_CASE("E3 polygon flavors realize their own edge types", "[core][polygon]")
 	static_assert(std::is_same_v<S2LL::GP<>::edge_type, S2LL::GeodesicArc>);
 }
 
+TEST_CASE("EllipticArc length, azimuths and interpolation", "[core][polygon]") {
+	using Catch::Matchers::WithinAbs;
+	constexpr double pi = std::numbers::pi;
+
+	SECTION("Quarter of the unit equator") {
+		const S2LL::EllipticArc arc{ { 1, 0, 0 }, { 0, 1, 0 }, 1.0, S2LL::LinearTransformation{} };
+		const auto r = arc.inverse();
+		REQUIRE_THAT(r.s12, WithinAbs(pi / 2, 1e-15));
+		REQUIRE_THAT(r.azi1, WithinAbs(pi / 2, 1e-15));
+		REQUIRE_THAT(r.azi2, WithinAbs(pi / 2, 1e-15));
+
+		const S2LL::E3 mid = arc.interpolate(0.5);
+		REQUIRE_THAT(mid.x, WithinAbs(std::sqrt(0.5), 1e-15));
+		REQUIRE_THAT(mid.y, WithinAbs(std::sqrt(0.5), 1e-15));
+		REQUIRE_THAT(mid.z, WithinAbs(0.0, 1e-15));
+	}
+
+	SECTION("Meridian arc heads due north") {
+		const S2LL::EllipticArc arc{ { 1, 0, 0 }, { 0, 0, 1 }, 1.0, S2LL::LinearTransformation{} };
+		REQUIRE_THAT(arc.inverse().azi1, WithinAbs(0.0, 1e-15));
+	}
+
+	SECTION("Sheared arc agrees with a dense polyline") {
+		const S2LL::EllipticArc arc{ { 1, 0.2, -0.3 }, { -0.4, 1, 0.7 }, 2.0, S2LL::LinearTransformation(0.6, 1.0, -0.9) };
+		const auto frame = arc.frame();
+
+		const auto points = arc.sample(1 << 14);
+		double polyline = 0.0;
+		for (size_t i = 1; i < points.size(); ++i)
+		{
+			polyline += (points[i] - points[i - 1]).mag();
+		}
+		REQUIRE_THAT(frame.length(), WithinAbs(polyline, 1e-7));
+
+		for (double f : { 0.0, 0.1, 0.37, 0.5, 0.92, 1.0 })
+		{
+			const double t = frame.angle_at(f * frame.length());
+			REQUIRE_THAT(frame.length_to(t), WithinAbs(f * frame.length(), 1e-13));
+		}
+		const S2LL::E3 end = frame.interpolate(1.0);
+		const S2LL::E3 b = arc.transform(arc.b.normalized() * arc.radius);
+		REQUIRE_THAT((end - b).mag(), WithinAbs(0.0, 1e-13));
+	}
+
+	SECTION("Octant triangle perimeter") {
+		const S2LL::GEP<3> tri{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		REQUIRE_THAT(S2LL::perimeter(tri), WithinAbs(1.5 * pi, 1e-14));
+		REQUIRE_THAT(S2LL::perimeter(tri, S2LL::Ellipsoid(3.0)), WithinAbs(4.5 * pi, 1e-13));
+	}
+}
+
+TEST_CASE("EllipticArc samples into caller storage", "[core][polygon]") {
+	using Catch::Matchers::WithinAbs;
+	const S2LL::EllipticArc arc{ { 1, 0.2, -0.3 }, { -0.4, 1, 0.7 }, 2.0, S2LL::LinearTransformation(0.6, 1.0, -0.9) };
+	const auto frame = arc.frame();
+
+	SECTION("Rotation recurrence matches direct evaluation") {
+		std::array<S2LL::E3, 65> points;
+		arc.sample(points);
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			const S2LL::E3 p = frame.point(frame.angle() * static_cast<double>(i) / 64);
+			REQUIRE_THAT((points[i] - p).mag(), WithinAbs(0.0, 1e-14));
+		}
+		const auto owned = arc.sample(64);
+		REQUIRE(owned.size() == points.size());
+		REQUIRE((owned.back() - points.back()).mag() == 0.0);
+	}
+
+	SECTION("Tolerance mode bounds the chord error") {
+		for (double tol : { 1e-1, 1e-3, 1e-6 })
+		{
+			std::vector<S2LL::E3> points;
+			arc.sample_within(tol, std::back_inserter(points));
+			REQUIRE(points.size() == static_cast<size_t>(arc.segments(tol)) + 1);
+			const double h = frame.angle() / static_cast<double>(points.size() - 1);
+			for (size_t i = 1; i < points.size(); ++i)
+			{
+				const S2LL::E3 mid = frame.point(h * (static_cast<double>(i) - 0.5));
+				REQUIRE(((points[i - 1] + points[i]) * 0.5 - mid).mag() <= tol);
+			}
+		}
+		REQUIRE(arc.segments(1e-3) < arc.segments(1e-6));
+	}
+}
+
 TEST_CASE("Polygon aliases match the tagged types", "[core][polygon]") {
 	static_assert(std::is_same_v<S2LL::PlanePolygon<>, S2LL::PolygonBase<S2LL::E2>>);
 }
+
+TEST_CASE("FlatCompoundSet stores Compound polygons in CSR form", "[core][polygon]") {
+	std::vector<S2LL::Compound<S2LL::PlanePolygon<>>> nested(2);
+	nested[0].polygons.resize(2);
+	nested[0].polygons[0].boundary = S2LL::Loop<S2LL::E2>{ {0, 0}, {4, 0}, {4, 4}, {0, 4} };
+	nested[0].polygons[1].boundary = S2LL::Loop<S2LL::E2>{ {1, 1}, {1, 2}, {2, 2} };
+	nested[1].polygons.resize(1);
+	nested[1].polygons[0].boundary = S2LL::Loop<S2LL::E2>{ {5, 5}, {6, 5}, {6, 6} };
+
+	const auto flat = S2LL::FlatCompoundSet<S2LL::E2>::from(nested);
+
+	REQUIRE(flat.size() == 2);
+	REQUIRE(flat.ring_count() == 3);
+	REQUIRE(flat.vertices.size() == 10);
+	REQUIRE(flat.ring_offsets == std::vector<size_t>{ 0, 4, 7, 10 });
+	REQUIRE(flat.part_offsets == std::vector<size_t>{ 0, 2, 3 });
+
+	SECTION("Rings are views into the shared vertex buffer") {
+		const S2LL::E2View hole = flat[0][1];
+		REQUIRE(hole.size() == 3);
+		REQUIRE(hole[1].y == 2.0);
+		REQUIRE(hole.data() == flat.vertices.data() + 4);
+		REQUIRE(flat[1].vertices().size() == 3);
+		REQUIRE(flat[1].first_ring() == 2);
+	}
+
+	SECTION("Round trip to the nested form") {
+		const auto back = flat.to<S2LL::PlanePolygon<>>();
+		REQUIRE(back.size() == nested.size());
+		for (size_t c = 0; c < back.size(); ++c)
+		{
+			REQUIRE(back[c].polygons.size() == nested[c].polygons.size());
+			for (size_t r = 0; r < back[c].polygons.size(); ++r)
+			{
+				const auto& a = back[c].polygons[r].boundary.vertices;
+				const auto& b = nested[c].polygons[r].boundary.vertices;
+				REQUIRE(a.size() == b.size());
+				for (size_t i = 0; i < a.size(); ++i)
+				{
+					REQUIRE(a[i].x == b[i].x);
+					REQUIRE(a[i].y == b[i].y);
+				}
+			}
+		}
+	}
+
+	SECTION("Empty parts and clearing") {
+		S2LL::FlatCompoundSet<S2LL::E2> set;
+		REQUIRE(set.empty());
+		set.begin_part();
+		REQUIRE(set.size() == 1);
+		REQUIRE(set[0].size() == 0);
+		set.push_back(nested[1]);
+		REQUIRE(set[1].size() == 1);
+		set.clear();
+		REQUIRE(set.empty());
+		REQUIRE(set.ring_count() == 0);
+	}
+}
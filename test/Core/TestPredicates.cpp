@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <S2LL/Core/Predicates.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("Orientation predicate", "[core][predicates]") {
+	const S2LL::E3 x{ 1, 0, 0 }, y{ 0, 1, 0 }, z{ 0, 0, 1 };
+
+	SECTION("Counterclockwise triples are positive") {
+		REQUIRE(S2LL::orient(x, y, z) == 1);
+		REQUIRE(S2LL::orient(y, x, z) == -1);
+		REQUIRE(S2LL::orient(x, y, x) == 0);
+	}
+
+	SECTION("Nearly coplanar triples are resolved exactly") {
+		// b and below lie 2^-80 off the plane of a and c, on either side; the
+		// naive determinant rounds that away
+		const S2LL::E3 a{ 1.0, 0.0, 0.0 };
+		const S2LL::E3 c{ 0.0, 1.0, 1.0 };
+		const S2LL::E3 b{ 0x1p40, 3.0, 3.0 + 0x1p-50 };
+		const S2LL::E3 below{ 0x1p40, 3.0, 3.0 - 0x1p-50 };
+		REQUIRE(S2LL::orient(a, b, c) == -1);
+		REQUIRE(S2LL::orient(a, below, c) == 1);
+		REQUIRE(S2LL::orient(b, c, a) == -1);
+	}
+
+	SECTION("Coplanar triples get consistent perturbed signs") {
+		const std::vector<S2LL::E3> pts{
+			{ 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { -1, 2, 0 }, { 2, 0, 0 }, { 0, 0, 1 }, { 0, 0, 3 }
+		};
+		for (const auto& a : pts)
+		{
+			for (const auto& b : pts)
+			{
+				for (const auto& c : pts)
+				{
+					const int s = S2LL::orient(a, b, c);
+					REQUIRE(s == S2LL::orient(b, c, a));
+					REQUIRE(s == -S2LL::orient(b, a, c));
+					REQUIRE(s == -S2LL::orient(a, c, b));
+					const bool distinct = !(a.x == b.x && a.y == b.y && a.z == b.z)
+						&& !(b.x == c.x && b.y == c.y && b.z == c.z)
+						&& !(a.x == c.x && a.y == c.y && a.z == c.z);
+					REQUIRE((s != 0) == distinct);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Orientation of four points", "[core][predicates]") {
+	const S2LL::E3 a{ 1, 0, 0 }, b{ 0, 1, 0 }, c{ 0, 0, 1 }, o{ 0, 0, 0 };
+
+	SECTION("Sides of a plane") {
+		// a, b, c turn counterclockwise seen from outside the sphere
+		REQUIRE(S2LL::orient3d(a, b, c, { 1, 1, 1 }) == 1);
+		REQUIRE(S2LL::orient3d(a, b, c, o) == -1);
+		REQUIRE(S2LL::orient3d(b, a, c, o) == 1);
+		REQUIRE(S2LL::orient3d(a, b, c, { 1, 1, -1 }) == 0);
+		REQUIRE(S2LL::orient3d(a, b, c, a) == 0);
+	}
+
+	SECTION("Nearly coplanar points are resolved exactly") {
+		// d and e lie 2^-52 off the plane x + y + z = 1, on either side, far
+		// below the rounding of products of their 2^20 coordinates
+		const S2LL::E3 d{ 0x1p20, -0x1p20, 1.0 + 0x1p-52 };
+		const S2LL::E3 e{ 0x1p20, -0x1p20, 1.0 - 0x1p-52 };
+		REQUIRE(S2LL::orient3d(a, b, c, d) == 1);
+		REQUIRE(S2LL::orient3d(a, b, c, e) == -1);
+		REQUIRE(S2LL::orient3d(a, b, c, { 0x1p20, -0x1p20, 1.0 }) == 0);
+		REQUIRE(S2LL::orient3d(d, a, b, c) == -1);
+	}
+
+	SECTION("Nearby points are resolved from their differences") {
+		// A small triangle on the plane z = 1, counterclockwise seen from
+		// above, and the same directions on the sphere
+		const S2LL::E3 p{ 1e-3, 0, 1 }, q{ 0, 1e-3, 1 }, r{ -1e-3, -1e-3, 1 };
+		REQUIRE(S2LL::orient3d(p, q, r, { 0, 0, 1 + 0x1p-40 }) == 1);
+		REQUIRE(S2LL::orient3d(p, q, r, { 0, 0, 1 - 0x1p-40 }) == -1);
+		REQUIRE(S2LL::orient3d(p, q, r, { 2e-4, -3e-4, 1 }) == 0);
+		const S2LL::E3 pu = p.normalized(), qu = q.normalized(), ru = r.normalized();
+		REQUIRE(S2LL::orient3d(pu, qu, ru, { 0, 0, 1 }) == 1);
+		REQUIRE(S2LL::orient3d(pu, qu, ru, { 0, 0, 1 - 1e-6 }) == -1);
+	}
+}
+
+TEST_CASE("Edge crossing predicates", "[core][predicates]") {
+	const S2LL::E3 a{ 1, 0, -1 }, b{ 1, 0, 1 }, c{ 1, -1, 0 }, d{ 1, 1, 0 };
+
+	SECTION("Proper crossings") {
+		REQUIRE(S2LL::crossing_sign(a, b, c, d) == 1);
+		REQUIRE(S2LL::crossing_sign(b, a, c, d) == 1);
+		REQUIRE(S2LL::crossing_sign(c, d, a, b) == 1);
+	}
+
+	SECTION("Great circles meeting on the far side do not cross") {
+		const S2LL::E3 e{ -1, 0, -1 }, f{ -1, 0, 1 };
+		REQUIRE(S2LL::crossing_sign(e, f, c, d) == -1);
+	}
+
+	SECTION("Shared vertices defer to the vertex rule") {
+		REQUIRE(S2LL::crossing_sign(a, b, b, d) == 0);
+		REQUIRE(S2LL::crossing_sign(a, b, c, a) == 0);
+		REQUIRE(S2LL::vertex_crossing(a, b, a, b));
+		REQUIRE(S2LL::vertex_crossing(a, b, b, a));
+		REQUIRE_FALSE(S2LL::vertex_crossing(a, a, a, d));
+	}
+}
+
+TEST_CASE("Batch edge crossings", "[core][predicates]") {
+	using Catch::Matchers::WithinAbs;
+
+	// A fan of edges through the query arc and its endpoints, with shared
+	// vertices, repeated points, degenerate edges and nearly coplanar pairs
+	const S2LL::E3 a{ 1, -0.3, 0.2 }, b{ 0.4, 0.9, -0.1 };
+	std::vector<S2LL::E3> c, d;
+	for (int i = 0; i < 997; ++i)
+	{
+		const double t = 0.37 * i;
+		c.push_back({ std::sin(t) + 0.5, std::cos(1.3 * t), std::sin(2.1 * t + 0.4) });
+		d.push_back({ std::cos(0.7 * t), std::sin(1.9 * t) + 0.3, std::cos(t - 1.0) });
+	}
+	for (int i = 0; i < 997; i += 17)
+	{
+		c[i] = a;
+		d[i + 1] = b;
+		d[i + 2] = c[i + 2];
+		// On the great circle of ab, up to rounding
+		c[i + 3] = a * std::cos(0.01 * i) + b * std::sin(0.01 * i);
+		d[i + 4] = a + b * 1e-17;
+	}
+
+	std::vector<signed char> signs(c.size());
+	const size_t count = S2LL::crossing_signs(a, b, c, d, signs);
+	size_t expected = 0;
+	for (size_t i = 0; i < c.size(); ++i)
+	{
+		REQUIRE(signs[i] == S2LL::crossing_sign(a, b, c[i], d[i]));
+		expected += signs[i] > 0;
+	}
+	REQUIRE(count == expected);
+	REQUIRE(count > 50);
+
+	SECTION("Loop edges wrap around") {
+		std::vector<signed char> loop(c.size());
+		S2LL::crossing_signs(a, b, S2LL::LoopView<S2LL::E3>(c), loop);
+		for (size_t i = 0; i < c.size(); ++i)
+		{
+			REQUIRE(loop[i] == S2LL::crossing_sign(a, b, c[i], c[(i + 1) % c.size()]));
+		}
+	}
+
+	SECTION("Crossing points lie on both arcs") {
+		std::vector<S2LL::EdgeCrossing> fast, accurate;
+		REQUIRE(S2LL::crossings<S2LL::Precision::Fast>(a, b, c, d, fast) == count);
+		REQUIRE(S2LL::crossings(a, b, c, d, accurate) == count);
+		for (size_t k = 0; k < count; ++k)
+		{
+			const S2LL::EdgeCrossing& x = accurate[k];
+			REQUIRE(x.edge == fast[k].edge);
+			REQUIRE(signs[x.edge] > 0);
+			const S2LL::E3& p = x.point;
+			REQUIRE_THAT(p.mag(), WithinAbs(1.0, 1e-15));
+			REQUIRE_THAT(p.dot(a.cross(b).normalized()), WithinAbs(0.0, 1e-15));
+			REQUIRE_THAT(p.dot(c[x.edge].cross(d[x.edge]).normalized()), WithinAbs(0.0, 1e-15));
+			REQUIRE(p.dot(a.normalized() + b.normalized()) > 0.0);
+			REQUIRE_THAT((p - fast[k].point).mag(), WithinAbs(0.0, 1e-12));
+		}
+	}
+
+	SECTION("Accurate points survive nearly parallel arcs") {
+		// Arcs meeting at an angle of 1e-9 rad: the plain double point drifts
+		// by some 1e-8, the Double one stays within a few ulps
+		const S2LL::E3 p{ 0.6, 0.0, 0.8 };
+		const S2LL::E3 u{ 0.0, 1.0, 0.0 }, w = p.cross(u);
+		const double eps = 1e-9;
+		const S2LL::E3 a2 = p - u * 0.1, b2 = p + u * 0.1;
+		const S2LL::E3 c2 = p - (u + w * eps) * 0.1, d2 = p + (u + w * eps) * 0.1;
+		REQUIRE(S2LL::crossing_sign(a2, b2, c2, d2) == 1);
+		const S2LL::E3 x = S2LL::crossing_point(a2, b2, c2, d2);
+		REQUIRE_THAT((x - p).mag(), WithinAbs(0.0, 1e-14));
+	}
+}
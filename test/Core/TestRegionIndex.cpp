@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/RegionIndex.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Quadrilateral with great-circle edges through the corners of a
+	/// latitude/longitude box, counterclockwise
+	S2LL::GP<> box(double lat0, double lat1, double lon0, double lon1)
+	{
+		return { dir(lat0, lon0), dir(lat0, lon1), dir(lat1, lon1), dir(lat1, lon0) };
+	}
+
+	std::vector<S2LL::E3> probe_points()
+	{
+		std::vector<S2LL::E3> pts;
+		for (int i = 0; i < 5000; ++i)
+		{
+			pts.push_back({ std::sin(1.1 * i + 0.3), std::cos(2.3 * i), std::sin(0.7 * i - 1.9) });
+		}
+		// Shared corners of the tiling below
+		for (int lat = -80; lat <= 80; lat += 10)
+		{
+			for (int lon = -180; lon < 180; lon += 10)
+			{
+				pts.push_back(dir(lat, lon));
+			}
+		}
+		return pts;
+	}
+}
+
+TEST_CASE("Region index locates points", "[core][index]") {
+	// 10 x 10 degree boxes tiling the band between the polar circles
+	std::vector<S2LL::Compound<S2LL::GP<>>> tiles;
+	for (int lat = -80; lat < 80; lat += 10)
+	{
+		for (int lon = -180; lon < 180; lon += 10)
+		{
+			tiles.push_back({ { box(lat, lat + 10, lon, lon + 10) } });
+		}
+	}
+	const S2LL::RegionIndex index(tiles);
+	REQUIRE(index.size() == tiles.size());
+	const auto pts = probe_points();
+
+	SECTION("Matches a linear scan") {
+		size_t found = 0;
+		for (const auto& p : pts)
+		{
+			size_t expected = S2LL::RegionIndex::npos;
+			int count = 0;
+			for (size_t r = 0; r < tiles.size(); ++r)
+			{
+				if (S2LL::contains(tiles[r].polygons[0], p))
+				{
+					expected = expected == S2LL::RegionIndex::npos ? r : expected;
+					++count;
+				}
+			}
+			// The tiles share their edges: every point is in at most one
+			REQUIRE(count <= 1);
+			REQUIRE(index.locate(p) == expected);
+			found += expected != S2LL::RegionIndex::npos;
+		}
+		REQUIRE(found > pts.size() / 2);
+	}
+
+	SECTION("Batch and multi-threaded lookups match single lookups") {
+		std::vector<size_t> serial(pts.size()), threaded(pts.size());
+		index.locate(pts, serial);
+		index.locate(pts, threaded, 4);
+		for (size_t i = 0; i < pts.size(); ++i)
+		{
+			REQUIRE(serial[i] == index.locate(pts[i]));
+			REQUIRE(threaded[i] == serial[i]);
+		}
+	}
+
+	SECTION("Grid resolution does not change the answers") {
+		const S2LL::RegionIndex coarse(tiles, 1);
+		for (const auto& p : pts)
+		{
+			REQUIRE(coarse.locate(p) == index.locate(p));
+		}
+	}
+
+	SECTION("Memory use accounts for the prepared rings") {
+		REQUIRE(index.memory_usage() > tiles.size() * 4 * sizeof(S2LL::E3));
+	}
+}
+
+TEST_CASE("Region index handles holes, orientation and large rings", "[core][index]") {
+	std::vector<S2LL::Compound<S2LL::GP<>>> regions(5);
+	// 0: a box with a hole
+	regions[0].polygons = { box(0, 30, 0, 30), box(10, 20, 10, 20) };
+	// 1: an island in the hole, given clockwise
+	const S2LL::GP<> island = box(12, 18, 12, 18);
+	regions[1].polygons = { { island[3], island[2], island[1], island[0] } };
+	// 2: the northern hemisphere, which fits in no cap either way round
+	regions[2].polygons = { { dir(0, 0), dir(0, 120), dir(0, 240) } };
+	// 3: a ring that fits in a hemisphere bounds its smaller side, here the
+	// south polar cap, although it runs clockwise around it
+	regions[3].polygons = { { dir(-5, 0), dir(-5, 90), dir(-5, 180), dir(-5, 270) } };
+	// 4: empty
+	const S2LL::RegionIndex index(regions);
+
+	REQUIRE(index.locate(dir(5, 5)) == 0);
+	REQUIRE(index.contains(2, dir(5, 5)));
+	REQUIRE_FALSE(index.contains(0, dir(11, 11)));
+	REQUIRE(index.locate(dir(11, 11)) == 2);
+	REQUIRE(index.locate(dir(15, 15)) == 1);
+	REQUIRE(index.locate(dir(60, -100)) == 2);
+	REQUIRE(index.locate(dir(-60, -100)) == 3);
+	REQUIRE(index.locate(dir(-2, -100)) == S2LL::RegionIndex::npos);
+	REQUIRE_FALSE(index.contains(4, dir(5, 5)));
+}
+
+TEST_CASE("Region index bounds rings next to the poles", "[core][index]") {
+	// Thin rings a few centimetres and some 200 m from a pole, across most
+	// of a quarter turn of longitude, whose caps come close to the pole
+	std::vector<S2LL::Compound<S2LL::GP<>>> rings;
+	for (int lon = -180; lon < 180; lon += 90)
+	{
+		rings.push_back({ { box(90 - 4e-7, 90 - 2e-7, lon + 1, lon + 89) } });
+		rings.push_back({ { box(-90 + 2e-7, -90 + 4e-7, lon + 1, lon + 89) } });
+		rings.push_back({ { box(90 - 2e-3, 90 - 1e-3, lon + 1, lon + 89) } });
+	}
+	const S2LL::RegionIndex index(rings, 1024);
+	size_t found = 0;
+	for (double lon = -179.5; lon < 180; lon += 0.5)
+	{
+		for (const double lat : { 90 - 3e-7, -90 + 3e-7, 90 - 1.5e-3 })
+		{
+			const S2LL::E3 p = dir(lat, lon);
+			size_t expected = S2LL::RegionIndex::npos;
+			for (size_t r = 0; r < rings.size(); ++r)
+			{
+				if (S2LL::contains(rings[r].polygons[0], p))
+				{
+					expected = r;
+				}
+			}
+			REQUIRE(index.locate(p) == expected);
+			found += expected != S2LL::RegionIndex::npos;
+		}
+	}
+	REQUIRE(found > 0);
+}
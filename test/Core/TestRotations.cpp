@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <S2LL/Core/Rotations.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace S2LL::Literals;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Rotation construction", "[core][rotation]") {
+	SECTION("Identity leaves points unchanged") {
+		const auto I = S2LL::Rotation::identity();
+		const S2LL::E3 p = I({ 0.25, -2.0, 7.5 });
+		REQUIRE(p.x == 0.25);
+		REQUIRE(p.y == -2.0);
+		REQUIRE(p.z == 7.5);
+	}
+
+	SECTION("Quarter turn about z maps x onto y") {
+		const auto R = S2LL::Rotation::axis_angle({ 0.0, 0.0, 2.0 }, 90_Deg);
+		const S2LL::E3 p = R({ 1.0, 0.0, 0.0 });
+		REQUIRE_THAT(p.x, WithinAbs(0.0, 1e-15));
+		REQUIRE(p.y == 1.0);
+		REQUIRE(p.z == 0.0);
+		REQUIRE(static_cast<double>(R.angle()) == 0.5_pi);
+	}
+
+	SECTION("Great-circle rotation carries one direction onto another") {
+		const S2LL::E3 from{ 1.0, 2.0, 2.0 };
+		const S2LL::E3 to{ 0.0, -3.0, 4.0 };
+		const S2LL::E3 p = S2LL::Rotation::between(from, to)(from);
+		REQUIRE_THAT(p.x, WithinAbs(0.0, 1e-15));
+		REQUIRE_THAT(p.y, WithinAbs(-1.8, 1e-15));
+		REQUIRE_THAT(p.z, WithinAbs(2.4, 1e-15));
+	}
+
+	SECTION("Antipodal directions rotate by a half turn") {
+		const S2LL::E3 p = S2LL::Rotation::between({ 0.0, 0.0, 1.0 }, { 0.0, 0.0, -1.0 })({ 0.0, 0.0, 1.0 });
+		REQUIRE_THAT(p.x, WithinAbs(0.0, 1e-15));
+		REQUIRE_THAT(p.y, WithinAbs(0.0, 1e-15));
+		REQUIRE(p.z == -1.0);
+	}
+
+	SECTION("Matrix form round-trips through the quaternion") {
+		const auto R = S2LL::Rotation::axis_angle({ 1.0, -1.0, 0.5 }, 1.1_Pi);
+		const auto Q = S2LL::Rotation::from_matrix(R.matrix());
+		const double sign = (R.w.hi < 0.0) == (Q.w.hi < 0.0) ? 1.0 : -1.0;
+		REQUIRE_THAT(sign * Q.w.hi, WithinAbs(R.w.hi, 1e-15));
+		REQUIRE_THAT(sign * Q.x.hi, WithinAbs(R.x.hi, 1e-15));
+		REQUIRE_THAT(sign * Q.y.hi, WithinAbs(R.y.hi, 1e-15));
+		REQUIRE_THAT(sign * Q.z.hi, WithinAbs(R.z.hi, 1e-15));
+	}
+}
+
+TEST_CASE("Rotation composition and inverse", "[core][rotation]") {
+	const auto A = S2LL::Rotation::axis_angle({ 0.0, 0.0, 1.0 }, 90_Deg);
+	const auto B = S2LL::Rotation::axis_angle({ 1.0, 0.0, 0.0 }, 90_Deg);
+	const S2LL::E3 p{ 0.0, 1.0, 0.0 };
+
+	// B sends y to z; A leaves z fixed
+	const S2LL::E3 ab = (A * B)(p);
+	REQUIRE_THAT(ab.x, WithinAbs(0.0, 1e-15));
+	REQUIRE_THAT(ab.y, WithinAbs(0.0, 1e-15));
+	REQUIRE(ab.z == 1.0);
+
+	const S2LL::E3 back = (A * B).inverse()(ab);
+	REQUIRE_THAT(back.x, WithinAbs(p.x, 1e-15));
+	REQUIRE(back.y == 1.0);
+	REQUIRE_THAT(back.z, WithinAbs(p.z, 1e-15));
+}
+
+TEST_CASE("Batched rotation of E3 spans", "[core][rotation]") {
+	std::vector<S2LL::E3> points;
+	for (int i = 0; i < 100; ++i)
+	{
+		const double t = 0.1 * i;
+		points.push_back(S2LL::E3{ std::cos(t), std::sin(t), 0.01 * i });
+	}
+	const auto R = S2LL::Rotation::axis_angle({ 0.3, 0.4, 1.2 }, 0.7);
+
+	std::vector<S2LL::E3> fast(points.size());
+	std::vector<S2LL::E3> accurate(points.size());
+	R.apply<S2LL::Precision::Fast>(points, fast);
+	R.apply<S2LL::Precision::Accurate>(points, accurate);
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		const S2LL::E3 single = R(points[i]);
+		REQUIRE(accurate[i].x == single.x);
+		REQUIRE(accurate[i].y == single.y);
+		REQUIRE(accurate[i].z == single.z);
+		REQUIRE_THAT(fast[i].x, WithinAbs(single.x, 1e-14));
+		REQUIRE_THAT(fast[i].y, WithinAbs(single.y, 1e-14));
+		REQUIRE_THAT(fast[i].z, WithinAbs(single.z, 1e-14));
+	}
+
+	SECTION("In-place rotation matches the out-of-place result") {
+		R.apply(std::span<S2LL::E3>(points));
+		REQUIRE(points[42].x == accurate[42].x);
+		REQUIRE(points[42].z == accurate[42].z);
+	}
+}
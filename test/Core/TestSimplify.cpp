@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/EdgeBVH.hpp>
+#include <S2LL/Core/Simplify.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Coastline-like ring of n vertices around (1, 1, 1)
+	std::vector<S2LL::E3> wiggly_ring(int n)
+	{
+		const S2LL::E3 c = S2LL::E3{ 1, 1, 1 }.normalized();
+		const S2LL::E3 u = S2LL::E3{ 1, -1, 0 }.normalized();
+		const S2LL::E3 w = c.cross(u);
+		std::vector<S2LL::E3> ring;
+		for (int i = 0; i < n; ++i)
+		{
+			const double t = 2.0 * std::numbers::pi * i / n;
+			const double r = 0.5 + 0.1 * std::sin(7.0 * t) + 0.01 * std::sin(131.0 * t) + 0.002 * std::sin(977.0 * t);
+			ring.push_back(c * std::cos(r) + (u * std::cos(t) + w * std::sin(t)) * std::sin(r));
+		}
+		return ring;
+	}
+
+	/// Angular distance from the unit q to the minor arc ab of unit vectors
+	double arc_distance(const S2LL::E3& q, const S2LL::E3& a, const S2LL::E3& b)
+	{
+		const S2LL::E3 n = a.cross(b).normalized();
+		const S2LL::E3 foot = (q - n * q.dot(n)).normalized();
+		if (a.cross(foot).dot(n) >= 0.0 && foot.cross(b).dot(n) >= 0.0)
+		{
+			return std::asin(std::min(1.0, std::abs(q.dot(n))));
+		}
+		return std::min(std::acos(std::min(1.0, q.dot(a))), std::acos(std::min(1.0, q.dot(b))));
+	}
+
+	bool self_crossing(const std::vector<S2LL::E3>& ring)
+	{
+		const S2LL::EdgeBVH bvh(ring);
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			if (bvh.crosses(ring[i], ring[(i + 1) % ring.size()]))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+TEST_CASE("Douglas-Peucker simplification", "[core][simplify]") {
+	const auto ring = wiggly_ring(20000);
+	const double tolerance = 1e-3;
+	const auto kept = S2LL::simplify_indices(ring, { S2LL::SimplifyMethod::DouglasPeucker, tolerance });
+	REQUIRE(std::is_sorted(kept.begin(), kept.end()));
+	REQUIRE(kept.size() * 10 < ring.size());
+
+	// Every dropped vertex stays within the tolerance of the edge replacing it
+	for (size_t j = 0; j < kept.size(); ++j)
+	{
+		const size_t first = kept[j], last = j + 1 < kept.size() ? kept[j + 1] : kept[0] + ring.size();
+		const S2LL::E3 a = ring[first].normalized(), b = ring[last % ring.size()].normalized();
+		for (size_t i = first + 1; i < last; ++i)
+		{
+			REQUIRE(arc_distance(ring[i % ring.size()].normalized(), a, b) <= tolerance);
+		}
+	}
+
+	SECTION("Vertices on the great circles of the edges go away") {
+		std::vector<S2LL::E3> square;
+		const S2LL::E3 corners[] = { dir(0, 0), dir(0, 10), dir(10, 10), dir(10, 0) };
+		for (int k = 0; k < 4; ++k)
+		{
+			for (int i = 0; i < 25; ++i)
+			{
+				square.push_back(corners[k] * (25.0 - i) + corners[(k + 1) % 4] * double(i));
+			}
+		}
+		for (const auto method : { S2LL::SimplifyMethod::DouglasPeucker, S2LL::SimplifyMethod::Visvalingam })
+		{
+			REQUIRE(S2LL::simplify_indices(square, { method, 1e-6 }) == std::vector<size_t>{ 0, 25, 50, 75 });
+		}
+	}
+
+	SECTION("Rings never drop below three vertices") {
+		REQUIRE(S2LL::simplify(ring, { S2LL::SimplifyMethod::DouglasPeucker, 10.0 }).size() == 3);
+		REQUIRE(S2LL::simplify(ring, { S2LL::SimplifyMethod::Visvalingam, 10.0 }).size() == 3);
+		const S2LL::GP<3> octant{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+		REQUIRE(S2LL::simplify(octant, { S2LL::SimplifyMethod::DouglasPeucker, 10.0 }).size() == 3);
+	}
+}
+
+TEST_CASE("Visvalingam simplification", "[core][simplify]") {
+	const auto ring = wiggly_ring(20000);
+	size_t previous = ring.size();
+	for (const double tolerance : { 1e-4, 1e-3, 1e-2 })
+	{
+		const auto kept = S2LL::simplify_indices(ring, { S2LL::SimplifyMethod::Visvalingam, tolerance });
+		REQUIRE(std::is_sorted(kept.begin(), kept.end()));
+		REQUIRE(kept.size() < previous);
+		previous = kept.size();
+	}
+	REQUIRE(previous * 50 < ring.size());
+}
+
+TEST_CASE("Simplification without self-intersections", "[core][simplify]") {
+	// A box whose bottom edge bulges 0.5 degrees south under a notch coming
+	// down from the top edge to 0.2 degrees south of the corners: dropping
+	// the bulge makes the bottom edge cut through the notch
+	const std::vector<S2LL::E3> ring{
+		dir(0, 0), dir(-0.5, 5), dir(0, 10), dir(5, 10), dir(5, 6),
+		dir(-0.2, 6), dir(-0.2, 4), dir(5, 4), dir(5, 0),
+	};
+	REQUIRE_FALSE(self_crossing(ring));
+
+	for (const auto method : { S2LL::SimplifyMethod::DouglasPeucker, S2LL::SimplifyMethod::Visvalingam })
+	{
+		const double tolerance = method == S2LL::SimplifyMethod::Visvalingam ? 1.7 * deg : 0.6 * deg;
+		const auto loose = S2LL::simplify_indices(ring, { method, tolerance });
+		REQUIRE(std::find(loose.begin(), loose.end(), 1) == loose.end());
+		REQUIRE(self_crossing(S2LL::simplify(ring, { method, tolerance })));
+
+		const auto kept = S2LL::simplify_indices(ring, { method, tolerance, true });
+		REQUIRE(std::find(kept.begin(), kept.end(), 1) != kept.end());
+		REQUIRE_FALSE(self_crossing(S2LL::simplify(ring, { method, tolerance, true })));
+	}
+}
+
+TEST_CASE("Compound simplification in parallel", "[core][simplify]") {
+	S2LL::Compound<S2LL::GP<>> region;
+	for (int k = 1; k <= 6; ++k)
+	{
+		S2LL::GP<> poly;
+		poly.boundary.vertices = wiggly_ring(1000 * k);
+		region.polygons.push_back(poly);
+	}
+	const S2LL::SimplifyOptions options{ S2LL::SimplifyMethod::Visvalingam, 1e-3 };
+	const auto threaded = S2LL::simplify(region, options, 3);
+	REQUIRE(threaded.polygons.size() == region.polygons.size());
+	for (size_t k = 0; k < region.polygons.size(); ++k)
+	{
+		const auto& got = threaded.polygons[k].boundary.vertices;
+		const auto kept = S2LL::simplify_indices(region.polygons[k].boundary, options);
+		REQUIRE(got.size() == kept.size());
+		for (size_t i = 0; i < kept.size(); ++i)
+		{
+			const S2LL::E3& v = region.polygons[k].boundary.vertices[kept[i]];
+			REQUIRE((got[i].x == v.x && got[i].y == v.y && got[i].z == v.z));
+		}
+	}
+}
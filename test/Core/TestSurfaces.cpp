@@ -1,7 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_tostring.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <S2LL/Core/Surfaces.hpp>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 using namespace S2LL::Literals;
 
@@ -144,3 +147,90 @@ TEST_CASE("Ellipsoids", "[core][surface]") {
 		REQUIRE_FALSE(miss.has_value());
 	}
 }
+
+TEST_CASE("Geodetic conversions", "[core][surface]") {
+	using Catch::Matchers::WithinAbs;
+	using S2LL::Precision::Fast;
+
+	SECTION("Cached eccentricities") {
+		const double f = 1.0 / 298.257223563;
+		REQUIRE_THAT(static_cast<double>(S2LL::wgs84.e2()), WithinAbs(f * (2.0 - f), 1e-18));
+		REQUIRE_THAT(static_cast<double>(S2LL::wgs84.ep2()), WithinAbs(f * (2.0 - f) / ((1.0 - f) * (1.0 - f)), 1e-18));
+		REQUIRE_THAT(static_cast<double>(S2LL::wgs84.axis_ratio()), WithinAbs(1.0 - f, 1e-16));
+		REQUIRE(S2LL::UnitSphere.e2().iszero());
+	}
+
+	SECTION("Authalic latitude and radius") {
+		// Authalic radius of WGS 84 (Snyder 1987, p. 16)
+		REQUIRE_THAT(S2LL::wgs84.authalic_radius(), WithinAbs(6371007.1809, 1e-4));
+		REQUIRE(S2LL::UnitSphere.authalic_radius() == 1.0);
+		REQUIRE(S2LL::wgs84.authalic_latitude(0.0) == 0.0);
+		REQUIRE_THAT(S2LL::wgs84.authalic_latitude(90_deg), WithinAbs(90_deg, 1e-15));
+		REQUIRE_THAT(S2LL::wgs84.authalic_latitude(-90_deg), WithinAbs(-90_deg, 1e-15));
+		REQUIRE_THAT(S2LL::UnitSphere.authalic_latitude(0.6), WithinAbs(0.6, 1e-15));
+
+		// Below the geodetic latitude by at most about 0.128 degrees, at 45
+		const double d45 = 45_deg - S2LL::wgs84.authalic_latitude(45_deg);
+		REQUIRE_THAT(d45, WithinAbs(0.1283_deg, 0.0005_deg));
+
+		// Equal area: the zone above latitude lat covers 2 pi R^2 (1 - sin beta)
+		// of the authalic sphere; near the pole both sides shrink to zero
+		const double lat = 89.9999_deg;
+		const double beta = S2LL::wgs84.authalic_latitude(lat);
+		REQUIRE(beta < 90_deg);
+		REQUIRE(beta > lat - 1e-6);
+	}
+
+	SECTION("Forward conversion at reference points") {
+		const S2LL::E3 origin = S2LL::wgs84.to_E3(S2LL::LLH{ 0.0, 0.0, 0.0 });
+		REQUIRE(origin.x == 6378137.0);
+		REQUIRE(origin.y == 0.0);
+		REQUIRE(origin.z == 0.0);
+
+		const S2LL::E3 pole = S2LL::wgs84.to_E3(S2LL::LLH{ 90_deg, 0.0, 100.0 });
+		REQUIRE_THAT(pole.x, WithinAbs(0.0, 1e-9));
+		REQUIRE_THAT(pole.z, WithinAbs(S2LL::wgs84.minor() + 100.0, 1e-9));
+
+		// Geodetic latitude differs from the parametric latitude of to_E3(LL)
+		const S2LL::E3 geodetic = S2LL::wgs84.to_E3(S2LL::LLH{ 45_deg, 0.0, 0.0 });
+		const S2LL::E3 parametric = S2LL::wgs84.to_E3(S2LL::LL{ 45_deg, 0.0 });
+		REQUIRE(std::abs(geodetic.z - parametric.z) > 1e3);
+	}
+
+	SECTION("Round trips under both precision policies") {
+		std::vector<S2LL::LLH> in;
+		for (int i = 0; i < 400; ++i)
+		{
+			const double lat = std::sin(0.77 * i) * 89.999_deg;
+			const double lon = std::cos(1.31 * i) * 180_deg;
+			const double h = (i % 4 == 0) ? -1e4 + 37.0 * i : 50.0 * i * i;
+			in.push_back(S2LL::LLH{ lat, lon, h });
+		}
+		std::vector<S2LL::E3> xyz(in.size());
+		std::vector<S2LL::E3> xyzFast(in.size());
+		std::vector<S2LL::LLH> back(in.size());
+		std::vector<S2LL::LLH> backFast(in.size());
+		S2LL::wgs84.to_E3(in, xyz);
+		S2LL::wgs84.to_E3<Fast>(in, xyzFast);
+		S2LL::wgs84.to_LLH(xyz, back);
+		S2LL::wgs84.to_LLH<Fast>(xyz, backFast);
+
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE_THAT(xyzFast[i].x, WithinAbs(xyz[i].x, 1e-8));
+			REQUIRE_THAT(xyzFast[i].z, WithinAbs(xyz[i].z, 1e-8));
+			REQUIRE_THAT(back[i].lat, WithinAbs(in[i].lat, 3e-16));
+			REQUIRE_THAT(back[i].lon, WithinAbs(in[i].lon, 5e-16));
+			REQUIRE_THAT(back[i].h, WithinAbs(in[i].h, 1e-8));
+			REQUIRE_THAT(backFast[i].lat, WithinAbs(in[i].lat, 1e-15));
+			REQUIRE_THAT(backFast[i].h, WithinAbs(in[i].h, 2e-8));
+		}
+	}
+
+	SECTION("Triaxial surfaces have no geodetic conversion") {
+		const S2LL::Ellipsoid e(3.0, 2.0, 1.0);
+		REQUIRE_FALSE(e.is_spheroid());
+		REQUIRE(e.to_E3(S2LL::LLH{ 0.0, 0.0, 0.0 }).isnan());
+		REQUIRE(std::isnan(e.to_LLH<Fast>(S2LL::E3{ 3.0, 0.0, 0.0 }).lat));
+	}
+}
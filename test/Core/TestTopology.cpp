@@ -0,0 +1,239 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Topology.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Grid point (row, col) of a lattice with `steps` vertices per square
+	/// side; neighbouring squares compute shared points identically
+	S2LL::E3 lattice(int row, int col, int steps)
+	{
+		return dir(10.0 + 2.0 * row / steps, 20.0 + 2.0 * col / steps);
+	}
+
+	/// k x k squares of 2 degrees, counterclockwise, each side split into
+	/// `steps` edges
+	std::vector<S2LL::Compound<S2LL::GP<>>> grid(int k, int steps)
+	{
+		std::vector<S2LL::Compound<S2LL::GP<>>> regions;
+		for (int r = 0; r < k; ++r)
+		{
+			for (int c = 0; c < k; ++c)
+			{
+				std::vector<S2LL::E3> ring;
+				const int r0 = r * steps, c0 = c * steps;
+				for (int s = 0; s < steps; ++s)
+				{
+					ring.push_back(lattice(r0, c0 + s, steps));
+				}
+				for (int s = 0; s < steps; ++s)
+				{
+					ring.push_back(lattice(r0 + s, c0 + steps, steps));
+				}
+				for (int s = 0; s < steps; ++s)
+				{
+					ring.push_back(lattice(r0 + steps, c0 + steps - s, steps));
+				}
+				for (int s = 0; s < steps; ++s)
+				{
+					ring.push_back(lattice(r0 + steps - s, c0, steps));
+				}
+				regions.emplace_back().polygons.emplace_back().boundary.vertices = ring;
+			}
+		}
+		return regions;
+	}
+
+	bool same(const S2LL::E3& a, const S2LL::E3& b)
+	{
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+
+	/// True if the rings hold the same cycle of vertices
+	bool same_cycle(const std::vector<S2LL::E3>& a, const std::vector<S2LL::E3>& b)
+	{
+		if (a.size() != b.size())
+		{
+			return false;
+		}
+		for (size_t shift = 0; shift < a.size(); ++shift)
+		{
+			bool all = true;
+			for (size_t i = 0; i < a.size() && all; ++i)
+			{
+				all = same(a[(i + shift) % a.size()], b[i]);
+			}
+			if (all)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t flat_bytes(const S2LL::FlatCompoundSet<S2LL::E3>& set)
+	{
+		return set.vertices.size() * sizeof(S2LL::E3) + (set.ring_offsets.size() + set.part_offsets.size()) * sizeof(size_t);
+	}
+
+	/// Bytes of vertex, arc and ring data in use, whatever the capacity
+	size_t used_bytes(const S2LL::Topology& t)
+	{
+		return t.vertices.size() * sizeof(S2LL::E3) + t.arc_vertices.size() * sizeof(uint32_t)
+			+ t.arc_uses.size() * sizeof(S2LL::ArcUse)
+			+ (t.arc_offsets.size() + t.ring_offsets.size() + t.part_offsets.size()) * sizeof(size_t);
+	}
+}
+
+TEST_CASE("Shared boundaries become arcs", "[core][topology]") {
+	const int k = 3, steps = 5;
+	const auto regions = grid(k, steps);
+	const S2LL::Topology t = S2LL::topology(regions);
+
+	SECTION("Counts") {
+		REQUIRE(t.size() == regions.size());
+		REQUIRE(t.ring_count() == regions.size());
+		// One arc per side of a square, but the two outer sides at each
+		// corner of the grid meet at no other ring and merge
+		REQUIRE(t.arc_count() == static_cast<size_t>(2 * k * (k + 1) - 4));
+		REQUIRE(t.arc_uses.size() == static_cast<size_t>(4 * k * k - 4));
+		for (size_t a = 0; a < t.arc_count(); ++a)
+		{
+			REQUIRE(t.arc(a).size() >= static_cast<size_t>(steps + 1));
+		}
+	}
+
+	SECTION("Inner sides are used twice, in opposite directions") {
+		std::vector<int> forward(t.arc_count()), backward(t.arc_count());
+		for (const S2LL::ArcUse& use : t.arc_uses)
+		{
+			++(use.reversed ? backward : forward)[use.arc];
+		}
+		size_t shared = 0;
+		for (size_t a = 0; a < t.arc_count(); ++a)
+		{
+			REQUIRE(forward[a] <= 1);
+			REQUIRE(backward[a] <= 1);
+			shared += forward[a] + backward[a] == 2;
+		}
+		REQUIRE(shared == static_cast<size_t>(2 * k * (k - 1)));
+	}
+
+	SECTION("Rings round trip") {
+		const auto rebuilt = t.to();
+		REQUIRE(rebuilt.size() == regions.size());
+		for (size_t c = 0; c < regions.size(); ++c)
+		{
+			REQUIRE(rebuilt[c].polygons.size() == 1);
+			REQUIRE(same_cycle(rebuilt[c].polygons[0].boundary.vertices, regions[c].polygons[0].boundary.vertices));
+		}
+	}
+
+	SECTION("Shared vertices and edges are stored once") {
+		const auto flat = S2LL::FlatCompoundSet<S2LL::E3>::from(regions);
+		REQUIRE(t.vertices.size() == static_cast<size_t>((k * steps + 1) * (k * steps + 1) - k * k * (steps - 1) * (steps - 1)));
+		REQUIRE(t.vertices.size() < flat.vertices.size());
+		// Every lattice edge lies on exactly one arc: k + 1 lines of
+		// k * steps edges in each direction
+		size_t edges = 0;
+		for (size_t a = 0; a < t.arc_count(); ++a)
+		{
+			edges += t.arc(a).size() - 1;
+		}
+		REQUIRE(edges == static_cast<size_t>(2 * (k + 1) * k * steps));
+		REQUIRE(edges < flat.vertices.size());
+		REQUIRE(used_bytes(t) < flat_bytes(flat));
+		REQUIRE(t.memory_usage() >= used_bytes(t));
+	}
+
+	SECTION("Threads do not change the result") {
+		const auto big = grid(12, 4);
+		const S2LL::Topology one = S2LL::topology(big, 0.0, 1);
+		const S2LL::Topology four = S2LL::topology(big, 0.0, 4);
+		REQUIRE(one.arc_vertices == four.arc_vertices);
+		REQUIRE(one.arc_offsets == four.arc_offsets);
+		REQUIRE(one.arc_uses == four.arc_uses);
+		REQUIRE(one.ring_offsets == four.ring_offsets);
+	}
+}
+
+TEST_CASE("Snapping, islands and degenerate rings", "[core][topology]") {
+	SECTION("Snapping merges near copies of a boundary") {
+		auto regions = grid(2, 4);
+		// Nudge the vertices of the last square off the shared lattice
+		for (S2LL::E3& v : regions.back().polygons[0].boundary.vertices)
+		{
+			v = S2LL::E3{ v.x + 1e-12, v.y - 1e-12, v.z }.normalized();
+		}
+		const S2LL::Topology exact = S2LL::topology(regions);
+		const S2LL::Topology snapped = S2LL::topology(regions, 1e-9, 2);
+		const S2LL::Topology clean = S2LL::topology(grid(2, 4));
+		// Unsnapped, the last square shares neither vertices nor arcs
+		REQUIRE(exact.vertices.size() > clean.vertices.size());
+		for (const S2LL::ArcUse& use : exact.ring(3))
+		{
+			for (size_t r = 0; r < 3; ++r)
+			{
+				REQUIRE(std::none_of(exact.ring(r).begin(), exact.ring(r).end(), [&](const S2LL::ArcUse& other) { return other.arc == use.arc; }));
+			}
+		}
+		REQUIRE(snapped.arc_count() == clean.arc_count());
+		REQUIRE(snapped.arc_uses == clean.arc_uses);
+		REQUIRE(snapped.vertices.size() == clean.vertices.size());
+		// Vertices on the two shared sides move to the ones met first; the
+		// outer sides meet no earlier vertex and keep their input
+		const auto part = snapped.compound(3);
+		const auto& input = regions.back().polygons[0].boundary.vertices;
+		size_t moved = 0;
+		for (const S2LL::E3& v : part.polygons[0].boundary.vertices)
+		{
+			if (std::any_of(clean.vertices.begin(), clean.vertices.end(), [&](const S2LL::E3& w) { return same(v, w); }))
+			{
+				++moved;
+			}
+			else
+			{
+				REQUIRE(std::any_of(input.begin(), input.end(), [&](const S2LL::E3& w) { return same(v, w); }));
+			}
+		}
+		REQUIRE(moved == 2 * 4 + 1);
+	}
+
+	SECTION("An island filling a hole shares one closed arc") {
+		const auto outer = grid(1, 12)[0].polygons[0];
+		std::vector<S2LL::E3> island{ dir(10.5, 20.5), dir(10.5, 21.5), dir(11.5, 21.5), dir(11.5, 20.5) };
+		std::vector<S2LL::Compound<S2LL::GP<>>> regions(2);
+		regions[0].polygons.push_back(outer);
+		regions[0].polygons.emplace_back().boundary.vertices.assign(island.rbegin(), island.rend());
+		// The island starts elsewhere along the cycle
+		std::rotate(island.begin(), island.begin() + 2, island.end());
+		regions[1].polygons.emplace_back().boundary.vertices = island;
+
+		const S2LL::Topology t = S2LL::topology(regions);
+		REQUIRE(t.arc_count() == 2);
+		REQUIRE(t.ring(1).size() == 1);
+		REQUIRE(t.ring(2).size() == 1);
+		REQUIRE(t.ring(1)[0].arc == t.ring(2)[0].arc);
+		REQUIRE(t.ring(1)[0].reversed != t.ring(2)[0].reversed);
+		REQUIRE(t.arc(t.ring(1)[0].arc).size() == 5);
+		REQUIRE(same_cycle(t.ring_vertices(2), island));
+	}
+
+	SECTION("Repeated vertices and collapsed rings are dropped") {
+		std::vector<S2LL::Compound<S2LL::GP<>>> regions(1);
+		const S2LL::E3 a = dir(0, 0), b = dir(0, 1), c = dir(1, 1);
+		regions[0].polygons.emplace_back().boundary.vertices = { a, a, b, c, c, a };
+		regions[0].polygons.emplace_back().boundary.vertices = { a, b, b, a };
+		const S2LL::Topology t = S2LL::topology(regions);
+		REQUIRE(t.size() == 1);
+		REQUIRE(t.ring_count() == 1);
+		REQUIRE(t.arc_count() == 1);
+		REQUIRE(same_cycle(t.ring_vertices(0), { a, b, c }));
+		REQUIRE(S2LL::topology(std::vector<S2LL::Compound<S2LL::GP<>>>{}).size() == 0);
+	}
+}
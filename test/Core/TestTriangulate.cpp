@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Area.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Triangulate.hpp>
+
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/// Star-shaped ring around (lat, lon) with radii alternating between r0
+	/// and r1 degrees, counterclockwise (clockwise when reversed)
+	std::vector<S2LL::E3> star(double lat, double lon, double r0, double r1, size_t n, bool reversed = false)
+	{
+		std::vector<S2LL::E3> ring;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const double t = 2.0 * std::numbers::pi * static_cast<double>(reversed ? n - i : i) / static_cast<double>(n);
+			const double r = i % 2 == 0 ? r0 : r1;
+			ring.push_back(dir(lat + r * std::sin(t), lon + r * std::cos(t) / std::cos(lat * std::numbers::pi / 180.0)));
+		}
+		return ring;
+	}
+
+	/// Sum of the spherical excesses of the triangles
+	double mesh_area(const S2LL::TriangleMesh& mesh)
+	{
+		double sum = 0.0;
+		for (size_t t = 0; t < mesh.size(); ++t)
+		{
+			const S2LL::E3 tri[3]{ mesh.vertices[mesh.indices[3 * t]], mesh.vertices[mesh.indices[3 * t + 1]], mesh.vertices[mesh.indices[3 * t + 2]] };
+			sum += S2LL::geodesic_area(S2LL::LoopView<S2LL::E3>(tri), S2LL::UnitSphere);
+		}
+		return sum;
+	}
+
+	/// Counterclockwise triangles whose edges are shared by two triangles
+	/// (once each way) or lie on the boundary
+	void check_mesh(const S2LL::TriangleMesh& mesh, size_t boundary_edges)
+	{
+		std::map<std::pair<uint32_t, uint32_t>, int> edges;
+		for (size_t t = 0; t < mesh.size(); ++t)
+		{
+			const uint32_t* v = &mesh.indices[3 * t];
+			REQUIRE(S2LL::orient(mesh.vertices[v[0]], mesh.vertices[v[1]], mesh.vertices[v[2]]) == 1);
+			for (int k = 0; k < 3; ++k)
+			{
+				REQUIRE(++edges[{ v[k], v[(k + 1) % 3] }] == 1);
+			}
+		}
+		size_t open = 0;
+		for (const auto& [e, count] : edges)
+		{
+			open += edges.count({ e.second, e.first }) == 0;
+		}
+		REQUIRE(open == boundary_edges);
+	}
+}
+
+TEST_CASE("Triangulation of spherical polygons", "[core][triangulate]") {
+	SECTION("Convex quadrilateral") {
+		const S2LL::GP<4> quad{ dir(0, 0), dir(0, 10), dir(10, 10), dir(10, 0) };
+		const S2LL::TriangleMesh mesh = S2LL::triangulate(quad);
+		REQUIRE(mesh.vertices.size() == 4);
+		REQUIRE(mesh.size() == 2);
+		check_mesh(mesh, 4);
+		REQUIRE_THAT(mesh_area(mesh), Catch::Matchers::WithinRel(S2LL::area(quad), 1e-12));
+	}
+
+	SECTION("Nonconvex star") {
+		S2LL::GP<> poly;
+		poly.boundary.vertices = star(30, 40, 20, 5, 40);
+		const S2LL::TriangleMesh mesh = S2LL::triangulate(poly);
+		REQUIRE(mesh.size() == 38);
+		check_mesh(mesh, 40);
+		REQUIRE_THAT(mesh_area(mesh), Catch::Matchers::WithinRel(S2LL::area(poly), 1e-10));
+	}
+
+	SECTION("Rings with holes") {
+		S2LL::Compound<S2LL::GP<>> region;
+		region.polygons.resize(3);
+		region.polygons[0].boundary.vertices = star(-20, 100, 30, 26, 200);
+		region.polygons[1].boundary.vertices = star(-20, 92, 4, 2, 30, true);
+		region.polygons[2].boundary.vertices = star(-15, 108, 5, 3, 16, true);
+		const S2LL::TriangleMesh mesh = S2LL::triangulate(region);
+		// n + 2h - 2 triangles for n vertices and h holes
+		REQUIRE(mesh.size() == 246 + 2 * 2 - 2);
+		check_mesh(mesh, 246);
+		REQUIRE_THAT(mesh_area(mesh), Catch::Matchers::WithinRel(S2LL::area(region), 1e-10));
+	}
+
+	SECTION("Large ring") {
+		S2LL::GP<> poly;
+		poly.boundary.vertices = star(60, -30, 25, 22, 100000);
+		const S2LL::TriangleMesh mesh = S2LL::triangulate(poly);
+		REQUIRE(mesh.size() == 100000 - 2);
+		REQUIRE_THAT(mesh_area(mesh), Catch::Matchers::WithinRel(S2LL::area(poly), 1e-9));
+	}
+
+	SECTION("Densified edges") {
+		const S2LL::GP<3> tri{ dir(0, 0), dir(0, 60), dir(50, 30) };
+		const double tolerance = 1e-3;
+		const S2LL::TriangleMesh mesh = S2LL::triangulate(tri, tolerance);
+		REQUIRE(mesh.vertices.size() > 3);
+		REQUIRE(mesh.size() == mesh.vertices.size() - 2);
+		check_mesh(mesh, mesh.vertices.size());
+		for (const S2LL::E3& v : mesh.vertices)
+		{
+			REQUIRE_THAT(v.x * v.x + v.y * v.y + v.z * v.z, Catch::Matchers::WithinAbs(1.0, 1e-15));
+		}
+		// Chord midpoints of the boundary stay within the tolerance
+		std::map<std::pair<uint32_t, uint32_t>, int> edges;
+		for (size_t t = 0; t < mesh.size(); ++t)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				++edges[{ mesh.indices[3 * t + k], mesh.indices[3 * t + (k + 1) % 3] }];
+			}
+		}
+		for (const auto& [e, count] : edges)
+		{
+			if (edges.count({ e.second, e.first }) == 0)
+			{
+				const S2LL::E3& a = mesh.vertices[e.first];
+				const S2LL::E3& b = mesh.vertices[e.second];
+				const double m = 0.5 * std::sqrt((a.x + b.x) * (a.x + b.x) + (a.y + b.y) * (a.y + b.y) + (a.z + b.z) * (a.z + b.z));
+				REQUIRE(1.0 - m <= tolerance);
+			}
+		}
+		REQUIRE_THAT(mesh_area(mesh), Catch::Matchers::WithinRel(S2LL::area(tri), 1e-10));
+	}
+
+	SECTION("Great elliptic polygon on a sheared sphere") {
+		const S2LL::GEP<4> poly{ { 0, 0, 3 }, { 3, 0, 0 }, { 2, 2, 1 }, { 0, 3, 0 } };
+		const S2LL::Ellipsoid sphere(3);
+		const S2LL::LinearTransformation T(-1.0, 2.0, 0.5);
+		const S2LL::TriangleMesh mesh = S2LL::triangulate(poly, 0.01, sphere, T);
+		REQUIRE(mesh.size() == mesh.vertices.size() - 2);
+		// Vertices lie on the sheared sphere: their pre-images have radius 3
+		for (const S2LL::E3& v : mesh.vertices)
+		{
+			const S2LL::E3 p{ v.x - 0.5 * v.y, v.y, v.z + 0.25 * v.y };
+			REQUIRE_THAT(std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z), Catch::Matchers::WithinAbs(3.0, 1e-12));
+		}
+	}
+
+	SECTION("Degenerate input") {
+		const S2LL::GP<3> flat{ dir(0, 0), dir(0, 10), dir(0, 0) };
+		REQUIRE(S2LL::triangulate(flat).size() == 0);
+		// Vertices around a great circle fit in no open hemisphere
+		S2LL::GP<> band;
+		for (int i = 0; i < 8; ++i)
+		{
+			band.boundary.vertices.push_back(dir(i % 2 == 0 ? 1 : -1, 45 * i));
+		}
+		REQUIRE(S2LL::triangulate(band).size() == 0);
+	}
+}
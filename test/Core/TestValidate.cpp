@@ -0,0 +1,188 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Directions.hpp>
+#include <S2LL/Core/Predicates.hpp>
+#include <S2LL/Core/Validate.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace
+{
+	/// Counterclockwise ring through the corners of a latitude/longitude box
+	S2LL::GP<> box(double lat0, double lon0, double lat1, double lon1)
+	{
+		return S2LL::GP<>{ dir(lat0, lon0), dir(lat0, lon1), dir(lat1, lon1), dir(lat1, lon0) };
+	}
+
+	S2LL::GP<> reversed(const S2LL::GP<>& poly)
+	{
+		S2LL::GP<> r;
+		r.boundary.vertices.assign(poly.boundary.vertices.rbegin(), poly.boundary.vertices.rend());
+		return r;
+	}
+
+	/// Ring through the given corners with every edge split into k pieces
+	/// along its great circle
+	std::vector<S2LL::E3> densified(const std::vector<S2LL::E3>& corners, int k)
+	{
+		std::vector<S2LL::E3> ring;
+		for (size_t i = 0; i < corners.size(); ++i)
+		{
+			const S2LL::E3& a = corners[i];
+			const S2LL::E3& b = corners[(i + 1) % corners.size()];
+			for (int j = 0; j < k; ++j)
+			{
+				const double t = static_cast<double>(j) / k;
+				ring.push_back(S2LL::E3{ a.x + t * (b.x - a.x), a.y + t * (b.y - a.y), a.z + t * (b.z - a.z) });
+			}
+		}
+		return ring;
+	}
+}
+
+TEST_CASE("Validation of single rings", "[core][validate]") {
+	using S2LL::Defect;
+
+	SECTION("A valid ring") {
+		REQUIRE(S2LL::validate(box(0, 0, 10, 10)).empty());
+		REQUIRE(S2LL::validate(reversed(box(0, 0, 10, 10)), { .winding = S2LL::Winding::Clockwise }).empty());
+	}
+
+	SECTION("Closed rings repeat their first vertex") {
+		const S2LL::GP<> closed{ dir(0, 0), dir(0, 10), dir(10, 10), dir(10, 0), dir(0, 0) };
+		const auto found = S2LL::validate(closed);
+		REQUIRE(found.size() == 1);
+		REQUIRE(found[0].defect == Defect::DuplicateVertex);
+		REQUIRE(found[0].index == 4);
+		REQUIRE(S2LL::validate(closed, { .closed = true }).empty());
+	}
+
+	SECTION("Duplicate and antipodal consecutive vertices") {
+		const S2LL::E3 north{ 0.0, 0.0, 1.0 }, south{ 0.0, 0.0, -1.0 };
+		const auto found = S2LL::validate(S2LL::GP<>{ dir(0, 0), dir(0, 10), dir(0, 10), north, south, dir(-10, 5) },
+			{ .winding = S2LL::Winding::Either, .crossings = false });
+		REQUIRE(found.size() == 2);
+		REQUIRE(found[0].defect == Defect::DuplicateVertex);
+		REQUIRE(found[0].index == 1);
+		REQUIRE(found[0].ring == 0);
+		REQUIRE(found[0].region == S2LL::Diagnostic::npos);
+		REQUIRE(found[1].defect == Defect::AntipodalEdge);
+		REQUIRE(found[1].index == 3);
+	}
+
+	SECTION("Degenerate rings") {
+		const auto two = S2LL::validate(S2LL::GP<>{ dir(0, 0), dir(0, 10), dir(0, 0) });
+		REQUIRE(two.back().defect == Defect::DegenerateRing);
+		const auto flat = S2LL::validate(S2LL::GP<>{ dir(0, 0), dir(0, 10), dir(0, 20), dir(0, 5) });
+		REQUIRE(flat.size() == 1);
+		REQUIRE(flat[0].defect == Defect::DegenerateRing);
+		REQUIRE(S2LL::validate(S2LL::GP<>{}).size() == 1);
+	}
+
+	SECTION("Self-intersections and self-touching") {
+		// Bowtie: the diagonals cross
+		const auto bowtie = S2LL::validate(S2LL::GP<>{ dir(0, 0), dir(10, 10), dir(0, 10), dir(10, 0) }, { .winding = S2LL::Winding::Either });
+		REQUIRE(bowtie.size() == 1);
+		REQUIRE(bowtie[0].defect == Defect::SelfIntersection);
+		REQUIRE(bowtie[0].index == 0);
+		REQUIRE(bowtie[0].other_index == 2);
+		REQUIRE(S2LL::validate(S2LL::GP<>{ dir(0, 0), dir(10, 10), dir(0, 10), dir(10, 0) },
+			{ .winding = S2LL::Winding::Either, .crossings = false }).empty());
+
+		// Two triangles sharing a vertex
+		const auto eight = S2LL::validate(S2LL::GP<>{ dir(0, 0), dir(5, 5), dir(5, -5), dir(0, 0), dir(-5, -5), dir(-5, 5) },
+			{ .winding = S2LL::Winding::Either });
+		REQUIRE(eight.size() == 1);
+		REQUIRE(eight[0].defect == Defect::RepeatedVertex);
+		REQUIRE(eight[0].index == 0);
+		REQUIRE(eight[0].other_index == 3);
+	}
+
+	SECTION("Long rings agree with the pairwise count") {
+		const std::vector<S2LL::E3> ring = densified({ dir(0, 0), dir(10, 10), dir(0, 10), dir(10, 0) }, 37);
+		REQUIRE(ring.size() > 64);
+		size_t expected = 0;
+		for (size_t i = 0; i < ring.size(); ++i)
+		{
+			for (size_t j = i + 1; j < ring.size(); ++j)
+			{
+				expected += S2LL::crossing_sign(ring[i], ring[(i + 1) % ring.size()], ring[j], ring[(j + 1) % ring.size()]) > 0;
+			}
+		}
+		REQUIRE(expected == 1);
+		const auto found = S2LL::validate(S2LL::LoopView<S2LL::E3>(ring), { .winding = S2LL::Winding::Either });
+		REQUIRE(found.size() == expected);
+		REQUIRE(found[0].defect == Defect::SelfIntersection);
+		REQUIRE(found[0].index < found[0].other_index);
+	}
+}
+
+TEST_CASE("Validation of Compound regions", "[core][validate]") {
+	using S2LL::Defect;
+	const S2LL::Compound<S2LL::GP<>> frame{ { box(-20, -20, 20, 20), reversed(box(-10, -10, 10, 10)) } };
+	REQUIRE(S2LL::validate(frame).empty());
+
+	SECTION("Hole orientation") {
+		const S2LL::Compound<S2LL::GP<>> bad{ { box(-20, -20, 20, 20), box(-10, -10, 10, 10) } };
+		const auto found = S2LL::validate(bad);
+		REQUIRE(found.size() == 1);
+		REQUIRE(found[0].defect == Defect::Orientation);
+		REQUIRE(found[0].ring == 1);
+		REQUIRE(S2LL::validate(bad, { .winding = S2LL::Winding::Either }).empty());
+
+		// Shapefile winding: clockwise outer rings, counterclockwise holes
+		const S2LL::Compound<S2LL::GP<>> shp{ { reversed(box(-20, -20, 20, 20)), box(-10, -10, 10, 10), reversed(box(30, 30, 40, 40)) } };
+		REQUIRE(S2LL::validate(shp, { .winding = S2LL::Winding::Clockwise }).empty());
+		REQUIRE(S2LL::validate(shp).size() == 3);
+	}
+
+	SECTION("Crossing rings") {
+		const S2LL::Compound<S2LL::GP<>> crossing{ { box(-20, -20, 20, 20), reversed(box(-10, 10, 10, 30)) } };
+		const auto found = S2LL::validate(crossing, { .winding = S2LL::Winding::Either });
+		REQUIRE(found.size() == 2);
+		for (const auto& d : found)
+		{
+			REQUIRE(d.defect == Defect::RingCrossing);
+			REQUIRE(d.ring == 0);
+			REQUIRE(d.other_ring == 1);
+		}
+		REQUIRE(found[0].index == 1);
+		REQUIRE(found[1].index == 1);
+	}
+
+	SECTION("Sub-metre rings nest") {
+		// Some 70 cm across, with the hole corners 0.03 mm inside the outer
+		// corners: the bounding cap of the outer ring must hold them
+		const double h = 3e-6, d = 3e-10;
+		const S2LL::GP<> outer = box(45 - h, 10 - h, 45 + h, 10 + h);
+		const S2LL::GP<> inner = box(45 - h + d, 10 - h + d, 45 + h - d, 10 + h - d);
+		REQUIRE(S2LL::validate(S2LL::Compound<S2LL::GP<>>{ { outer, reversed(inner) } }).empty());
+		const auto found = S2LL::validate(S2LL::Compound<S2LL::GP<>>{ { outer, inner } });
+		REQUIRE(found.size() == 1);
+		REQUIRE(found[0].defect == Defect::Orientation);
+		REQUIRE(found[0].ring == 1);
+	}
+}
+
+TEST_CASE("Batch validation", "[core][validate]") {
+	std::vector<S2LL::Compound<S2LL::GP<>>> regions;
+	for (int i = 0; i < 50; ++i)
+	{
+		const double lon = -170.0 + 6.0 * i;
+		regions.push_back({ { box(0, lon, 5, lon + 5) } });
+	}
+	regions[7].polygons[0] = reversed(regions[7].polygons[0]);
+	regions[31].polygons.push_back(S2LL::GP<>{ dir(0, 0), dir(0, 1) });
+
+	for (const unsigned threads : { 1u, 4u })
+	{
+		const auto found = S2LL::validate(regions, {}, threads);
+		REQUIRE(found.size() == 2);
+		REQUIRE(found[0].region == 7);
+		REQUIRE(found[0].defect == S2LL::Defect::Orientation);
+		REQUIRE(found[1].region == 31);
+		REQUIRE(found[1].ring == 1);
+		REQUIRE(found[1].defect == S2LL::Defect::DegenerateRing);
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <S2LL/Core/Coordinates.hpp>
+#include <cmath>
+#include <numbers>
+
+/// Radians per degree
+inline constexpr double deg = std::numbers::pi / 180.0;
+
+/// Unit direction at the given latitude and longitude, in degrees
+inline S2LL::E3 dir(double lat_deg, double lon_deg)
+{
+	const double lat = lat_deg * deg, lon = lon_deg * deg;
+	return { std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat) };
+}